@@ -0,0 +1,52 @@
+#include <paddle/types/events.hpp>
+#include <paddle/types/raw_json.hpp>
+
+#include <userver/formats/json/serialize.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <string_view>
+
+namespace paddle {
+
+namespace {
+
+constexpr std::string_view kEvent = R"({"event_type": "subscription.past_due", "origin": "subscription_recurring"})";
+
+}  // namespace
+
+/// The enum parsing before the compile-time lookup
+void EnumerationMapDom(benchmark::State& state) {
+    using EnumMap = userver::storages::postgres::io::detail::EnumerationMap<events::EventTypeName>;
+    const auto json = userver::formats::json::FromString(kEvent);
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(EnumMap::GetEnumerator(json["event_type"].As<std::string>()));
+    }
+}
+BENCHMARK(EnumerationMapDom);
+
+void ParseEnumDom(benchmark::State& state) {
+    const auto json = userver::formats::json::FromString(kEvent);
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(json["event_type"].As<events::EventTypeName>());
+    }
+}
+BENCHMARK(ParseEnumDom);
+
+void ParseEnumOnDemand(benchmark::State& state) {
+    const raw_json::Value json{kEvent};
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(json["event_type"].As<events::EventTypeName>());
+    }
+}
+BENCHMARK(ParseEnumOnDemand);
+
+void EnumLiteralLookup(benchmark::State& state) {
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(impl::ParseEnumLiteral<TransactionOrigin>("subscription_recurring"));
+    }
+}
+BENCHMARK(EnumLiteralLookup);
+
+}  // namespace paddle
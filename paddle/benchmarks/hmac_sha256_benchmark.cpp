@@ -0,0 +1,71 @@
+#include <paddle/auth/hmac_sha256.hpp>
+
+#include <userver/crypto/hash.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <fmt/format.h>
+
+#include <string>
+#include <vector>
+
+namespace paddle::auth {
+
+namespace {
+
+// Paddle secrets are 70 characters long, longer than an HMAC block
+const std::string kSecret(70, 's');
+constexpr std::string_view kTimestamp = "1755117651";
+constexpr std::size_t kBatchSize = 64;
+
+auto MakePayload(const benchmark::State& state) -> std::string {
+    return std::string(static_cast<std::size_t>(state.range(0)), 'p');
+}
+
+}  // namespace
+
+/// The webhook signature check before the in-tree kernels
+void UserverHmacSha256(benchmark::State& state) {
+    const auto payload = MakePayload(state);
+    for ([[maybe_unused]] auto _ : state) {
+        auto signed_payload = fmt::format("{}:{}", kTimestamp, payload);
+        benchmark::DoNotOptimize(userver::crypto::hash::HmacSha256(kSecret, signed_payload));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * payload.size()));
+}
+BENCHMARK(UserverHmacSha256)->RangeMultiplier(4)->Range(256, 64 << 10);
+
+void PaddleHmacSha256(benchmark::State& state) {
+    const auto payload = MakePayload(state);
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(HmacSha256(HmacInput{kSecret, {kTimestamp, ":", payload}}));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * payload.size()));
+}
+BENCHMARK(PaddleHmacSha256)->RangeMultiplier(4)->Range(256, 64 << 10);
+
+/// Second argument is the Sha256Kernel
+void PaddleHmacSha256Batch(benchmark::State& state) {
+    const auto kernel = static_cast<Sha256Kernel>(state.range(1));
+    if (!IsSupported(kernel)) {
+        state.SkipWithError("Kernel is not supported by the CPU");
+        return;
+    }
+    const auto payload = MakePayload(state);
+    const std::vector<HmacInput> inputs(kBatchSize, HmacInput{kSecret, {kTimestamp, ":", payload}});
+    std::vector<Sha256Digest> digests(kBatchSize);
+    for ([[maybe_unused]] auto _ : state) {
+        HmacSha256Batch(inputs, digests, kernel);
+        benchmark::DoNotOptimize(digests.data());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize * payload.size()));
+}
+BENCHMARK(PaddleHmacSha256Batch)
+    ->ArgsProduct({
+        benchmark::CreateRange(256, 64 << 10, 4),
+        {static_cast<int>(Sha256Kernel::kScalar),
+         static_cast<int>(Sha256Kernel::kShaNi),
+         static_cast<int>(Sha256Kernel::kAvx2)},
+    });
+
+}  // namespace paddle::auth
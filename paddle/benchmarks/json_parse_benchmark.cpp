@@ -0,0 +1,279 @@
+#include <paddle/types/events.hpp>
+#include <paddle/types/raw_json.hpp>
+#include <paddle/types/subscription_view.hpp>
+#include <paddle/types/subscriptions.hpp>
+#include <paddle/types/transaction_view.hpp>
+#include <paddle/types/transactions.hpp>
+
+#include <userver/formats/json/serialize.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <fmt/format.h>
+
+#include <string>
+#include <string_view>
+
+namespace paddle {
+
+namespace {
+
+constexpr std::string_view kPrice = R"({
+    "id": "pri_01k2jg2k8f8dhy4yvvtq2j2nh1",
+    "product_id": "pro_01k2jfwwcvmscf97tnxxa0v81t",
+    "type": "standard",
+    "description": "saas-developer-monthly",
+    "name": "SlugKit SaaS Indy Monthly Subscription",
+    "tax_mode": "internal",
+    "billing_cycle": {"frequency": 1, "interval": "month"},
+    "trial_period": {"frequency": 7, "interval": "day"},
+    "unit_price": {"amount": "500", "currency_code": "USD"},
+    "unit_price_overrides": [],
+    "custom_data": {"slug": "saas-developer"},
+    "status": "active",
+    "quantity": {"minimum": 1, "maximum": 1},
+    "import_meta": null,
+    "created_at": "2025-08-13T19:56:22.671769Z",
+    "updated_at": "2025-08-13T19:57:57.766584Z"
+})";
+
+constexpr std::string_view kProduct = R"({
+    "id": "pro_01k2jfwwcvmscf97tnxxa0v81t",
+    "name": "SaaS Indy",
+    "type": "standard",
+    "tax_category": "saas",
+    "description": "SlugKit subscription plan for individual developers",
+    "image_url": "https://dev.slugkit.dev/favicon.png",
+    "custom_data": {"slug": "saas-developer"},
+    "status": "active",
+    "created_at": "2025-08-13T19:53:15.419Z",
+    "updated_at": "2025-08-13T20:15:09.484Z"
+})";
+
+const std::string kTransactionCompleted = fmt::format(
+    R"({{
+    "event_id": "evt_01k2jjm2z1c7d4a0p9q3e1v8r5",
+    "event_type": "transaction.completed",
+    "occurred_at": "2025-08-13T20:40:52.136Z",
+    "notification_id": "ntf_01k2jjm30q8dh0gmwy9b8c8c3d",
+    "data": {{
+        "id": "txn_01k2jjjx8b9e3zv0k2gk6a3f9y",
+        "status": "completed",
+        "customer_id": "ctm_01k2jj0xbzdpzbgz0vqv1e0x5e",
+        "address_id": "add_01k2jjgd1xzzwtarjsw7qw2by3",
+        "business_id": null,
+        "custom_data": {{"account": "acc_42"}},
+        "currency_code": "USD",
+        "origin": "subscription_recurring",
+        "subscription_id": "sub_01k2jjkzv4h5te6zw46gfnrxnw",
+        "invoice_id": "inv_01k2jjm1j0r8h6c9w2m4a7t1b5",
+        "invoice_number": "325-10566",
+        "collection_mode": "automatic",
+        "discount_id": null,
+        "billing_details": null,
+        "billing_period": {{
+            "starts_at": "2025-08-13T20:40:49.761Z",
+            "ends_at": "2025-09-13T20:40:49.761Z"
+        }},
+        "items": [{{"price": {price}, "quantity": 1, "proration": null}}],
+        "details": {{
+            "tax_rates_used": [{{
+                "tax_rate": "0.2",
+                "totals": {{"subtotal": "417", "discount": "0", "tax": "83", "total": "500"}}
+            }}],
+            "totals": {{
+                "subtotal": "417", "tax": "83", "discount": "0", "total": "500", "credit": "0",
+                "credit_to_balance": "0", "balance": "0", "grand_total": "500", "fee": "55",
+                "earnings": "362", "currency_code": "USD"
+            }},
+            "adjusted_totals": {{
+                "subtotal": "417", "tax": "83", "total": "500", "grand_total": "500", "fee": "55",
+                "earnings": "362", "currency_code": "USD"
+            }},
+            "payout_totals": {{
+                "subtotal": "417", "tax": "83", "discount": "0", "total": "500", "credit": "0",
+                "credit_to_balance": "0", "balance": "0", "grand_total": "500", "fee": "55",
+                "earnings": "362", "currency_code": "USD"
+            }},
+            "payout_totals_adjusted": null,
+            "line_items": [{{
+                "id": "txnitm_01k2jjjx9c1e4f5g6h7j8k9m0n",
+                "price_id": "pri_01k2jg2k8f8dhy4yvvtq2j2nh1",
+                "quantity": 1,
+                "proration": null,
+                "tax_rate": "0.2",
+                "unit_totals": {{"subtotal": "417", "discount": "0", "tax": "83", "total": "500"}},
+                "totals": {{"subtotal": "417", "discount": "0", "tax": "83", "total": "500"}},
+                "product": {product}
+            }}]
+        }},
+        "payments": [{{
+            "payment_attempt_id": "7a1b6c2d-3e4f-4a5b-9c6d-7e8f9a0b1c2d",
+            "stored_payment_method_id": "0e1f2a3b-4c5d-4e6f-8a7b-9c0d1e2f3a4b",
+            "payment_method_id": "paymtd_01k2jjm0p7q8r9s0t1v2w3x4y5",
+            "amount": "500",
+            "status": "captured",
+            "error_code": null,
+            "method_details": {{
+                "type": "card",
+                "underlying_details": null,
+                "card": {{
+                    "type": "visa", "last4": "4242", "expiry_month": 1, "expiry_year": 2028,
+                    "cardholder_name": "Jo Bloggs"
+                }}
+            }},
+            "created_at": "2025-08-13T20:40:50.112Z",
+            "captured_at": "2025-08-13T20:40:51.904Z"
+        }}],
+        "checkout": {{"url": "https://slugkit.dev/checkout?_ptxn=txn_01k2jjjx8b9e3zv0k2gk6a3f9y"}},
+        "created_at": "2025-08-13T20:40:48.901Z",
+        "updated_at": "2025-08-13T20:40:52.036Z",
+        "billed_at": "2025-08-13T20:40:49.761Z",
+        "revised_at": null
+    }}
+}})",
+    fmt::arg("price", kPrice),
+    fmt::arg("product", kProduct)
+);
+
+const std::string kSubscriptionCreated = fmt::format(
+    R"({{
+    "event_id": "evt_01k2jjm2z1c7d4a0p9q3e1v8r6",
+    "event_type": "subscription.created",
+    "occurred_at": "2025-08-13T20:40:50.136Z",
+    "notification_id": "ntf_01k2jjm30q8dh0gmwy9b8c8c3e",
+    "data": {{
+        "id": "sub_01k2jjkzv4h5te6zw46gfnrxnw",
+        "status": "trialing",
+        "customer_id": "ctm_01k2jj0xbzdpzbgz0vqv1e0x5e",
+        "address_id": "add_01k2jjgd1xzzwtarjsw7qw2by3",
+        "business_id": null,
+        "currency_code": "EUR",
+        "created_at": "2025-08-13T20:40:49.764Z",
+        "updated_at": "2025-08-13T20:40:49.764Z",
+        "started_at": "2025-08-13T20:40:49.761Z",
+        "first_billed_at": null,
+        "next_billed_at": "2025-08-20T20:40:49.761Z",
+        "paused_at": null,
+        "canceled_at": null,
+        "collection_mode": "automatic",
+        "billing_details": null,
+        "current_billing_period": {{
+            "starts_at": "2025-08-13T20:40:49.761Z",
+            "ends_at": "2025-08-20T20:40:49.761Z"
+        }},
+        "billing_cycle": {{"frequency": 1, "interval": "month"}},
+        "scheduled_change": null,
+        "items": [{{
+            "status": "trialing",
+            "quantity": 1,
+            "recurring": true,
+            "created_at": "2025-08-13T20:40:49.764Z",
+            "updated_at": "2025-08-13T20:40:49.764Z",
+            "previously_billed_at": null,
+            "next_billed_at": "2025-08-20T20:40:49.761Z",
+            "trial_dates": {{
+                "starts_at": "2025-08-13T20:40:49.761Z",
+                "ends_at": "2025-08-20T20:40:49.761Z"
+            }},
+            "price": {price},
+            "product": {product}
+        }}],
+        "custom_data": null,
+        "management_urls": {{
+            "update_payment_method": "https://sandbox-customer-portal.paddle.com/cpl_01k2jcck84zd4db044r7r8tvny",
+            "cancel": "https://sandbox-customer-portal.paddle.com/cpl_01k2jcck84zd4db044r7r8tvny"
+        }},
+        "discount": null,
+        "import_meta": null
+    }}
+}})",
+    fmt::arg("price", kPrice),
+    fmt::arg("product", kProduct)
+);
+
+template <typename T>
+void ParseDom(benchmark::State& state, const std::string& json) {
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(userver::formats::json::FromString(json).As<events::EventWithNotification<T>>());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * json.size()));
+}
+
+template <typename T>
+void ParseOnDemand(benchmark::State& state, const std::string& json) {
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(raw_json::ParseAs<events::EventWithNotification<T>>(json));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * json.size()));
+}
+
+}  // namespace
+
+void TransactionEventDom(benchmark::State& state) {
+    ParseDom<transactions::Transaction>(state, kTransactionCompleted);
+}
+BENCHMARK(TransactionEventDom);
+
+void TransactionEventOnDemand(benchmark::State& state) {
+    ParseOnDemand<transactions::Transaction>(state, kTransactionCompleted);
+}
+BENCHMARK(TransactionEventOnDemand);
+
+void SubscriptionEventDom(benchmark::State& state) {
+    ParseDom<subscriptions::Subscription>(state, kSubscriptionCreated);
+}
+BENCHMARK(SubscriptionEventDom);
+
+void SubscriptionEventOnDemand(benchmark::State& state) {
+    ParseOnDemand<subscriptions::Subscription>(state, kSubscriptionCreated);
+}
+BENCHMARK(SubscriptionEventOnDemand);
+
+/// Payload decoding in the dispatcher, the event JSON is already parsed by the webhook handler
+void TransactionPayloadStruct(benchmark::State& state) {
+    const auto data = userver::formats::json::FromString(kTransactionCompleted)["data"];
+    for ([[maybe_unused]] auto _ : state) {
+        auto transaction = data.As<transactions::Transaction>();
+        benchmark::DoNotOptimize(transaction.id);
+        benchmark::DoNotOptimize(transaction.details.totals.grand_total);
+    }
+}
+BENCHMARK(TransactionPayloadStruct);
+
+void TransactionPayloadView(benchmark::State& state) {
+    const auto data = userver::formats::json::FromString(kTransactionCompleted)["data"];
+    for ([[maybe_unused]] auto _ : state) {
+        auto transaction = data.As<transactions::TransactionView>();
+        benchmark::DoNotOptimize(transaction.GetId());
+        benchmark::DoNotOptimize(transaction.GetStatus());
+        benchmark::DoNotOptimize(transaction.GetCustomerId());
+        benchmark::DoNotOptimize(transaction.GetTotals().grand_total);
+        benchmark::DoNotOptimize(transaction.GetCustomData());
+    }
+}
+BENCHMARK(TransactionPayloadView);
+
+void SubscriptionPayloadStruct(benchmark::State& state) {
+    const auto data = userver::formats::json::FromString(kSubscriptionCreated)["data"];
+    for ([[maybe_unused]] auto _ : state) {
+        auto subscription = data.As<subscriptions::Subscription>();
+        benchmark::DoNotOptimize(subscription.id);
+        benchmark::DoNotOptimize(subscription.status);
+    }
+}
+BENCHMARK(SubscriptionPayloadStruct);
+
+void SubscriptionPayloadView(benchmark::State& state) {
+    const auto data = userver::formats::json::FromString(kSubscriptionCreated)["data"];
+    for ([[maybe_unused]] auto _ : state) {
+        auto subscription = data.As<subscriptions::SubscriptionView>();
+        benchmark::DoNotOptimize(subscription.GetId());
+        benchmark::DoNotOptimize(subscription.GetStatus());
+        benchmark::DoNotOptimize(subscription.GetCustomerId());
+        benchmark::DoNotOptimize(subscription.GetNextBilledAt());
+    }
+}
+BENCHMARK(SubscriptionPayloadView);
+
+}  // namespace paddle
@@ -0,0 +1,145 @@
+#include <paddle/types/money.hpp>
+#include <paddle/types/numeric.hpp>
+#include <paddle/types/raw_json.hpp>
+#include <paddle/types/transactions.hpp>
+
+#include <userver/formats/json/serialize.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <fmt/format.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Replaced for the whole benchmark binary, the other benchmarks only pay for
+// a relaxed increment per allocation
+std::atomic<std::int64_t> allocations{0};
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace paddle {
+
+namespace {
+
+// A usual amount and one longer than the small string buffer
+auto MakeTotals(const benchmark::State& state) -> std::string {
+    const auto* amount = state.range(0) == 0 ? "500" : "1234567890123456789";
+    return fmt::format(
+        R"({{"subtotal": "417", "tax": "83", "discount": "0", "total": "500", "credit": "0", )"
+        R"("credit_to_balance": "0", "balance": "0", "grand_total": "{}", "fee": "65", "earnings": "435", )"
+        R"("currency_code": "USD"}})",
+        amount
+    );
+}
+
+void ReportAllocations(benchmark::State& state, std::int64_t before) {
+    state.counters["allocs"] = benchmark::Counter(
+        static_cast<double>(allocations.load(std::memory_order_relaxed) - before),
+        benchmark::Counter::kAvgIterations
+    );
+}
+
+}  // namespace
+
+/// The amount parsing before ParseAmount
+void AmountStollDom(benchmark::State& state) {
+    const auto json = userver::formats::json::FromString(MakeTotals(state));
+    const auto before = allocations.load(std::memory_order_relaxed);
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(std::stoll(json["grand_total"].As<std::string>()));
+    }
+    ReportAllocations(state, before);
+}
+BENCHMARK(AmountStollDom)->Arg(0)->Arg(1);
+
+void AmountDom(benchmark::State& state) {
+    const auto json = userver::formats::json::FromString(MakeTotals(state));
+    const auto before = allocations.load(std::memory_order_relaxed);
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(ParseAmount(json["grand_total"]));
+    }
+    ReportAllocations(state, before);
+}
+BENCHMARK(AmountDom)->Arg(0)->Arg(1);
+
+void AmountOnDemand(benchmark::State& state) {
+    const auto text = MakeTotals(state);
+    const raw_json::Value json{text};
+    const auto before = allocations.load(std::memory_order_relaxed);
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(ParseAmount(json["grand_total"]));
+    }
+    ReportAllocations(state, before);
+}
+BENCHMARK(AmountOnDemand)->Arg(0)->Arg(1);
+
+void TransactionTotalsDom(benchmark::State& state) {
+    const auto json = userver::formats::json::FromString(MakeTotals(state));
+    const auto before = allocations.load(std::memory_order_relaxed);
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(json.As<transactions::TransactionTotals>());
+    }
+    ReportAllocations(state, before);
+}
+BENCHMARK(TransactionTotalsDom)->Arg(0)->Arg(1);
+
+void TransactionTotalsOnDemand(benchmark::State& state) {
+    const auto text = MakeTotals(state);
+    const auto before = allocations.load(std::memory_order_relaxed);
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(raw_json::ParseAs<transactions::TransactionTotals>(text));
+    }
+    ReportAllocations(state, before);
+}
+BENCHMARK(TransactionTotalsOnDemand)->Arg(0)->Arg(1);
+
+/// Copies the amounts in one currency out of a mixed list, as aggregating by currency does
+void MoneyFilterByCurrency(benchmark::State& state) {
+    const std::vector<money::CurrencyCode> currencies{
+        money::CurrencyCode{"USD"}, money::CurrencyCode{"EUR"}, money::CurrencyCode{"GBP"}, money::CurrencyCode{"JPY"}
+    };
+    std::vector<money::Money> amounts;
+    for (std::int64_t index = 0; index < 1024; ++index) {
+        amounts.push_back({index, currencies[static_cast<std::size_t>(index) % currencies.size()]});
+    }
+    const money::CurrencyCode eur{"EUR"};
+    std::vector<money::Money> filtered;
+    filtered.reserve(amounts.size());
+    const auto before = allocations.load(std::memory_order_relaxed);
+    for ([[maybe_unused]] auto _ : state) {
+        filtered.clear();
+        for (const auto& money : amounts) {
+            if (money.currency_code == eur) {
+                filtered.push_back(money);
+            }
+        }
+        benchmark::DoNotOptimize(filtered.data());
+    }
+    ReportAllocations(state, before);
+}
+BENCHMARK(MoneyFilterByCurrency);
+
+}  // namespace paddle
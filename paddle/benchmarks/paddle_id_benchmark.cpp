@@ -0,0 +1,73 @@
+#include <paddle/types/ids.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <fmt/format.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace paddle {
+
+namespace {
+
+constexpr std::size_t kCacheSize = 4096;
+
+auto MakeIds() -> std::vector<std::string> {
+    std::vector<std::string> ids;
+    ids.reserve(kCacheSize);
+    for (std::size_t index = 0; index < kCacheSize; ++index) {
+        ids.push_back(fmt::format("sub_01k2jjkzv4h5te6zw46g{:06}", index));
+    }
+    return ids;
+}
+
+}  // namespace
+
+/// Subscription cache keyed the way it was before PaddleId
+void IdLookupString(benchmark::State& state) {
+    const auto ids = MakeIds();
+    std::unordered_map<std::string, std::size_t> cache;
+    for (std::size_t index = 0; index < ids.size(); ++index) {
+        cache.emplace(ids[index], index);
+    }
+    std::size_t index = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(cache.find(ids[index++ % ids.size()]));
+    }
+}
+BENCHMARK(IdLookupString);
+
+void IdLookupPacked(benchmark::State& state) {
+    std::vector<SubscriptionId> ids;
+    for (const auto& id : MakeIds()) {
+        ids.emplace_back(id);
+    }
+    std::unordered_map<SubscriptionId, std::size_t> cache;
+    for (std::size_t index = 0; index < ids.size(); ++index) {
+        cache.emplace(ids[index], index);
+    }
+    std::size_t index = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(cache.find(ids[index++ % ids.size()]));
+    }
+}
+BENCHMARK(IdLookupPacked);
+
+void IdParse(benchmark::State& state) {
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(SubscriptionId{"sub_01k2jjkzv4h5te6zw46gfnrxnw"});
+    }
+}
+BENCHMARK(IdParse);
+
+void IdFormat(benchmark::State& state) {
+    const SubscriptionId id{"sub_01k2jjkzv4h5te6zw46gfnrxnw"};
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(id.ToString());
+    }
+}
+BENCHMARK(IdFormat);
+
+}  // namespace paddle
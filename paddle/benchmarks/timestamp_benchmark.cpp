@@ -0,0 +1,43 @@
+#include <paddle/types/timestamp.hpp>
+
+#include <userver/utils/datetime.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <string_view>
+
+namespace paddle {
+
+namespace {
+
+constexpr std::string_view kTimestamp = "2025-08-13T19:56:22.671769Z";
+
+}  // namespace
+
+/// The generic parsing every timestamp went through before ParseRfc3339
+void TimestampStringtime(benchmark::State& state) {
+    const std::string text{kTimestamp};
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(userver::utils::datetime::Stringtime(
+            text, userver::utils::datetime::kDefaultTimezone, userver::utils::datetime::kRfc3339Format
+        ));
+    }
+}
+BENCHMARK(TimestampStringtime);
+
+void TimestampParseRfc3339(benchmark::State& state) {
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(ParseRfc3339(kTimestamp));
+    }
+}
+BENCHMARK(TimestampParseRfc3339);
+
+void TimestampParseRfc3339Offset(benchmark::State& state) {
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(ParseRfc3339("2025-08-13T21:56:22.671769+02:00"));
+    }
+}
+BENCHMARK(TimestampParseRfc3339Offset);
+
+}  // namespace paddle
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <paddle/types/event_query.hpp>
+#include <paddle/types/response.hpp>
+
+#include <userver/engine/shared_mutex.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace paddle::archive {
+
+/// Paddle ids are 30 characters long, longer entity ids are not indexed
+inline constexpr std::size_t kIndexedIdSize = 32;
+
+/// @brief Index entry of an archived event, index files store these as is
+struct IndexRecord {
+    /// Zero padded
+    std::array<char, kIndexedIdSize> event_id{};
+    std::array<char, kIndexedIdSize> entity_id{};
+    std::array<char, kIndexedIdSize> event_type{};
+    /// Milliseconds since the epoch
+    std::int64_t occurred_at = 0;
+    /// Position of the event line in the segment file
+    std::uint64_t offset = 0;
+    std::uint64_t length = 0;
+
+    [[nodiscard]] auto GetEventId() const -> std::string_view;
+    [[nodiscard]] auto GetEntityId() const -> std::string_view;
+    [[nodiscard]] auto GetEventType() const -> std::string_view;
+};
+
+/// @brief Extract the indexed fields of a raw event JSON, offset and length are not set
+/// @return std::nullopt if the event has no event_id or the id is too long
+auto MakeIndexRecord(std::string_view raw_event) -> std::optional<IndexRecord>;
+
+/// @brief Index record conditions of the query
+auto Matches(const events::EventQuery& query, const IndexRecord& record) -> bool;
+
+struct EventLogSettings {
+    std::string directory;
+    /// A segment is sealed and a new one is started once this size is reached
+    std::uint64_t segment_max_size = 64UL << 20;
+};
+
+/// @brief Append-only local log of raw Paddle events
+///
+/// Events are stored one per line in NDJSON segment files. When a segment is
+/// full its index, sorted by event id and by entity id, is written next to it
+/// and memory-mapped, so lookups in sealed segments don't read the events.
+/// The index of the last (active) segment is kept in memory and rebuilt from
+/// the segment on startup, a partially written last line is discarded.
+///
+/// File IO is blocking, run the calls on a task processor meant for it.
+class EventLog final {
+public:
+    explicit EventLog(EventLogSettings settings);
+    ~EventLog();
+
+    EventLog(const EventLog&) = delete;
+    EventLog& operator=(const EventLog&) = delete;
+
+    /// @brief Archive the event unless it is already archived
+    /// @return false if the event is a duplicate or has no event_id
+    auto Append(std::string_view raw_event) -> bool;
+
+    [[nodiscard]] auto Contains(std::string_view event_id) const -> bool;
+    /// @brief Raw event JSON by id
+    [[nodiscard]] auto Find(std::string_view event_id) const -> std::optional<std::string>;
+    /// @brief Raw events after the cursor selected by the query, in event id order
+    /// @note Like the events API, a page may contain less than limit events while there are more of them
+    [[nodiscard]] auto Read(std::string_view cursor, const events::EventQuery& query, std::size_t limit) const
+        -> ResponseWithCursor<std::string>;
+    /// @brief Raw events of the entity (`data.id`) in event id order
+    [[nodiscard]] auto GetEntityHistory(std::string_view entity_id) const -> std::vector<std::string>;
+
+    /// @brief Flush the active segment to disk
+    auto Sync() const -> void;
+
+private:
+    class Segment;
+
+    auto OpenSegments() -> void;
+    auto StartSegment(std::uint32_t number) -> void;
+    auto ContainsLocked(std::string_view event_id) const -> bool;
+
+    const EventLogSettings settings_;
+    mutable userver::engine::SharedMutex mutex_;
+    /// Sealed segments followed by the active one
+    std::vector<std::unique_ptr<Segment>> segments_;
+};
+
+}  // namespace paddle::archive
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <paddle/auth/hmac_sha256.hpp>
+
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/mutex.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace paddle::auth {
+
+struct BatchVerifierSettings {
+    /// How long the first verification of a batch waits for the others to join
+    std::chrono::microseconds window{200};
+    /// The batch is hashed without waiting further once it has this many HMACs
+    std::size_t max_batch_size = 64;
+};
+
+/// @brief Verifies the webhook signatures of concurrent requests together
+///
+/// The first request of a batch waits up to the window for other requests
+/// and then computes the HMACs of all of them at once with the batch kernel
+/// (multi-buffer AVX2 on CPUs without the SHA extensions), the other requests
+/// wait for the result. The window adds to the latency of every request, so
+/// it pays off only under bursts of large payloads.
+class BatchVerifier final {
+public:
+    explicit BatchVerifier(BatchVerifierSettings settings);
+    ~BatchVerifier();
+
+    BatchVerifier(const BatchVerifier&) = delete;
+    BatchVerifier& operator=(const BatchVerifier&) = delete;
+
+    /// @param max_age_seconds maximum age of the signature, -1 means no limit
+    /// @return index of the secret the payload is signed with, std::nullopt if none
+    auto Verify(
+        std::span<const std::string> secrets,
+        std::string_view signature_header,
+        std::string_view payload,
+        std::int32_t max_age_seconds = -1
+    ) const -> std::optional<std::size_t>;
+
+private:
+    struct Batch;
+
+    const BatchVerifierSettings settings_;
+    mutable userver::engine::Mutex mutex_;
+    /// Wakes up the batch leader when the batch is full
+    mutable userver::engine::ConditionVariable batch_full_;
+    /// Batch being collected, null if none
+    mutable std::shared_ptr<Batch> pending_;
+};
+
+}  // namespace paddle::auth
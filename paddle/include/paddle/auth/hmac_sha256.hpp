@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace paddle::auth {
+
+using Sha256Digest = std::array<std::uint8_t, 32>;
+
+enum class Sha256Kernel {
+    kScalar,  ///< Portable implementation
+    kShaNi,   ///< x86 SHA extensions, one message at a time
+    kAvx2,    ///< AVX2 multi-buffer, eight messages at a time
+};
+
+/// @brief HMAC-SHA256 input, the message is the concatenation of the parts
+///
+/// Parts avoid copying a signed payload like `<timestamp>:<body>` into one buffer.
+struct HmacInput {
+    std::string_view key;
+    std::array<std::string_view, 3> message;
+};
+
+/// @brief The kernel is supported by the CPU
+auto IsSupported(Sha256Kernel kernel) -> bool;
+
+/// @brief Fastest supported kernel for a single message
+auto GetSha256Kernel() -> Sha256Kernel;
+
+/// @brief Fastest supported kernel for a batch of messages
+auto GetBatchSha256Kernel() -> Sha256Kernel;
+
+auto HmacSha256(std::string_view key, std::string_view message) -> Sha256Digest;
+
+auto HmacSha256(const HmacInput& input) -> Sha256Digest;
+
+/// @brief HMAC-SHA256 of every input, digests[i] is the digest of inputs[i]
+/// @pre digests.size() >= inputs.size()
+auto HmacSha256Batch(std::span<const HmacInput> inputs, std::span<Sha256Digest> digests) -> void;
+
+/// @brief Same as HmacSha256Batch with the given kernel, for tests and benchmarks
+/// @pre IsSupported(kernel)
+auto HmacSha256Batch(std::span<const HmacInput> inputs, std::span<Sha256Digest> digests, Sha256Kernel kernel)
+    -> void;
+
+}  // namespace paddle::auth
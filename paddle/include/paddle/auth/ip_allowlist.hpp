@@ -0,0 +1,69 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace paddle {
+
+/// @brief IPv4 and IPv6 CIDR ranges, e.g. the Paddle webhook source addresses
+///
+/// The ranges are kept as a sorted table of disjoint address intervals, a lookup
+/// is a binary search over a few dozen of 16-byte entries and doesn't allocate.
+/// IPv4 addresses are mapped to the IPv6 space (`::ffff:0:0/96`), so that an
+/// IPv4 client connected to a dual-stack socket matches the IPv4 ranges.
+class IpAllowlist final {
+public:
+    /// @brief IPv6 address as two host order halves
+    struct Address {
+        std::uint64_t high = 0;
+        std::uint64_t low = 0;
+
+        auto operator<=>(const Address&) const = default;
+    };
+
+    /// @param address IPv4 address in host byte order
+    static auto FromV4(std::uint32_t address) -> Address;
+    /// @param address IPv6 address in network byte order
+    static auto FromV6(std::span<const std::uint8_t, 16> address) -> Address;
+    /// @brief Parse a textual IPv4 or IPv6 address
+    static auto ParseAddress(std::string_view address) -> std::optional<Address>;
+
+    IpAllowlist() = default;
+    /// @param cidrs ranges like `34.194.127.46/32` or `2001:db8::/32`, a bare address is a single address range
+    /// @throws std::invalid_argument if a range is malformed
+    explicit IpAllowlist(const std::vector<std::string>& cidrs);
+
+    [[nodiscard]] auto Contains(Address address) const -> bool;
+    /// @return false for a malformed address
+    [[nodiscard]] auto Contains(std::string_view address) const -> bool;
+
+    [[nodiscard]] auto IsEmpty() const -> bool;
+    /// @brief Number of disjoint intervals, overlapping and adjacent ranges are merged
+    [[nodiscard]] auto GetSize() const -> std::size_t;
+
+private:
+    struct Interval {
+        Address first;
+        Address last;
+    };
+
+    /// Sorted by the first address, disjoint and not adjacent
+    std::vector<Interval> intervals_;
+};
+
+/// @brief Client address from an `X-Forwarded-For` header behind trusted proxies
+///
+/// Every proxy appends the address it received the request from, so the address
+/// appended by the outermost of `trusted_proxy_depth` proxies is the client one.
+/// Entries to the left of it are supplied by the client and can't be trusted.
+/// @return std::nullopt if the header has less than trusted_proxy_depth entries
+auto GetForwardedAddress(std::string_view forwarded_for, std::size_t trusted_proxy_depth)
+    -> std::optional<std::string_view>;
+
+}  // namespace paddle
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/engine/mutex.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+namespace paddle::auth {
+
+struct SecretRefresherSettings {
+    /// Minimum time between the on-demand refreshes, failed ones included
+    std::chrono::milliseconds min_refresh_interval{10000};
+    /// How long a path still unknown after a refresh doesn't trigger refreshes
+    std::chrono::milliseconds unknown_path_ttl{60000};
+    std::size_t max_unknown_paths = 1000;
+};
+
+/// @brief Single-flight, rate limited refresh of the webhook secrets
+///
+/// Requests that miss the cached secrets read GetGeneration() before the
+/// lookup and call Refresh() with it: concurrent misses wait for a single
+/// fetch, and a miss that raced with a completed refresh doesn't repeat it.
+class SecretRefresher final {
+public:
+    using Clock = std::chrono::steady_clock;
+    /// Fetches and publishes the secrets, throws on failure
+    using FetchFunction = std::function<void()>;
+
+    SecretRefresher(SecretRefresherSettings settings, FetchFunction fetch);
+
+    SecretRefresher(const SecretRefresher&) = delete;
+    SecretRefresher& operator=(const SecretRefresher&) = delete;
+
+    /// @brief Incremented after every successful fetch
+    [[nodiscard]] auto GetGeneration() const -> std::uint64_t;
+
+    /// @brief Periodic update, not rate limited, waits for an on-demand refresh in flight
+    /// @param fetch used instead of the on-demand fetch function, e.g. to report statistics
+    /// @throws whatever the fetch function throws
+    auto Update(const FetchFunction& fetch) -> void;
+
+    /// @brief Refresh the secrets unless they were refreshed after seen_generation or too recently
+    /// @return true if the secrets are newer than seen_generation
+    auto Refresh(std::uint64_t seen_generation) -> bool;
+
+    /// @brief The path was still unknown after a recent refresh, don't refresh for it
+    [[nodiscard]] auto IsUnknownPath(std::string_view path) -> bool;
+    auto RememberUnknownPath(std::string_view path) -> void;
+
+private:
+    /// Paths are keyed by their hash, a collision only delays the refresh for another unknown path
+    static auto GetPathKey(std::string_view path) -> std::size_t;
+
+    const SecretRefresherSettings settings_;
+    const FetchFunction fetch_;
+    /// Serializes the periodic and the on-demand updates, a single fetch is in flight
+    userver::engine::Mutex refresh_mutex_;
+    std::atomic<std::uint64_t> generation_{0};
+    Clock::time_point last_refresh_{};
+    userver::engine::Mutex unknown_paths_mutex_;
+    userver::cache::LruMap<std::size_t, Clock::time_point> unknown_paths_;
+};
+
+}  // namespace paddle::auth
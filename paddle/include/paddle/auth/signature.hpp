@@ -1,10 +1,29 @@
 #pragma once
 
+#include <paddle/auth/hmac_sha256.hpp>
+
 #include <cstdint>
+#include <optional>
 #include <string_view>
 
 namespace paddle {
 
+/// @brief Parts of the Paddle-Signature header, `ts=<timestamp>;h1=<signature>`
+struct SignatureHeader {
+    std::string_view timestamp;
+    /// Hex encoded HMAC-SHA256 of `<timestamp>:<payload>`
+    std::string_view signature;
+};
+
+/// @brief Parse the signature header and check its age
+/// @param max_age_seconds The maximum age of the signature in seconds. -1 means no limit
+/// @return std::nullopt if the header is malformed or the signature is too old
+auto ParseSignatureHeader(std::string_view signature_header, std::int32_t max_age_seconds = -1)
+    -> std::optional<SignatureHeader>;
+
+/// @brief The signature header signs the payload with the digest
+auto MatchesSignature(const SignatureHeader& header, const auth::Sha256Digest& digest) -> bool;
+
 /// @brief Verify the signature of the payload
 /// @param secret The secret key
 /// @param signature The signature header
@@ -18,4 +37,4 @@ auto VerifySignature(
     std::int32_t max_age_seconds = -1  // -1 means no limit
 ) -> bool;
 
-}  // namespace paddle
\ No newline at end of file
+}  // namespace paddle
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace paddle {
+
+namespace auth {
+class BatchVerifier;
+}  // namespace auth
+
+enum class SecretMatch {
+    kVerified,     ///< Signature matches one of the path secrets
+    kMismatch,     ///< Signature matches none of the path secrets
+    kUnknownPath,  ///< No secrets for the path
+};
+
+/// @brief Webhook secrets by destination path
+///
+/// A path may have several secrets, e.g. two notification settings with the
+/// same destination while a secret is being rotated. Paths of wildcard
+/// patterns (`/paddle/webhook/*`) without secrets of their own are checked
+/// against the secrets of every destination under the pattern prefix.
+/// Secrets of a path are tried starting with the one that verified the last
+/// signature. Lookups by string_view don't allocate.
+class WebhookSecrets final {
+public:
+    /// @param wildcard_paths path patterns ending with `*`
+    explicit WebhookSecrets(const std::vector<std::string>& wildcard_paths = {});
+
+    WebhookSecrets(const WebhookSecrets&) = delete;
+    WebhookSecrets& operator=(const WebhookSecrets&) = delete;
+
+    /// @param path destination path, the query string is ignored
+    auto Add(std::string_view path, std::string secret) -> void;
+
+    [[nodiscard]] auto Contains(std::string_view path) const -> bool;
+    /// @brief Number of destination paths
+    [[nodiscard]] auto GetSize() const -> std::size_t;
+
+    /// @param max_age_seconds maximum age of the signature, -1 means no limit
+    /// @param verifier batches the verification with the concurrent ones, all the secrets are checked at once
+    auto Verify(
+        std::string_view path,
+        std::string_view signature,
+        std::string_view payload,
+        std::int32_t max_age_seconds = -1,
+        const auth::BatchVerifier* verifier = nullptr
+    ) const -> SecretMatch;
+
+private:
+    struct Entry {
+        std::vector<std::string> secrets;
+        /// Index of the secret that verified the last signature
+        mutable std::atomic<std::size_t> last_verified{0};
+
+        auto AddSecret(std::string secret) -> void;
+    };
+
+    struct StringHash {
+        using is_transparent = void;
+        auto operator()(std::string_view value) const noexcept -> std::size_t {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+    using EntryMap = std::unordered_map<std::string, Entry, StringHash, std::equal_to<>>;
+
+    [[nodiscard]] auto Find(std::string_view path) const -> const Entry*;
+
+    EntryMap paths_;
+    /// Keyed by the pattern prefix, `*` removed
+    EntryMap prefixes_;
+    /// Prefix lengths, longest first
+    std::vector<std::size_t> prefix_lengths_;
+};
+
+}  // namespace paddle
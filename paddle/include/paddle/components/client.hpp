@@ -1,6 +1,8 @@
 #pragma once
 
+#include <paddle/types/ip_addresses.hpp>
 #include <paddle/types/notification_settings.hpp>
+#include <paddle/types/notifications.hpp>
 #include <paddle/types/price.hpp>
 #include <paddle/types/price_preview.hpp>
 #include <paddle/types/product.hpp>
@@ -41,10 +43,37 @@ public:
     [[nodiscard]] auto GetAllNotificationSettings() const -> std::vector<NotificationSetting>;
     [[nodiscard]] auto GetNotificationSettings(std::string_view cursor, std::int32_t per_page = kDefaultPerPage) const
         -> ResponseWithCursor<NotificationSetting>;
+    /// @brief Change the notification setting, requires the notification setting write permission
+    auto UpdateNotificationSetting(const NotificationSettingId& id, const NotificationSettingUpdate& update) const
+        -> NotificationSetting;
+    /// @brief Page of the notifications (event deliveries) selected by the query
+    [[nodiscard]] auto GetNotifications(
+        std::string_view cursor,
+        const NotificationQuery& query,
+        std::int32_t per_page = kDefaultPerPage
+    ) const -> ResponseWithCursor<Notification>;
+
+    /// @brief Addresses Paddle sends webhooks from, for the sandbox or the live environment of base-url
+    [[nodiscard]] auto GetIpAddresses() const -> IpAddresses;
 
     [[nodiscard]] auto GetAllEvents() const -> std::vector<events::Event<JSON>>;
     [[nodiscard]] auto GetEvents(std::string_view cursor, std::int32_t per_page = kDefaultPerPage) const
         -> ResponseWithCursor<events::Event<JSON>>;
+    /// @brief Same as GetEvents, keeps the JSON of every event as received
+    [[nodiscard]] auto GetRawEvents(std::string_view cursor, std::int32_t per_page = kDefaultPerPage) const
+        -> ResponseWithCursor<events::RawEvent>;
+    /// @brief Page of the events selected by the query
+    /// @note A page may contain less than per_page events or even none, while there are more of them
+    [[nodiscard]] auto GetEvents(
+        std::string_view cursor,
+        const events::EventQuery& query,
+        std::int32_t per_page = kDefaultPerPage
+    ) const -> ResponseWithCursor<events::Event<JSON>>;
+    [[nodiscard]] auto GetRawEvents(
+        std::string_view cursor,
+        const events::EventQuery& query,
+        std::int32_t per_page = kDefaultPerPage
+    ) const -> ResponseWithCursor<events::RawEvent>;
 
     [[nodiscard]] auto GetAllProducts() const -> std::vector<products::JsonProduct>;
     [[nodiscard]] auto GetProducts(std::string_view cursor, std::int32_t per_page = kDefaultPerPage) const
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <paddle/types/event_query.hpp>
+#include <paddle/types/events.hpp>
+#include <paddle/types/ids.hpp>
+#include <paddle/types/response.hpp>
+
+#include <userver/components/component_base.hpp>
+#include <userver/utils/fast_pimpl.hpp>
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace paddle::components {
+
+/// @brief Local archive of the Paddle events, for replays and entity history
+/// without API calls
+///
+/// The webhook handler archives every verified event and the replay controller
+/// every event fetched from Paddle when they reference the archive in their
+/// `archive` config option. Events are stored in NDJSON segment files with a
+/// memory-mapped index by event id and entity id, see archive::EventLog.
+///
+/// Configuration:
+/// - directory: where the segment files are kept
+/// - segment_max_size: size of a segment file before a new one is started (64MiB by default)
+/// - fs_task_processor: task processor for the file IO
+class EventArchive final : public userver::components::ComponentBase {
+public:
+    using BaseType = userver::components::ComponentBase;
+    static constexpr std::string_view kName = "paddle-event-archive";
+
+    EventArchive(
+        const userver::components::ComponentConfig& config,
+        const userver::components::ComponentContext& context
+    );
+    ~EventArchive() override;
+
+    static auto GetStaticConfigSchema() -> userver::yaml_config::Schema;
+
+    /// @brief Archive the event JSON unless an event with the same id is already archived
+    /// @return false if the event was not archived
+    auto Append(std::string_view raw_event) const -> bool;
+    auto Append(const events::RawEvent& event) const -> bool;
+
+    [[nodiscard]] auto Contains(const EventId& event_id) const -> bool;
+    [[nodiscard]] auto GetEvent(const EventId& event_id) const -> std::optional<events::RawEvent>;
+    /// @brief Page of the archived events after the cursor selected by the query,
+    ///        same as Client::GetRawEvents
+    [[nodiscard]] auto GetEvents(std::string_view cursor, const events::EventQuery& query, std::size_t per_page) const
+        -> ResponseWithCursor<events::RawEvent>;
+    /// @brief All the archived events of the entity (e.g. `sub_...`), in order
+    [[nodiscard]] auto GetEntityHistory(std::string_view entity_id) const -> std::vector<events::RawEvent>;
+
+private:
+    constexpr static auto kImplSize = 256UL;
+    constexpr static auto kImplAlign = 16UL;
+    struct Impl;
+    userver::utils::FastPimpl<Impl, kImplSize, kImplAlign> impl_;
+};
+
+}  // namespace paddle::components
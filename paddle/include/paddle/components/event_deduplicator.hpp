@@ -0,0 +1,50 @@
+#pragma once
+
+#include <paddle/types/ids.hpp>
+
+#include <userver/components/component_base.hpp>
+#include <userver/utils/fast_pimpl.hpp>
+
+#include <string_view>
+
+namespace paddle::components {
+
+/// @brief Guards against processing the same event twice
+///
+/// Remembers recently seen event ids in a bounded LRU map. An event that is
+/// being processed or was processed successfully within the TTL is reported
+/// as a duplicate. Failed events are forgotten, so that a retry (from Paddle
+/// or from a replay) can process them again.
+///
+/// Configuration:
+/// - max_size: maximum number of remembered events (100000 by default)
+/// - ttl: how long a processed event is remembered (1h by default)
+class EventDeduplicator final : public userver::components::ComponentBase {
+public:
+    using BaseType = userver::components::ComponentBase;
+    static constexpr std::string_view kName = "paddle-event-deduplicator";
+
+    EventDeduplicator(
+        const userver::components::ComponentConfig& config,
+        const userver::components::ComponentContext& context
+    );
+    ~EventDeduplicator() override;
+
+    static auto GetStaticConfigSchema() -> userver::yaml_config::Schema;
+
+    /// @brief Mark the event as being processed
+    /// @return false if the event is already being processed or was processed recently
+    [[nodiscard]] auto TryBegin(const EventId& event_id) const -> bool;
+    /// @brief Mark the event as successfully processed
+    auto Complete(const EventId& event_id) const -> void;
+    /// @brief Forget the event after a failure, so that it can be processed again
+    auto Abort(const EventId& event_id) const -> void;
+
+private:
+    constexpr static auto kImplSize = 256UL;
+    constexpr static auto kImplAlign = 16UL;
+    struct Impl;
+    userver::utils::FastPimpl<Impl, kImplSize, kImplAlign> impl_;
+};
+
+}  // namespace paddle::components
@@ -1,17 +1,67 @@
 #pragma once
 
+#include <paddle/types/event_query.hpp>
 #include <paddle/types/events.hpp>
 
 #include <userver/components/component_base.hpp>
 
 #include <userver/utils/fast_pimpl.hpp>
 
+#include <cstddef>
 #include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace paddle::components {
 
+/// @brief Options of a single replay, override the component config
+struct ReplayOptions {
+    /// Replay the archived events instead of fetching them from Paddle
+    bool from_archive = false;
+    /// Entities replayed concurrently, the `concurrency` config option by default
+    std::optional<std::size_t> concurrency;
+    /// Events per second of this replay, 0 - unlimited; the `throttle` config option applies as well
+    double max_rate = 0;
+    /// Save the cursor under the checkpoint of the controller after every page, so that
+    /// Resume continues from it. Ignored for filtered and archive replays, which skip events
+    bool save_checkpoint = false;
+};
+
+/// @brief Cursor a replay page moves the checkpoint of the controller to
+/// @param replayed number of leading page events replayed
+/// @param page_cursor cursor after the page, events not selected by the query included
+/// @return std::nullopt if the checkpoint must stay where it is
+auto GetPageCheckpoint(
+    const events::EventQuery& query,
+    const ReplayOptions& options,
+    const std::vector<events::RawEvent>& events,
+    std::size_t replayed,
+    std::string_view page_cursor
+) -> std::optional<std::string>;
+
 /// @brief Component fetches events from Paddle and replays them to
 /// the local handlers
+///
+/// Events of different entities (by `data.id`) can be replayed concurrently,
+/// see the `concurrency` config option. Events of the same entity are always
+/// replayed in the order of their ids.
+///
+/// With a ReplayCheckpointStore configured the id of the last replayed event
+/// is saved after every page of an unfiltered ReplaySince, Resume or catch-up,
+/// so that an interrupted replay can be resumed. Filtered, archive and admin
+/// replays leave the checkpoint alone.
+/// `catch_up_on_start` replays the events missed by the webhook handler while
+/// the service was down before the service starts accepting requests.
+///
+/// With an EventArchive configured the events fetched from Paddle are archived,
+/// and ReplayFromArchive replays them again from the local disk.
+///
+/// The replay rate can be limited with the `throttle` config option. With a
+/// `latency_target` the rate is adapted to the p95 latency of the handlers
+/// (additive increase, multiplicative decrease), and the service can pause
+/// the replay altogether when it is overloaded, see SetPaused.
 class EventReplayController : public userver::components::ComponentBase {
 public:
     using BaseType = userver::components::ComponentBase;
@@ -26,13 +76,61 @@ public:
     static auto GetStaticConfigSchema() -> userver::yaml_config::Schema;
 
     /// @brief Replay a single event to the local handlers
+    /// @note The handlers get the event serialized back to JSON, prefer the
+    ///       RawEvent overload when the original JSON is available
     void Replay(events::Event<JSON>&& event) const;
+    /// @brief Replay a single event, the handlers get the original event JSON
+    void Replay(events::RawEvent&& event) const;
 
+    /// @brief Replay all the events after the cursor (event id), the checkpoint
+    ///        is saved after every page
+    /// @param callback called for each event, in order, once the event and all the
+    ///        events before it are replayed; the event id is a safe cursor to resume from
+    /// @throws the first handler error, the events after the failed one are not reported
     void ReplaySince(std::string_view cursor, ReplayInfoCallback callback = nullptr) const;
+    /// @brief Replay the events after the cursor selected by the query, e.g.
+    ///        `transaction.*` events of the last 6 hours
+    /// @see ReplaySince, Client::GetEvents
+    void ReplaySince(
+        std::string_view cursor,
+        const events::EventQuery& query,
+        ReplayInfoCallback callback = nullptr
+    ) const;
+
+    /// @brief Replay the events after the cursor selected by the query with
+    ///        the given concurrency, rate and source
+    /// @see ReplaySince
+    void ReplaySince(
+        std::string_view cursor,
+        const events::EventQuery& query,
+        const ReplayOptions& options,
+        ReplayInfoCallback callback = nullptr
+    ) const;
+
+    /// @brief Replay the archived events after the cursor selected by the query,
+    ///        without API calls
+    /// @throws std::runtime_error if no event archive is configured
+    /// @see ReplaySince, EventArchive
+    void ReplayFromArchive(
+        std::string_view cursor,
+        const events::EventQuery& query = {},
+        ReplayInfoCallback callback = nullptr
+    ) const;
+
+    /// @brief Continue the replay from the saved checkpoint
+    /// @throws std::runtime_error if no checkpoint store is configured or nothing was replayed yet
+    void Resume(ReplayInfoCallback callback = nullptr) const;
+
+    /// @brief Pause or continue the running replays, a paused replay waits
+    ///        before the next event and can still be cancelled
+    void SetPaused(bool paused) const;
+    [[nodiscard]] auto IsPaused() const -> bool;
+    /// @brief Current replay rate limit, events per second, 0 - unlimited
+    [[nodiscard]] auto GetRate() const -> double;
 
 private:
-    constexpr static auto kImplSize = 88UL;
-    constexpr static auto kImplAlign = 8UL;
+    constexpr static auto kImplSize = 2048UL;
+    constexpr static auto kImplAlign = 16UL;
     struct Impl;
     userver::utils::FastPimpl<Impl, kImplSize, kImplAlign> impl_;
 };
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <userver/components/component_base.hpp>
+#include <userver/utils/fast_pimpl.hpp>
+
+#include <cstddef>
+#include <string_view>
+
+namespace paddle::components {
+
+/// @brief Processes the events Paddle failed to deliver to the webhooks
+///
+/// Periodically lists the notifications with `failed` status that occurred
+/// within the lookback window and dispatches their events to the configured
+/// handlers, the same way the webhook handler does. `needs_retry` ones are
+/// left to Paddle, which still retries them. With a deduplicator the events
+/// already processed by the webhook handler (e.g. delivered after Paddle gave
+/// up waiting for the response) are skipped. Reconciled notifications are
+/// remembered in memory, so that they are not dispatched again on the next
+/// run. The memory is lost on restart: the failed notifications within the
+/// lookback window are then dispatched once more, unless the deduplicator
+/// still remembers their events, so the handlers must be idempotent.
+/// Counters are exported under `paddle.reconciler`.
+///
+/// Configuration:
+/// - client_name: Paddle client component name (paddle-client by default)
+/// - deduplicator: event deduplicator component name, shared with the webhook handler
+/// - notification_setting_id: reconcile the notifications of this destination only
+/// - interval: how often the notifications are checked (1m by default)
+/// - lookback: how far back the notifications are checked (24h by default)
+/// - max_remembered: number of reconciled notification ids to remember (100000 by default)
+/// - handler names, `execution` and `snapshots` sections, same as the webhook handler
+class FailedNotificationReconciler final : public userver::components::ComponentBase {
+public:
+    using BaseType = userver::components::ComponentBase;
+    static constexpr std::string_view kName = "paddle-failed-notification-reconciler";
+
+    struct ReconcileResult {
+        /// Events dispatched successfully
+        std::size_t reconciled = 0;
+        /// Events already processed by the webhook handler
+        std::size_t duplicates = 0;
+        /// Events the handlers failed on, they are retried on the next run
+        std::size_t failed = 0;
+    };
+
+    FailedNotificationReconciler(
+        const userver::components::ComponentConfig& config,
+        const userver::components::ComponentContext& context
+    );
+    ~FailedNotificationReconciler() override;
+
+    static auto GetStaticConfigSchema() -> userver::yaml_config::Schema;
+
+    /// @brief Run a reconciliation pass now, the periodic ones keep running
+    auto Reconcile() const -> ReconcileResult;
+
+private:
+    constexpr static auto kImplSize = 2048UL;
+    constexpr static auto kImplAlign = 16UL;
+    struct Impl;
+    userver::utils::FastPimpl<Impl, kImplSize, kImplAlign> impl_;
+};
+
+}  // namespace paddle::components
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <paddle/auth/ip_allowlist.hpp>
+
+#include <userver/cache/caching_component_base.hpp>
+#include <userver/server/http/http_request.hpp>
+#include <userver/utils/fast_pimpl.hpp>
+
+namespace paddle::components {
+
+/// @brief Cache of the addresses webhooks are accepted from
+///
+/// Combines the Paddle webhook source ranges, refreshed from the Paddle API
+/// with the cache updates, and the static `cidrs` of the config. Behind
+/// `trusted_proxy_depth` reverse proxies the client address is taken from the
+/// `X-Forwarded-For` header instead of the connection peer.
+/// The check costs a binary search and is meant to reject the scanners before
+/// the signature is verified.
+class IpAllowlistCache final : public userver::components::CachingComponentBase<IpAllowlist> {
+public:
+    using BaseType = userver::components::CachingComponentBase<IpAllowlist>;
+    static constexpr auto kName = "paddle-ip-allowlist";
+
+public:
+    IpAllowlistCache(
+        const userver::components::ComponentConfig& config,
+        const userver::components::ComponentContext& context
+    );
+    ~IpAllowlistCache() override;
+
+    static auto GetStaticConfigSchema() -> userver::yaml_config::Schema;
+
+    auto IsAllowed(const userver::server::http::HttpRequest& request) const -> bool;
+
+private:
+    auto Update(
+        userver::cache::UpdateType type,
+        const std::chrono::system_clock::time_point& last_update,
+        const std::chrono::system_clock::time_point& now,
+        userver::cache::UpdateStatisticsScope& stats_scope
+    ) -> void override;
+
+private:
+    constexpr static auto kImplSize = 64UL;
+    constexpr static auto kImplAlign = 8UL;
+    struct Impl;
+    userver::utils::FastPimpl<Impl, kImplSize, kImplAlign> impl_;
+};
+
+}  // namespace paddle::components
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <paddle/types/notification_settings.hpp>
+
+#include <userver/components/component_base.hpp>
+#include <userver/utils/fast_pimpl.hpp>
+
+#include <string_view>
+#include <vector>
+
+namespace paddle::components {
+
+/// @brief Keeps the notification settings subscribed to the handled events only
+///
+/// Paddle sends every event a notification setting is subscribed to, events no
+/// handler is configured for are still received, verified and parsed. The
+/// component compares the subscriptions of the active URL notification settings
+/// pointing to the webhook host with the event types of the configured handlers
+/// and reports the difference. With `narrow` enabled (requires the notification
+/// setting write permission of the API key) the unhandled events are
+/// unsubscribed. Missing events are only reported, the subscription is never
+/// widened. Counts are exported under `paddle.subscriptions`.
+///
+/// Configuration:
+/// - client_name: Paddle client component name (paddle-client by default)
+/// - webhook_host: hostname of the webhook server, same as in the webhook secret cache
+/// - webhook_path: check the notification settings of this webhook path only
+/// - narrow: unsubscribe from the unhandled events (false by default)
+/// - interval: how often the subscriptions are checked (1h by default)
+/// - handler names, same as the webhook handler
+class NotificationSubscriptionSync final : public userver::components::ComponentBase {
+public:
+    using BaseType = userver::components::ComponentBase;
+    static constexpr std::string_view kName = "paddle-notification-subscription-sync";
+
+    NotificationSubscriptionSync(
+        const userver::components::ComponentConfig& config,
+        const userver::components::ComponentContext& context
+    );
+    ~NotificationSubscriptionSync() override;
+
+    static auto GetStaticConfigSchema() -> userver::yaml_config::Schema;
+
+    /// @brief Check the subscriptions now and narrow them if configured
+    /// @return differences of the matching notification settings, before narrowing
+    auto Sync() const -> std::vector<SubscriptionDiff>;
+
+private:
+    constexpr static auto kImplSize = 512UL;
+    constexpr static auto kImplAlign = 16UL;
+    struct Impl;
+    userver::utils::FastPimpl<Impl, kImplSize, kImplAlign> impl_;
+};
+
+}  // namespace paddle::components
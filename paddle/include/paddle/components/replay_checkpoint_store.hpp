@@ -0,0 +1,107 @@
+#pragma once
+
+#include <paddle/types/ids.hpp>
+
+#include <userver/components/component_base.hpp>
+#include <userver/utils/fast_pimpl.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+
+namespace paddle::components {
+
+/// @brief Low watermark of the processed events
+///
+/// Events complete out of order, e.g. webhooks handled concurrently or in the
+/// background. The cursor moves only across a contiguous run of completed
+/// events: an event that is still being processed or has failed holds it
+/// back until the event completes, e.g. when Paddle retries it. When more
+/// than `max_tracked` events are waiting, the oldest pending one is given up
+/// on and the cursor moves past it.
+class EventWatermark {
+public:
+    static constexpr std::size_t kDefaultMaxTracked = 10000;
+
+    explicit EventWatermark(std::size_t max_tracked = kDefaultMaxTracked);
+
+    /// @brief The event is being processed, the cursor must not pass it
+    auto Begin(const EventId& event_id) -> void;
+    /// @brief The event has failed, the cursor must not pass it until it completes
+    auto Fail(const EventId& event_id) -> void;
+    /// @brief The event is processed
+    /// @return the new cursor if it moved
+    auto Complete(const EventId& event_id) -> std::optional<EventId>;
+
+    [[nodiscard]] auto GetCursor() const -> const std::optional<EventId>&;
+
+private:
+    auto MoveCursor() -> bool;
+    auto Trim() -> bool;
+
+    std::size_t max_tracked_;
+    std::optional<EventId> cursor_;
+    std::set<EventId> pending_;
+    std::set<EventId> completed_;
+};
+
+/// @brief Persistent event cursors, used to resume an interrupted replay and
+/// to catch up with the events missed while the service was down
+///
+/// Every cursor is stored under a key, the webhook handler and the replay
+/// controller use their component names. Cursors are kept either in a local
+/// file or in a PostgreSQL table:
+///
+/// @code{.sql}
+/// CREATE TABLE paddle.replay_checkpoints (
+///     name text PRIMARY KEY,
+///     last_event_id text NOT NULL,
+///     updated_at timestamptz NOT NULL DEFAULT now()
+/// );
+/// @endcode
+///
+/// Configuration:
+/// - storage: `file` or `postgres`
+/// - file_path, fs_task_processor: checkpoint file and the task processor for file IO
+/// - postgres_component, postgres_table: PostgreSQL component name and the table
+/// - flush_interval: how often the advanced cursors are persisted (1s by default)
+class ReplayCheckpointStore final : public userver::components::ComponentBase {
+public:
+    using BaseType = userver::components::ComponentBase;
+    static constexpr std::string_view kName = "paddle-replay-checkpoint-store";
+
+    ReplayCheckpointStore(
+        const userver::components::ComponentConfig& config,
+        const userver::components::ComponentContext& context
+    );
+    ~ReplayCheckpointStore() override;
+
+    static auto GetStaticConfigSchema() -> userver::yaml_config::Schema;
+
+    /// @brief Last stored cursor, including the not yet flushed one
+    [[nodiscard]] auto Load(std::string_view key) const -> std::optional<std::string>;
+    /// @brief Store the cursor right away
+    auto Save(std::string_view key, std::string_view cursor) const -> void;
+    /// @brief Hold the cursor before the event until it is processed
+    auto Begin(std::string_view key, const EventId& event_id) const -> void;
+    /// @brief Hold the cursor before the failed event until it is processed
+    auto Fail(std::string_view key, const EventId& event_id) const -> void;
+    /// @brief Mark the event processed and move the cursor forward across the
+    ///        processed events, see EventWatermark
+    ///
+    /// Cheap enough to be called for every processed event, the cursor is
+    /// persisted by a background task every `flush_interval`.
+    auto Advance(std::string_view key, const EventId& event_id) const -> void;
+    /// @brief Persist the advanced cursors
+    auto Flush() const -> void;
+
+private:
+    constexpr static auto kImplSize = 1024UL;
+    constexpr static auto kImplAlign = 16UL;
+    struct Impl;
+    userver::utils::FastPimpl<Impl, kImplSize, kImplAlign> impl_;
+};
+
+}  // namespace paddle::components
@@ -1,11 +1,13 @@
 #pragma once
 
+#include <paddle/auth/webhook_secrets.hpp>
+
 #include <userver/cache/caching_component_base.hpp>
 #include <userver/server/http/http_request.hpp>
 #include <userver/utils/fast_pimpl.hpp>
 
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 namespace paddle::components {
 
@@ -14,10 +16,16 @@ namespace paddle::components {
 /// The cache is used to store webhook secrets for each webhook.
 /// The cache is updated from paddle API.
 /// The cache is used to validate webhook requests.
-class WebhookSecretCache final
-    : public userver::components::CachingComponentBase<std::unordered_map<std::string, std::string>> {
+/// Every destination path may have several secrets, all of them are accepted,
+/// and `wildcard_paths` patterns match the requests to any path under them.
+/// A request for an unknown path or with a signature that doesn't match the
+/// cached secret (e.g. the secret was rotated) triggers a refresh, concurrent
+/// requests wait for the same one. Refreshes are rate limited by
+/// `min_refresh_interval` and the paths still unknown after a refresh are
+/// rejected without refreshing for `unknown_path_ttl`.
+class WebhookSecretCache final : public userver::components::CachingComponentBase<WebhookSecrets> {
 public:
-    using BaseType = userver::components::CachingComponentBase<std::unordered_map<std::string, std::string>>;
+    using BaseType = userver::components::CachingComponentBase<WebhookSecrets>;
     static constexpr auto kName = "paddle-webhook-secret-cache";
 
 public:
@@ -40,7 +48,7 @@ private:
     ) -> void override;
 
 private:
-    constexpr static auto kImplSize = 96UL;
+    constexpr static auto kImplSize = 448UL;
     constexpr static auto kImplAlign = 8UL;
     struct Impl;
     userver::utils::FastPimpl<Impl, kImplSize, kImplAlign> impl_;
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <paddle/handlers/event_dispatcher.hpp>
+#include <paddle/types/events.hpp>
+#include <paddle/types/formats.hpp>
+
+#include <userver/concurrent/background_task_storage.hpp>
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/mutex.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace paddle::handlers {
+
+/// @brief Order in which buffered events of a single entity are dispatched
+///
+/// Events are sorted by `occurred_at`. Every `*.updated` event except the latest
+/// one is dropped, as the latest snapshot supersedes them. Lifecycle events
+/// (created, canceled, paused etc.) are always kept.
+/// @return indices of the events to dispatch, in dispatch order
+auto CoalesceEvents(const std::vector<events::Event<JSON>>& events) -> std::vector<std::size_t>;
+
+/// @brief Buffers events per entity for a short window before dispatching them
+///
+/// The first event of an entity opens a window, events of the same entity
+/// arriving within the window join it. When the window closes the events are
+/// coalesced with CoalesceEvents and dispatched one by one in a background
+/// task, so a cancelled submitter doesn't fail the rest of the batch. Batches
+/// of an entity are dispatched one after another: a window that closes while
+/// the previous batch is still dispatched waits for it. Every submitter waits
+/// for its own event, so handler errors are still reported to the sender of
+/// each event.
+class EventCoalescer final {
+public:
+    using DispatchFunction = std::function<DispatchResult(const JSON& event_json, events::Event<JSON>&& event)>;
+
+    explicit EventCoalescer(std::chrono::milliseconds window);
+    ~EventCoalescer();
+
+    /// @brief Buffer the event and wait until its batch is dispatched
+    /// @return dispatch result, or std::nullopt if the event was superseded by a later one
+    /// @throws the exception thrown while dispatching the batch
+    auto Submit(
+        const std::string& entity_id,
+        const JSON& event_json,
+        events::Event<JSON>&& event,
+        const DispatchFunction& dispatch
+    ) -> std::optional<DispatchResult>;
+
+private:
+    struct Batch;
+    /// Batches of an entity in dispatch order, only the last one may still be open
+    using BatchQueue = std::deque<std::shared_ptr<Batch>>;
+
+    auto Run(const std::string& entity_id, const std::shared_ptr<Batch>& batch, const DispatchFunction& dispatch)
+        -> void;
+    auto Process(Batch& batch, const DispatchFunction& dispatch) -> void;
+    auto Finish(const std::string& entity_id, const std::shared_ptr<Batch>& batch) -> void;
+    auto WaitForResult(
+        std::unique_lock<userver::engine::Mutex>& lock,
+        const std::shared_ptr<Batch>& batch,
+        std::size_t index
+    ) -> std::optional<DispatchResult>;
+
+    std::chrono::milliseconds window_;
+    userver::engine::Mutex mutex_;
+    userver::engine::ConditionVariable batch_done_;
+    std::unordered_map<std::string, BatchQueue> batches_;
+    // Destroyed first, the batch tasks use the members above
+    userver::concurrent::BackgroundTaskStorage bts_;
+};
+
+}  // namespace paddle::handlers
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <paddle/types/events.hpp>
+#include <paddle/types/formats.hpp>
+
+#include <userver/components/component_fwd.hpp>
+#include <userver/utils/fast_pimpl.hpp>
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+namespace paddle::handlers {
+
+/// @brief Handler did not finish before the category deadline and was cancelled
+class HandlerTimeoutError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/// @brief No free execution slot was available for the category within the queue timeout
+class HandlerConcurrencyLimitError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+enum class DispatchResult {
+    kHandled,      ///< Handler finished successfully
+    kScheduled,    ///< Handler was started in background
+    kNoHandler,    ///< No handler is configured for the event category
+    kUnsupported,  ///< Event category is not supported
+    kSkipped,      ///< Update did not change any of the fields watched by the handler
+};
+
+/// @brief Routes events to the configured category handlers
+///
+/// Handlers of each category can be isolated from the caller with the
+/// `execution` config section: a dedicated task processor, a limit of
+/// concurrently running handlers and a deadline after which the handler
+/// task is cancelled. Per-category metrics are exported under the
+/// `paddle.handlers` prefix.
+///
+/// With the `snapshots` config section the dispatcher keeps the last seen
+/// state of each entity and fills events::Event::changes before calling the
+/// handler. Updates that changed none of the category `watched_fields` are
+/// not passed to the handler at all.
+class EventDispatcher final {
+public:
+    /// @brief Called with the duration of each handler run, successful or not
+    using LatencyObserver = std::function<void(events::EventTypeName, std::chrono::milliseconds)>;
+    /// @brief Called when the handler finishes, the exception pointer is null on success
+    using CompletionCallback = std::function<void(std::exception_ptr)>;
+
+    EventDispatcher(
+        const userver::components::ComponentConfig& config,
+        const userver::components::ComponentContext& context,
+        LatencyObserver latency_observer = nullptr
+    );
+    ~EventDispatcher();
+
+    /// @brief Parse the event payload and run the category handler
+    /// @param event_json full event JSON, passed on to the handler
+    /// @param in_background do not wait for the handler to finish, errors are only logged
+    /// @param on_complete called when the handler finishes, both in foreground and in background
+    /// @throws HandlerTimeoutError, HandlerConcurrencyLimitError or anything the handler throws
+    auto Dispatch(
+        const JSON& event_json,
+        events::Event<JSON>&& event,
+        bool in_background = false,
+        CompletionCallback on_complete = nullptr
+    ) const -> DispatchResult;
+
+    /// @brief Schema of the `execution` and `snapshots` config sections
+    static auto GetConfigSchema() -> std::string;
+
+private:
+    constexpr static auto kImplSize = 576UL;
+    constexpr static auto kImplAlign = 16UL;
+    struct Impl;
+    userver::utils::FastPimpl<Impl, kImplSize, kImplAlign> impl_;
+};
+
+}  // namespace paddle::handlers
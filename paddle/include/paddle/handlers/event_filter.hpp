@@ -0,0 +1,58 @@
+#pragma once
+
+#include <paddle/types/events.hpp>
+
+#include <userver/formats/parse/to.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace paddle::handlers {
+
+/// @brief Outcome of the event filter, every value except kAccepted is a reason to drop the event
+enum class FilterVerdict {
+    kAccepted,
+    kEventType,
+    kTrafficSource,
+    kCustomData,
+};
+
+struct EventFilterConfig {
+    /// Event types to accept, `prefix.*` and `*` wildcards are supported; empty means all
+    std::vector<std::string> allowed_event_types;
+    /// Event types to drop, take precedence over the allowed ones
+    std::vector<std::string> denied_event_types;
+    events::TrafficSource traffic_source = events::TrafficSource::kAll;
+    /// `data.custom_data` members that must be equal to the given values
+    std::vector<std::pair<std::string, std::string>> custom_data;
+};
+
+EventFilterConfig Parse(const userver::yaml_config::YamlConfig& value, userver::formats::parse::To<EventFilterConfig>);
+
+/// @brief Declarative predicates on the raw event envelope
+///
+/// Events are checked on the serialized body, before it is parsed, so that
+/// events of other applications sharing the Paddle account cost a scan of
+/// the envelope instead of a full parse. Events that can't be checked (e.g.
+/// malformed ones) are accepted and left for the parser to report.
+class EventFilter final {
+public:
+    explicit EventFilter(EventFilterConfig config);
+
+    /// @brief No predicates configured, every event is accepted
+    [[nodiscard]] auto IsEmpty() const -> bool;
+
+    [[nodiscard]] auto Evaluate(std::string_view raw_event) const -> FilterVerdict;
+
+    static auto GetConfigSchema() -> std::string;
+
+private:
+    auto IsEventTypeAccepted(std::string_view event_type) const -> bool;
+
+    EventFilterConfig config_;
+};
+
+}  // namespace paddle::handlers
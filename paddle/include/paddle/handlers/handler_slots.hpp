@@ -0,0 +1,32 @@
+#pragma once
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/semaphore.hpp>
+
+#include <chrono>
+#include <cstddef>
+
+namespace paddle::handlers {
+
+/// @brief Limits the number of concurrently running handlers of an event category
+///
+/// A handler waits for a free slot at most `queue_timeout`, so a saturated
+/// category rejects new events instead of piling them up, even when the
+/// handlers have no deadline. A zero `queue_timeout` rejects right away.
+class HandlerSlots final {
+public:
+    HandlerSlots(std::size_t max_concurrency, std::chrono::milliseconds queue_timeout);
+
+    auto GetMaxConcurrency() const -> std::size_t;
+
+    /// @brief Take a slot, waiting no longer than the queue timeout and never past the deadline
+    /// @return lock that doesn't own a slot if none was freed in time
+    auto Acquire(userver::engine::Deadline deadline) -> userver::engine::SemaphoreLock;
+
+private:
+    std::size_t max_concurrency_;
+    std::chrono::milliseconds queue_timeout_;
+    userver::engine::Semaphore semaphore_;
+};
+
+}  // namespace paddle::handlers
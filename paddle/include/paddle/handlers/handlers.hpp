@@ -1,9 +1,12 @@
 #pragma once
 
+#include <paddle/types/events.hpp>
+
 #include <userver/components/component_fwd.hpp>
 #include <userver/yaml_config/schema.hpp>
 
 #include <string_view>
+#include <vector>
 
 namespace paddle::handlers {
 
@@ -17,7 +20,9 @@ class PaymentMethodHandlerBase;
 class PriceHandlerBase;
 class ProductHandlerBase;
 class SubscriptionHandlerBase;
+class SubscriptionViewHandlerBase;
 class TransactionHandlerBase;
+class TransactionViewHandlerBase;
 
 /// @brief Collection of event handlers
 struct Handlers {
@@ -31,6 +36,9 @@ struct Handlers {
     ProductHandlerBase* product_handler = nullptr;
     SubscriptionHandlerBase* subscription_handler = nullptr;
     TransactionHandlerBase* transaction_handler = nullptr;
+    /// Alternatives to the handlers above, receive the payload decoded on demand
+    SubscriptionViewHandlerBase* subscription_view_handler = nullptr;
+    TransactionViewHandlerBase* transaction_view_handler = nullptr;
 
     Handlers(const userver::components::ComponentConfig& config, const userver::components::ComponentContext& context);
 
@@ -38,9 +46,15 @@ struct Handlers {
         return address_handler == nullptr && api_key_handler == nullptr && business_handler == nullptr &&
                client_token_handler == nullptr && customer_handler == nullptr && payment_method_handler == nullptr &&
                price_handler == nullptr && product_handler == nullptr && subscription_handler == nullptr &&
-               transaction_handler == nullptr;
+               transaction_handler == nullptr && subscription_view_handler == nullptr &&
+               transaction_view_handler == nullptr;
     }
 
+    /// @brief A handler is configured for the event category
+    [[nodiscard]] auto Handles(events::EventCategory category) const -> bool;
+    /// @brief Event types of the categories a handler is configured for
+    [[nodiscard]] auto GetHandledEventTypes() const -> std::vector<events::EventTypeName>;
+
     static auto GetHanderNames() -> std::string_view;
 };
 
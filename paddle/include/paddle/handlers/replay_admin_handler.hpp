@@ -0,0 +1,51 @@
+#pragma once
+
+#include <paddle/types/fwd.hpp>
+
+#include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/utils/fast_pimpl.hpp>
+
+namespace paddle::handlers {
+
+/// @brief Admin endpoint to run event replays interactively
+///
+/// - `POST` starts a replay job and streams its progress as NDJSON, one line
+///   every `progress_interval`: events per second, current cursor, lag behind
+///   the head of the event stream, ETA and per-category counts. The body is a
+///   JSON object with the optional `cursor`, `event_types` (`prefix.*`
+///   wildcards), `occurred_after`, `occurred_before`, `entity_ids`,
+///   `concurrency`, `max_rate` and `source` (`api` or `archive`) fields.
+/// - `GET` lists the running jobs with their progress.
+/// - `DELETE ?job_id=...` cancels a job. A job is also cancelled when its
+///   client disconnects.
+///
+/// Jobs don't save the replay checkpoint, so they don't move the cursor that
+/// EventReplayController::Resume and the startup catch-up continue from.
+///
+/// The handler must be configured with `response-body-stream: true`.
+class ReplayAdminHandler final : public userver::server::handlers::HttpHandlerBase {
+public:
+    using BaseType = userver::server::handlers::HttpHandlerBase;
+
+    ReplayAdminHandler(
+        const userver::components::ComponentConfig& config,
+        const userver::components::ComponentContext& context
+    );
+    ~ReplayAdminHandler() override;
+
+    static auto GetStaticConfigSchema() -> userver::yaml_config::Schema;
+
+    void HandleStreamRequest(
+        const userver::server::http::HttpRequest& request,
+        userver::server::request::RequestContext& context,
+        userver::server::http::ResponseBodyStream& response_body_stream
+    ) const override final;
+
+private:
+    constexpr static auto kImplSize = 192UL;
+    constexpr static auto kImplAlign = 16UL;
+    struct Impl;
+    userver::utils::FastPimpl<Impl, kImplSize, kImplAlign> impl_;
+};
+
+}  // namespace paddle::handlers
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/formats/parse/to.hpp>
+#include <userver/utils/statistics/percentile.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace paddle::handlers {
+
+struct ReplayThrottleSettings {
+    /// Events per second, 0 - unlimited
+    double max_rate = 0;
+    /// Adaptive rate never goes below this
+    double min_rate = 1;
+    /// Handler p95 latency to keep, 0 - no adaptation
+    std::chrono::milliseconds latency_target{0};
+    /// Events per second added after an interval within the latency target
+    double increase_step = 10;
+    /// Rate multiplier after an interval over the latency target
+    double decrease_factor = 0.5;
+    std::chrono::milliseconds adjust_interval{1000};
+};
+
+ReplayThrottleSettings
+Parse(const userver::yaml_config::YamlConfig& value, userver::formats::parse::To<ReplayThrottleSettings>);
+
+/// @brief Spaces out the starts of the events at the given rate
+///
+/// Not thread safe, time points are passed explicitly.
+class RatePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit RatePacer(double rate);
+
+    /// @brief 0 - unlimited
+    auto SetRate(double rate) -> void;
+    [[nodiscard]] auto GetRate() const -> double {
+        return rate_;
+    }
+
+    /// @brief Reserve a slot for the next event
+    /// @return time point when the event may start
+    auto Reserve(Clock::time_point now) -> Clock::time_point;
+
+private:
+    double rate_;
+    Clock::time_point next_slot_{};
+};
+
+/// @brief Additive increase, multiplicative decrease of the replay rate
+/// @param rate current rate, 0 - unlimited
+/// @param observed_rate events per second replayed during the last interval
+/// @param p95 handler p95 latency during the last interval
+/// @return new rate, 0 - unlimited; a decreased rate is always positive
+auto AdjustRate(
+    double rate,
+    double observed_rate,
+    std::chrono::milliseconds p95,
+    const ReplayThrottleSettings& settings
+) -> double;
+
+/// @brief Limits the replay rate, adapts it to the handler latency and
+/// lets the service pause the replay
+///
+/// Thread safe, shared by the replay workers.
+class ReplayThrottle final {
+public:
+    explicit ReplayThrottle(ReplayThrottleSettings settings);
+
+    /// @brief Wait for the next replay slot, waits while paused
+    /// @throws userver::engine::WaitInterruptedException if the task is cancelled
+    auto Acquire() -> void;
+    /// @brief Account handler latency of a replayed event
+    auto Account(std::chrono::milliseconds latency) -> void;
+
+    auto Pause() -> void;
+    auto Resume() -> void;
+    [[nodiscard]] auto IsPaused() const -> bool;
+
+    /// @brief Current rate limit, events per second, 0 - unlimited
+    [[nodiscard]] auto GetRate() const -> double;
+
+    static auto GetConfigSchema() -> std::string;
+
+private:
+    /// Milliseconds, 1 ms resolution below 200 ms and 100 ms resolution up to 10 s
+    using LatencyPercentile = userver::utils::statistics::Percentile<200, std::uint32_t, 98, 100>;
+
+    auto AdjustIfNeeded(RatePacer::Clock::time_point now) -> void;
+
+    const ReplayThrottleSettings settings_;
+    mutable userver::engine::Mutex mutex_;
+    userver::engine::ConditionVariable resumed_;
+    bool paused_ = false;
+    RatePacer pacer_;
+    LatencyPercentile latencies_;
+    std::uint64_t interval_events_ = 0;
+    RatePacer::Clock::time_point interval_start_;
+};
+
+}  // namespace paddle::handlers
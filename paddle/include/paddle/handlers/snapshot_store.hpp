@@ -0,0 +1,76 @@
+#pragma once
+
+#include <paddle/types/events.hpp>
+#include <paddle/types/formats.hpp>
+#include <paddle/types/timestamp.hpp>
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/engine/mutex.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <string>
+
+namespace paddle::handlers {
+
+/// @brief Last seen state of an entity
+struct EntitySnapshot {
+    Timestamp occurred_at;
+    JSON data;
+};
+
+/// @brief Storage of the last seen entity snapshots, used to compute event changes
+/// @note This class IS NOT in userver's components hierarchy. To provide a custom
+///       store (e.g. backed by a database) derive a component from both
+///       userver::components::ComponentBase and this class and reference it in
+///       the `snapshots.store` config option of the webhook handler.
+class SnapshotStoreBase {
+public:
+    virtual ~SnapshotStoreBase() = default;
+
+    /// @return the stored snapshot of the entity, if any
+    virtual auto Find(const std::string& entity_id) -> std::optional<EntitySnapshot> = 0;
+
+    /// @brief Store the snapshot unless a newer one is already stored
+    /// @return the snapshot stored before the call, if any
+    virtual auto Exchange(const std::string& entity_id, const EntitySnapshot& snapshot)
+        -> std::optional<EntitySnapshot> = 0;
+};
+
+/// @brief Bounded in-memory snapshot store
+class LruSnapshotStore final : public SnapshotStoreBase {
+public:
+    explicit LruSnapshotStore(std::size_t max_size);
+
+    auto Find(const std::string& entity_id) -> std::optional<EntitySnapshot> override;
+    auto Exchange(const std::string& entity_id, const EntitySnapshot& snapshot)
+        -> std::optional<EntitySnapshot> override;
+
+private:
+    userver::engine::Mutex mutex_;
+    userver::cache::LruMap<std::string, EntitySnapshot> snapshots_;
+};
+
+/// @brief Snapshot of a dispatched event, stored once the event is handled
+///
+/// A handler that fails leaves the previous snapshot in place, so that the
+/// retry of the event sees the same changes.
+class PendingSnapshot {
+public:
+    /// Nothing to store
+    PendingSnapshot() = default;
+    PendingSnapshot(SnapshotStoreBase& store, std::string entity_id, EntitySnapshot snapshot);
+
+    auto Commit() const -> void;
+
+private:
+    SnapshotStoreBase* store_ = nullptr;
+    std::string entity_id_;
+    EntitySnapshot snapshot_;
+};
+
+/// @brief Fill the event changes by comparing its data to the stored snapshot of the entity
+/// @return the snapshot to store once the event is handled
+auto TrackChanges(SnapshotStoreBase& store, events::Event<JSON>& event) -> PendingSnapshot;
+
+}  // namespace paddle::handlers
@@ -9,10 +9,12 @@
 
 namespace paddle::handlers {
 
-class SubscriptionHandlerBase : public userver::components::ComponentBase {
+/// @tparam Payload subscriptions::Subscription, or subscriptions::SubscriptionView to decode the fields on demand
+template <typename Payload>
+class BasicSubscriptionHandler : public userver::components::ComponentBase {
 public:
     using BaseType = userver::components::ComponentBase;
-    using EventType = events::Event<subscriptions::Subscription>;
+    using EventType = events::Event<Payload>;
     constexpr static auto kEventCategory = events::EventCategory::kSubscription;
 
     using BaseType::BaseType;
@@ -39,4 +41,18 @@ private:
     virtual auto DoHandleUpdated(EventType&&) const -> void;
 };
 
+extern template class BasicSubscriptionHandler<subscriptions::Subscription>;
+extern template class BasicSubscriptionHandler<subscriptions::SubscriptionView>;
+
+class SubscriptionHandlerBase : public BasicSubscriptionHandler<subscriptions::Subscription> {
+public:
+    using BasicSubscriptionHandler::BasicSubscriptionHandler;
+};
+
+/// @brief Subscription handler that receives subscriptions::SubscriptionView payloads
+class SubscriptionViewHandlerBase : public BasicSubscriptionHandler<subscriptions::SubscriptionView> {
+public:
+    using BasicSubscriptionHandler::BasicSubscriptionHandler;
+};
+
 }  // namespace paddle::handlers
\ No newline at end of file
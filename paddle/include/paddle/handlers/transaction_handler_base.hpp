@@ -8,10 +8,12 @@
 
 namespace paddle::handlers {
 
-class TransactionHandlerBase : public userver::components::ComponentBase {
+/// @tparam Payload transactions::Transaction, or transactions::TransactionView to decode the fields on demand
+template <typename Payload>
+class BasicTransactionHandler : public userver::components::ComponentBase {
 public:
     using BaseType = userver::components::ComponentBase;
-    using EventType = events::Event<transactions::Transaction>;
+    using EventType = events::Event<Payload>;
     constexpr static auto kEventCategory = events::EventCategory::kTransaction;
 
     using BaseType::BaseType;
@@ -42,4 +44,18 @@ private:
     virtual auto DoHandleUpdated(EventType&&) const -> void;
 };
 
+extern template class BasicTransactionHandler<transactions::Transaction>;
+extern template class BasicTransactionHandler<transactions::TransactionView>;
+
+class TransactionHandlerBase : public BasicTransactionHandler<transactions::Transaction> {
+public:
+    using BasicTransactionHandler::BasicTransactionHandler;
+};
+
+/// @brief Transaction handler that receives transactions::TransactionView payloads
+class TransactionViewHandlerBase : public BasicTransactionHandler<transactions::TransactionView> {
+public:
+    using BasicTransactionHandler::BasicTransactionHandler;
+};
+
 }  // namespace paddle::handlers
\ No newline at end of file
@@ -2,14 +2,14 @@
 
 #include <paddle/types/fwd.hpp>
 
-#include <userver/server/handlers/http_handler_json_base.hpp>
+#include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/utils/fast_pimpl.hpp>
 
 namespace paddle::handlers {
 
-class WebhookHandler final : public userver::server::handlers::HttpHandlerJsonBase {
+class WebhookHandler final : public userver::server::handlers::HttpHandlerBase {
 public:
-    using BaseType = userver::server::handlers::HttpHandlerJsonBase;
+    using BaseType = userver::server::handlers::HttpHandlerBase;
 
     WebhookHandler(
         const userver::components::ComponentConfig& config,
@@ -19,14 +19,13 @@ public:
 
     static auto GetStaticConfigSchema() -> userver::yaml_config::Schema;
 
-    userver::formats::json::Value HandleRequestJsonThrow(
+    std::string HandleRequestThrow(
         const userver::server::http::HttpRequest& request,
-        const userver::formats::json::Value& request_json,
         userver::server::request::RequestContext& context
     ) const override final;
 
 private:
-    constexpr static auto kImplSize = 224UL;
+    constexpr static auto kImplSize = 768UL;
     constexpr static auto kImplAlign = 16UL;
     struct Impl;
     userver::utils::FastPimpl<Impl, kImplSize, kImplAlign> impl_;
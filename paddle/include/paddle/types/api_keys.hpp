@@ -78,10 +78,10 @@ ApiKeyEventPayload Parse(const Value& value, userver::formats::parse::To<ApiKeyE
     payload.key = value["key"].template As<std::string>();
     payload.status = value["status"].template As<Status>();
     payload.permissions = value["permissions"].template As<std::vector<permissions::Permission>>();
-    payload.expires_at = value["expires_at"].template As<std::optional<Timestamp>>();
-    payload.last_used_at = value["last_used_at"].template As<std::optional<Timestamp>>();
-    payload.created_at = value["created_at"].template As<Timestamp>();
-    payload.updated_at = value["updated_at"].template As<Timestamp>();
+    payload.expires_at = ParseOptionalTimestamp(value["expires_at"]);
+    payload.last_used_at = ParseOptionalTimestamp(value["last_used_at"]);
+    payload.created_at = ParseTimestamp(value["created_at"]);
+    payload.updated_at = ParseTimestamp(value["updated_at"]);
     return payload;
 }
 
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <paddle/types/formats.hpp>
+
+#include <userver/utils/trivial_map.hpp>
+
+#include <bitset>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace paddle::events {
+
+/// @brief Top-level entity fields that can be checked for changes
+enum class Field {
+    kAddressId,
+    kBillingCycle,
+    kBillingDetails,
+    kBusinessId,
+    kCanceledAt,
+    kCollectionMode,
+    kCurrencyCode,
+    kCurrentBillingPeriod,
+    kCustomData,
+    kCustomerId,
+    kDescription,
+    kDetails,
+    kDiscount,
+    kEmail,
+    kFirstBilledAt,
+    kImageUrl,
+    kItems,
+    kLocale,
+    kManagementUrls,
+    kMarketingConsent,
+    kName,
+    kNextBilledAt,
+    kPausedAt,
+    kPayments,
+    kProductId,
+    kQuantity,
+    kScheduledChange,
+    kStatus,
+    kTaxCategory,
+    kTaxMode,
+    kTrialPeriod,
+    kType,
+    kUnitPrice,
+    kUnitPriceOverrides,
+    kUpdatedAt,
+    /// Any top-level field not listed above
+    kOther,
+};
+
+inline constexpr userver::utils::TrivialBiMap kFieldNames = [](auto selector) {
+    return selector()
+        .Case("address_id", Field::kAddressId)
+        .Case("billing_cycle", Field::kBillingCycle)
+        .Case("billing_details", Field::kBillingDetails)
+        .Case("business_id", Field::kBusinessId)
+        .Case("canceled_at", Field::kCanceledAt)
+        .Case("collection_mode", Field::kCollectionMode)
+        .Case("currency_code", Field::kCurrencyCode)
+        .Case("current_billing_period", Field::kCurrentBillingPeriod)
+        .Case("custom_data", Field::kCustomData)
+        .Case("customer_id", Field::kCustomerId)
+        .Case("description", Field::kDescription)
+        .Case("details", Field::kDetails)
+        .Case("discount", Field::kDiscount)
+        .Case("email", Field::kEmail)
+        .Case("first_billed_at", Field::kFirstBilledAt)
+        .Case("image_url", Field::kImageUrl)
+        .Case("items", Field::kItems)
+        .Case("locale", Field::kLocale)
+        .Case("management_urls", Field::kManagementUrls)
+        .Case("marketing_consent", Field::kMarketingConsent)
+        .Case("name", Field::kName)
+        .Case("next_billed_at", Field::kNextBilledAt)
+        .Case("paused_at", Field::kPausedAt)
+        .Case("payments", Field::kPayments)
+        .Case("product_id", Field::kProductId)
+        .Case("quantity", Field::kQuantity)
+        .Case("scheduled_change", Field::kScheduledChange)
+        .Case("status", Field::kStatus)
+        .Case("tax_category", Field::kTaxCategory)
+        .Case("tax_mode", Field::kTaxMode)
+        .Case("trial_period", Field::kTrialPeriod)
+        .Case("type", Field::kType)
+        .Case("unit_price", Field::kUnitPrice)
+        .Case("unit_price_overrides", Field::kUnitPriceOverrides)
+        .Case("updated_at", Field::kUpdatedAt);
+};
+
+/// @brief Fields changed by an event compared to the last seen snapshot of the entity
+///
+/// Changes are unknown when there is no previous snapshot (e.g. the entity was
+/// never seen before, or change tracking is not configured). Unknown changes
+/// contain every field, so that handlers never skip an event by mistake.
+class Changes {
+public:
+    Changes() = default;
+
+    /// @brief Compare two entity snapshots
+    static auto Compute(const JSON& previous, const JSON& current) -> Changes;
+
+    /// @brief Previous snapshot was available and changes were computed
+    [[nodiscard]] auto IsKnown() const -> bool {
+        return known_;
+    }
+    /// @brief Nothing has changed, false if changes are unknown
+    [[nodiscard]] auto IsEmpty() const -> bool {
+        return known_ && paths_.empty();
+    }
+
+    [[nodiscard]] auto Contains(Field field) const -> bool;
+    [[nodiscard]] auto ContainsAny(std::initializer_list<Field> fields) const -> bool;
+    /// @brief Check a dotted field path, e.g. `billing_details.payment_terms`
+    ///
+    /// A path is changed if the field itself, any of its parents or any of its
+    /// nested fields changed.
+    [[nodiscard]] auto Contains(std::string_view path) const -> bool;
+
+    /// @brief Sorted dotted paths of the changed fields, arrays are compared as a whole
+    [[nodiscard]] auto GetPaths() const -> const std::vector<std::string>& {
+        return paths_;
+    }
+
+private:
+    static constexpr auto kFieldCount = static_cast<std::size_t>(Field::kOther) + 1;
+
+    bool known_ = false;
+    std::bitset<kFieldCount> fields_;
+    std::vector<std::string> paths_;
+};
+
+}  // namespace paddle::events
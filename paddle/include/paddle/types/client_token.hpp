@@ -44,9 +44,9 @@ ClientToken Parse(const Value& value, userver::formats::parse::To<ClientToken>)
     token.token = value["token"].template As<std::string>();
     token.name = value["name"].template As<std::string>();
     token.status = value["status"].template As<ClientTokenStatus>();
-    token.revoked_at = value["revoked_at"].template As<OptionalTimestamp>();
-    token.created_at = value["created_at"].template As<Timestamp>();
-    token.updated_at = value["updated_at"].template As<Timestamp>();
+    token.revoked_at = ParseOptionalTimestamp(value["revoked_at"]);
+    token.created_at = ParseTimestamp(value["created_at"]);
+    token.updated_at = ParseTimestamp(value["updated_at"]);
     return token;
 }
 
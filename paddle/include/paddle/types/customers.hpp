@@ -113,8 +113,8 @@ Customer Parse(const Value& value, userver::formats::parse::To<Customer>) {
     customer.status = value["status"].template As<Status>();
     customer.custom_data = value["custom_data"].template As<JSON>();
     customer.locale = value["locale"].template As<std::string>();
-    customer.created_at = value["created_at"].template As<Timestamp>();
-    customer.updated_at = value["updated_at"].template As<Timestamp>();
+    customer.created_at = ParseTimestamp(value["created_at"]);
+    customer.updated_at = ParseTimestamp(value["updated_at"]);
     customer.import_meta = value["import_meta"].template As<JSON>();
     return customer;
 }
@@ -154,8 +154,8 @@ Address Parse(const Value& value, userver::formats::parse::To<Address>) {
     address.country_code = value["country_code"].template As<std::string>();
     address.custom_data = value["custom_data"].template As<JSON>();
     address.status = value["status"].template As<Status>();
-    address.created_at = value["created_at"].template As<Timestamp>();
-    address.updated_at = value["updated_at"].template As<Timestamp>();
+    address.created_at = ParseTimestamp(value["created_at"]);
+    address.updated_at = ParseTimestamp(value["updated_at"]);
     address.import_meta = value["import_meta"].template As<JSON>();
     return address;
 }
@@ -206,8 +206,8 @@ Business Parse(const Value& value, userver::formats::parse::To<Business>) {
     business.tax_identifier = value["tax_identifier"].template As<std::optional<std::string>>();
     business.status = value["status"].template As<Status>();
     business.contacts = value["contacts"].template As<std::vector<Contact>>();
-    business.created_at = value["created_at"].template As<Timestamp>();
-    business.updated_at = value["updated_at"].template As<Timestamp>();
+    business.created_at = ParseTimestamp(value["created_at"]);
+    business.updated_at = ParseTimestamp(value["updated_at"]);
     business.custom_data = value["custom_data"].template As<JSON>();
     business.import_meta = value["import_meta"].template As<JSON>();
     return business;
@@ -34,8 +34,8 @@ template <typename Value>
 DiscountSubscription Parse(const Value& value, userver::formats::parse::To<DiscountSubscription>) {
     DiscountSubscription subscription;
     subscription.id = value["id"].template As<DiscountId>();
-    subscription.starts_at = value["starts_at"].template As<OptionalTimestamp>();
-    subscription.ends_at = value["ends_at"].template As<OptionalTimestamp>();
+    subscription.starts_at = ParseOptionalTimestamp(value["starts_at"]);
+    subscription.ends_at = ParseOptionalTimestamp(value["ends_at"]);
     return subscription;
 }
 
@@ -1,11 +1,19 @@
 #pragma once
 
 #include <paddle/types/formats.hpp>
+#include <paddle/types/raw_json.hpp>
 
 #include <userver/logging/log_helper.hpp>
 #include <userver/storages/postgres/io/enum_types.hpp>
 #include <userver/utils/trivial_map.hpp>
 
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
 namespace paddle {
 
 enum class CatalogType {
@@ -366,11 +374,114 @@ Format SerializeEnum(const Enum& enum_value, userver::formats::serialize::To<For
     return builder.ExtractValue();
 }
 
+namespace impl {
+
+template <typename Enum>
+inline constexpr const auto& kEnumerators = userver::storages::postgres::io::CppToUserPg<Enum>::enumerators;
+
+template <typename Enum>
+concept HasUnknownEnumerator = requires { Enum::kUnknown; };
+
+template <typename Enum>
+struct EnumLiteral {
+    std::string_view literal;
+    Enum value;
+};
+
+template <typename Enum>
+constexpr auto CountEnumValues() -> std::size_t {
+    std::size_t count = 0;
+    while (kEnumerators<Enum>.TryFindBySecond(static_cast<Enum>(count))) {
+        ++count;
+    }
+    return count;
+}
+
+template <typename Enum>
+inline constexpr std::size_t kEnumValueCount = CountEnumValues<Enum>();
+
+/// Literals of the enum sorted by length
+template <typename Enum>
+constexpr auto MakeEnumLiterals() {
+    static_assert(
+        kEnumValueCount<Enum> > 0 && kEnumValueCount<Enum> == kEnumerators<Enum>.size(),
+        "The enumerators must cover the enum values from zero without gaps"
+    );
+    std::array<EnumLiteral<Enum>, kEnumValueCount<Enum>> literals{};
+    for (std::size_t i = 0; i < literals.size(); ++i) {
+        const auto value = static_cast<Enum>(i);
+        literals[i] = {*kEnumerators<Enum>.TryFindBySecond(value), value};
+    }
+    std::sort(literals.begin(), literals.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.literal.size() < rhs.literal.size();
+    });
+    return literals;
+}
+
+template <typename Enum>
+inline constexpr auto kEnumLiterals = MakeEnumLiterals<Enum>();
+
+/// Literals of length `n` are `kEnumLiterals[buckets[n]..buckets[n + 1])`
+template <typename Enum>
+constexpr auto MakeLengthBuckets() {
+    constexpr auto& literals = kEnumLiterals<Enum>;
+    std::array<std::size_t, literals.back().literal.size() + 2> buckets{};
+    std::size_t index = 0;
+    for (std::size_t length = 0; length < buckets.size(); ++length) {
+        buckets[length] = index;
+        while (index < literals.size() && literals[index].literal.size() == length) {
+            ++index;
+        }
+    }
+    return buckets;
+}
+
+template <typename Enum>
+inline constexpr auto kLengthBuckets = MakeLengthBuckets<Enum>();
+
+/// @brief Find the enumerator by its literal, comparing only the literals of the same length
+template <typename Enum>
+constexpr auto FindEnumerator(std::string_view literal) -> std::optional<Enum> {
+    constexpr auto& buckets = kLengthBuckets<Enum>;
+    if (literal.size() + 1 >= buckets.size()) {
+        return std::nullopt;
+    }
+    for (auto i = buckets[literal.size()]; i < buckets[literal.size() + 1]; ++i) {
+        if (kEnumLiterals<Enum>[i].literal == literal) {
+            return kEnumLiterals<Enum>[i].value;
+        }
+    }
+    return std::nullopt;
+}
+
+template <typename Enum>
+auto ParseEnumLiteral(std::string_view literal) -> Enum {
+    if (auto enum_value = FindEnumerator<Enum>(literal)) {
+        return *enum_value;
+    }
+    if constexpr (HasUnknownEnumerator<Enum>) {
+        return Enum::kUnknown;
+    } else {
+        // Throws the postgres mapping error for the literal
+        using EnumMap = userver::storages::postgres::io::detail::EnumerationMap<Enum>;
+        return EnumMap::GetEnumerator(literal);
+    }
+}
+
+}  // namespace impl
+
+/// @brief Parse an enum from its `CppToUserPg` literal
+///
+/// Values Paddle added after this enum was written are parsed as `kUnknown`
+/// if the enum has one, other enums throw. The on-demand backend matches the
+/// string in place, the DOM copies it first.
 template <typename Enum, typename Value>
 Enum ParseEnum(const Value& value, userver::formats::parse::To<Enum>) {
-    using EnumMap = userver::storages::postgres::io::detail::EnumerationMap<Enum>;
-    auto enum_value = value.template As<std::string>();
-    return EnumMap::GetEnumerator(enum_value);
+    if constexpr (std::is_same_v<Value, raw_json::Value>) {
+        return impl::ParseEnumLiteral<Enum>(value.template As<std::string_view>());
+    } else {
+        return impl::ParseEnumLiteral<Enum>(value.template As<std::string>());
+    }
 }
 
 template <typename Enum>
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <paddle/types/events.hpp>
+#include <paddle/types/timestamp.hpp>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace paddle::events {
+
+/// @brief Selection of events to fetch or replay
+///
+/// Event types are passed to the Paddle API, the time range and the entity
+/// ids are checked locally. The time range is also used to skip the pages
+/// outside of it: event ids are ULIDs, so a cursor can be built from a time
+/// point and the listing can stop at the first event past the range.
+struct EventQuery {
+    /// Event types to select, all by default
+    std::vector<EventTypeName> event_types;
+    /// Select events that occurred at or after this time point
+    std::optional<Timestamp> occurred_after;
+    /// Select events that occurred before this time point
+    std::optional<Timestamp> occurred_before;
+    /// Select events of these entities (`data.id`), all by default
+    std::vector<std::string> entity_ids;
+
+    /// @brief No conditions, every event is selected
+    [[nodiscard]] auto IsEmpty() const -> bool;
+    /// @brief Check the conditions that the Paddle API doesn't support
+    [[nodiscard]] auto Matches(const Event<JSON>& event) const -> bool;
+    /// @brief Event is past the time range, as are all the events with greater ids
+    [[nodiscard]] auto IsPastRange(const Event<JSON>& event) const -> bool;
+    /// @brief Cursor to start listing from, skips the events before the time range
+    [[nodiscard]] auto GetStartCursor(std::string_view cursor) const -> std::string;
+    /// @brief Query string parameters for the events API, empty or starting with `&`
+    [[nodiscard]] auto GetQueryParameters() const -> std::string;
+};
+
+/// @brief Event types matching the name or a `prefix.*` wildcard
+/// @throws std::runtime_error if nothing matches
+auto ExpandEventTypes(std::string_view pattern) -> std::vector<EventTypeName>;
+
+/// @brief Smallest event id created at the time point, usable as a cursor
+auto MakeEventCursor(Timestamp time_point) -> std::string;
+
+}  // namespace paddle::events
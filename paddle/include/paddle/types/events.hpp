@@ -1,5 +1,6 @@
 #pragma once
 
+#include <paddle/types/changes.hpp>
 #include <paddle/types/enums.hpp>
 #include <paddle/types/ids.hpp>
 #include <paddle/types/timestamp.hpp>
@@ -83,6 +84,9 @@ enum class EventTypeName {
     kTransactionUpdated,
 };
 
+/// @brief Number of the EventTypeName values, they are numbered from zero without gaps
+inline constexpr auto kEventTypeNameCount = static_cast<std::size_t>(EventTypeName::kTransactionUpdated) + 1;
+
 enum class EventCategory {
     kAddress,
     kAdjustment,
@@ -104,6 +108,9 @@ enum class EventCategory {
 
 EventCategory GetEventCategory(EventTypeName event_type);
 
+/// @brief Event reports a change of an existing entity (`*.updated`)
+bool IsUpdatedEvent(EventTypeName event_type);
+
 enum class TrafficSource {
     kPlatform,
     kSimulation,
@@ -124,6 +131,17 @@ struct Event {
     EventTypeName event_type;
     Timestamp occurred_at;
     T data;
+    /// Fields changed since the last seen snapshot of the entity, not serialized
+    Changes changes{};
+};
+
+/// @brief Event envelope along with the JSON it was parsed from
+///
+/// The JSON shares the parsed document, so that the original event can be
+/// passed on to the handlers without serializing the envelope back.
+struct RawEvent {
+    JSON json;
+    Event<JSON> event;
 };
 
 template <typename T = JSON>
@@ -156,7 +174,8 @@ Event<T> ParsePayload(Event<JSON>&& event) {
         std::move(event.event_id),
         std::move(event.event_type),
         std::move(event.occurred_at),
-        event.data.template As<T>()
+        event.data.template As<T>(),
+        std::move(event.changes)
     };
 }
 
@@ -354,11 +373,23 @@ Event<T> Parse(const Value& value, userver::formats::parse::To<Event<T>>) {
     Event<T> event;
     event.event_id = value["event_id"].template As<EventId>();
     event.event_type = value["event_type"].template As<EventTypeName>();
-    event.occurred_at = value["occurred_at"].template As<Timestamp>();
+    event.occurred_at = ParseTimestamp(value["occurred_at"]);
     event.data = value["data"].template As<T>();
     return event;
 }
 
+// RawEvent
+template <typename Format>
+Format Serialize(const RawEvent& event, userver::formats::serialize::To<Format>) {
+    return event.json;
+}
+
+template <typename Value>
+RawEvent Parse(const Value& value, userver::formats::parse::To<RawEvent>) {
+    auto json = value.template As<JSON>();
+    return RawEvent{json, json.template As<Event<JSON>>()};
+}
+
 // EventWithNotification
 template <typename Format, typename T>
 Format Serialize(const EventWithNotification<T>& event, userver::formats::serialize::To<Format>) {
@@ -376,7 +407,7 @@ EventWithNotification<T> Parse(const Value& value, userver::formats::parse::To<E
     EventWithNotification<T> event;
     event.event_id = value["event_id"].template As<EventId>();
     event.event_type = value["event_type"].template As<EventTypeName>();
-    event.occurred_at = value["occurred_at"].template As<Timestamp>();
+    event.occurred_at = ParseTimestamp(value["occurred_at"]);
     event.notification_id = value["notification_id"].template As<NotificationId>();
     event.data = value["data"].template As<T>();
     return event;
@@ -32,10 +32,12 @@ struct Business;
 
 namespace subscriptions {
 struct Subscription;
+class SubscriptionView;
 }  // namespace subscriptions
 
 namespace transactions {
 struct Transaction;
+class TransactionView;
 }
 
 namespace events {
@@ -44,6 +46,9 @@ struct EventWithNotification;
 
 template <typename T>
 struct Event;
+
+struct RawEvent;
+struct EventQuery;
 }  // namespace events
 
 namespace api_keys {
@@ -55,5 +60,7 @@ struct ClientToken;
 }  // namespace client_tokens
 
 struct NotificationSetting;
+struct Notification;
+struct NotificationQuery;
 
 }  // namespace paddle
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <paddle/types/paddle_id.hpp>
+
 #include <userver/utils/strong_typedef.hpp>
 
 #include <boost/uuid/uuid.hpp>
@@ -8,50 +10,50 @@ namespace paddle {
 
 using RequestId = userver::utils::StrongTypedef<struct RequestIdTag, boost::uuids::uuid>;
 
-using ProductId = userver::utils::StrongTypedef<struct ProductIdTag, std::string>;
+using ProductId = PaddleId<struct ProductIdTag>;
 using OptionalProductId = std::optional<ProductId>;
 
-using PriceId = userver::utils::StrongTypedef<struct PriceIdTag, std::string>;
+using PriceId = PaddleId<struct PriceIdTag>;
 using OptionalPriceId = std::optional<PriceId>;
 
-using DiscountId = userver::utils::StrongTypedef<struct DiscountIdTag, std::string>;
+using DiscountId = PaddleId<struct DiscountIdTag>;
 using OptionalDiscountId = std::optional<DiscountId>;
 
-using TransactionId = userver::utils::StrongTypedef<struct TransactionIdTag, std::string>;
+using TransactionId = PaddleId<struct TransactionIdTag>;
 using OptionalTransactionId = std::optional<TransactionId>;
 
-using TransactionItemId = userver::utils::StrongTypedef<struct TransactionItemIdTag, std::string>;
+using TransactionItemId = PaddleId<struct TransactionItemIdTag>;
 using OptionalTransactionItemId = std::optional<TransactionItemId>;
 
 using PaymentAttemptId = userver::utils::StrongTypedef<struct PaymentAttemptIdTag, boost::uuids::uuid>;
 using OptionalPaymentAttemptId = std::optional<PaymentAttemptId>;
 
-using SubscriptionId = userver::utils::StrongTypedef<struct SubscriptionIdTag, std::string>;
+using SubscriptionId = PaddleId<struct SubscriptionIdTag>;
 using OptionalSubscriptionId = std::optional<SubscriptionId>;
 
-using CustomerId = userver::utils::StrongTypedef<struct CustomerIdTag, std::string>;
+using CustomerId = PaddleId<struct CustomerIdTag>;
 using OptionalCustomerId = std::optional<CustomerId>;
 
 using Email = userver::utils::StrongTypedef<struct EmailTag, std::string>;
 using OptionalEmail = std::optional<Email>;
 
-using PaymentMethodId = userver::utils::StrongTypedef<struct PaymentMethodIdTag, std::string>;
+using PaymentMethodId = PaddleId<struct PaymentMethodIdTag>;
 using OptionalPaymentMethodId = std::optional<PaymentMethodId>;
 
-using AddressId = userver::utils::StrongTypedef<struct AddressIdTag, std::string>;
+using AddressId = PaddleId<struct AddressIdTag>;
 using OptionalAddressId = std::optional<AddressId>;
 
-using BusinessId = userver::utils::StrongTypedef<struct BusinessIdTag, std::string>;
+using BusinessId = PaddleId<struct BusinessIdTag>;
 using OptionalBusinessId = std::optional<BusinessId>;
 
 using DocumentNumber = userver::utils::StrongTypedef<struct DocumentNumberTag, std::string>;
 using OptionalDocumentNumber = std::optional<DocumentNumber>;
 
-using NotificationSettingId = userver::utils::StrongTypedef<struct NotificationSettingIdTag, std::string>;
-using ClientTokenId = userver::utils::StrongTypedef<struct ClientTokenIdTag, std::string>;
-using ApiKeyId = userver::utils::StrongTypedef<struct ApiKeyIdTag, std::string>;
+using NotificationSettingId = PaddleId<struct NotificationSettingIdTag>;
+using ClientTokenId = PaddleId<struct ClientTokenIdTag>;
+using ApiKeyId = PaddleId<struct ApiKeyIdTag>;
 
-using EventId = userver::utils::StrongTypedef<struct EventIdTag, std::string>;
-using NotificationId = userver::utils::StrongTypedef<struct NotificationIdTag, std::string>;
+using EventId = PaddleId<struct EventIdTag>;
+using NotificationId = PaddleId<struct NotificationIdTag>;
 
 }  // namespace paddle
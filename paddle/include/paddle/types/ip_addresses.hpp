@@ -0,0 +1,34 @@
+#pragma once
+
+#include <paddle/types/formats.hpp>
+
+#include <string>
+#include <vector>
+
+namespace paddle {
+
+/// @brief IP addresses Paddle sends webhooks from
+struct IpAddresses {
+    std::vector<std::string> ipv4_cidrs;
+};
+
+}  // namespace paddle
+
+namespace paddle {
+
+// IpAddresses
+template <typename Format>
+auto Serialize(const IpAddresses& addresses, userver::formats::serialize::To<Format>) -> Format {
+    typename Format::Builder builder;
+    builder["ipv4_cidrs"] = addresses.ipv4_cidrs;
+    return builder.ExtractValue();
+}
+
+template <typename Value>
+auto Parse(const Value& value, userver::formats::parse::To<IpAddresses>) -> IpAddresses {
+    IpAddresses addresses;
+    addresses.ipv4_cidrs = value["ipv4_cidrs"].template As<std::vector<std::string>>();
+    return addresses;
+}
+
+}  // namespace paddle
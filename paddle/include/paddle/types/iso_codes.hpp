@@ -0,0 +1,318 @@
+#pragma once
+
+#include <paddle/types/formats.hpp>
+#include <paddle/types/raw_json.hpp>
+
+#include <userver/logging/log_helper.hpp>
+#include <userver/storages/postgres/io/buffer_io.hpp>
+#include <userver/storages/postgres/io/string_types.hpp>
+#include <userver/storages/postgres/io/type_mapping.hpp>
+
+#include <fmt/format.h>
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace paddle::impl {
+
+/// Upper case ASCII letters, lower case ones are folded, nullopt for anything else
+template <std::size_t Size>
+constexpr auto TryParseLetters(std::string_view text) -> std::optional<std::array<char, Size>> {
+    if (text.size() != Size) {
+        return std::nullopt;
+    }
+    std::array<char, Size> letters{};
+    for (std::size_t index = 0; index < Size; ++index) {
+        auto c = text[index];
+        if (c >= 'a' && c <= 'z') {
+            c = static_cast<char>(c - 'a' + 'A');
+        }
+        if (c < 'A' || c > 'Z') {
+            return std::nullopt;
+        }
+        letters[index] = c;
+    }
+    return letters;
+}
+
+struct CurrencyMinorUnits {
+    std::string_view code;
+    std::uint8_t minor_units;
+};
+
+/// ISO 4217 currencies whose minor unit is not a hundredth, sorted by code
+inline constexpr std::array<CurrencyMinorUnits, 26> kCurrencyMinorUnits{{
+    {"BHD", 3}, {"BIF", 0}, {"CLF", 4}, {"CLP", 0}, {"DJF", 0}, {"GNF", 0}, {"IQD", 3},
+    {"ISK", 0}, {"JOD", 3}, {"JPY", 0}, {"KMF", 0}, {"KRW", 0}, {"KWD", 3}, {"LYD", 3},
+    {"OMR", 3}, {"PYG", 0}, {"RWF", 0}, {"TND", 3}, {"UGX", 0}, {"UYI", 0}, {"UYW", 4},
+    {"VND", 0}, {"VUV", 0}, {"XAF", 0}, {"XOF", 0}, {"XPF", 0},
+}};
+
+inline constexpr std::uint8_t kDefaultMinorUnits = 2;
+
+constexpr auto FindMinorUnits(std::string_view code) -> std::uint8_t {
+    for (const auto& currency : kCurrencyMinorUnits) {
+        if (currency.code == code) {
+            return currency.minor_units;
+        }
+    }
+    return kDefaultMinorUnits;
+}
+
+[[noreturn]] void ThrowInvalidCurrencyCode(std::string_view text);
+[[noreturn]] void ThrowInvalidCountryCode(std::string_view text);
+
+}  // namespace paddle::impl
+
+namespace paddle::money {
+
+/// @brief ISO 4217 currency code, e.g. `USD`
+///
+/// Three letters kept inline with the number of minor units of the currency,
+/// so the code is 4 bytes, trivially copyable, and Money can be scaled without
+/// a lookup. Codes missing from the minor units table are accepted and scaled
+/// by a hundredth, as most currencies are. Lower case text is folded to upper
+/// case. A default constructed code is empty and formats as an empty string.
+class CurrencyCode {
+public:
+    static constexpr std::size_t kSize = 3;
+
+    constexpr CurrencyCode() = default;
+    /// @throws std::invalid_argument unless the text is three letters
+    constexpr explicit CurrencyCode(std::string_view text) {
+        if (auto code = TryParse(text)) {
+            *this = *code;
+        } else {
+            impl::ThrowInvalidCurrencyCode(text);
+        }
+    }
+
+    static constexpr auto TryParse(std::string_view text) -> std::optional<CurrencyCode> {
+        if (auto letters = impl::TryParseLetters<kSize>(text)) {
+            return CurrencyCode{*letters};
+        }
+        return std::nullopt;
+    }
+
+    [[nodiscard]] constexpr auto IsEmpty() const -> bool {
+        return code_[0] == '\0';
+    }
+
+    [[nodiscard]] constexpr auto GetView() const -> std::string_view {
+        return IsEmpty() ? std::string_view{} : std::string_view{code_.data(), kSize};
+    }
+
+    [[nodiscard]] auto ToString() const -> std::string {
+        return std::string{GetView()};
+    }
+
+    /// @brief Decimal digits of the minor unit, 2 for cents, 0 for JPY
+    [[nodiscard]] constexpr auto GetMinorUnits() const -> int {
+        return minor_units_;
+    }
+
+    /// @brief Minor units in a major one, 100 for cents, 1 for JPY
+    [[nodiscard]] constexpr auto GetScale() const -> std::int64_t {
+        std::int64_t scale = 1;
+        for (int digit = 0; digit < minor_units_; ++digit) {
+            scale *= 10;
+        }
+        return scale;
+    }
+
+    constexpr auto operator<=>(const CurrencyCode&) const = default;
+
+private:
+    constexpr explicit CurrencyCode(const std::array<char, kSize>& letters)
+        : code_{letters}, minor_units_{impl::FindMinorUnits({letters.data(), kSize})} {}
+
+    std::array<char, kSize> code_{};
+    std::uint8_t minor_units_ = 0;
+};
+
+template <typename Format>
+Format Serialize(const CurrencyCode& code, userver::formats::serialize::To<Format>) {
+    typename Format::Builder builder(code.ToString());
+    return builder.ExtractValue();
+}
+
+template <typename Value>
+CurrencyCode Parse(const Value& value, userver::formats::parse::To<CurrencyCode>) {
+    if constexpr (std::is_same_v<Value, raw_json::Value>) {
+        return CurrencyCode{value.template As<std::string_view>()};
+    } else {
+        return CurrencyCode{value.template As<std::string>()};
+    }
+}
+
+inline userver::logging::LogHelper& operator<<(userver::logging::LogHelper& helper, const CurrencyCode& code) {
+    helper << code.GetView();
+    return helper;
+}
+
+}  // namespace paddle::money
+
+namespace paddle::prices {
+
+/// @brief ISO 3166-1 alpha-2 country code, e.g. `DE`
+///
+/// Two letters kept inline. Lower case text is folded to upper case. A default
+/// constructed code is empty and formats as an empty string.
+class CountryCode {
+public:
+    static constexpr std::size_t kSize = 2;
+
+    constexpr CountryCode() = default;
+    /// @throws std::invalid_argument unless the text is two letters
+    constexpr explicit CountryCode(std::string_view text) {
+        if (auto code = TryParse(text)) {
+            *this = *code;
+        } else {
+            impl::ThrowInvalidCountryCode(text);
+        }
+    }
+
+    static constexpr auto TryParse(std::string_view text) -> std::optional<CountryCode> {
+        if (auto letters = impl::TryParseLetters<kSize>(text)) {
+            return CountryCode{*letters};
+        }
+        return std::nullopt;
+    }
+
+    [[nodiscard]] constexpr auto IsEmpty() const -> bool {
+        return code_[0] == '\0';
+    }
+
+    [[nodiscard]] constexpr auto GetView() const -> std::string_view {
+        return IsEmpty() ? std::string_view{} : std::string_view{code_.data(), kSize};
+    }
+
+    [[nodiscard]] auto ToString() const -> std::string {
+        return std::string{GetView()};
+    }
+
+    constexpr auto operator<=>(const CountryCode&) const = default;
+
+private:
+    constexpr explicit CountryCode(const std::array<char, kSize>& letters) : code_{letters} {}
+
+    std::array<char, kSize> code_{};
+};
+
+template <typename Format>
+Format Serialize(const CountryCode& code, userver::formats::serialize::To<Format>) {
+    typename Format::Builder builder(code.ToString());
+    return builder.ExtractValue();
+}
+
+template <typename Value>
+CountryCode Parse(const Value& value, userver::formats::parse::To<CountryCode>) {
+    if constexpr (std::is_same_v<Value, raw_json::Value>) {
+        return CountryCode{value.template As<std::string_view>()};
+    } else {
+        return CountryCode{value.template As<std::string>()};
+    }
+}
+
+inline userver::logging::LogHelper& operator<<(userver::logging::LogHelper& helper, const CountryCode& code) {
+    helper << code.GetView();
+    return helper;
+}
+
+}  // namespace paddle::prices
+
+template <>
+struct std::hash<paddle::money::CurrencyCode> {
+    auto operator()(const paddle::money::CurrencyCode& code) const noexcept -> std::size_t {
+        return std::hash<std::string_view>{}(code.GetView());
+    }
+};
+
+template <>
+struct std::hash<paddle::prices::CountryCode> {
+    auto operator()(const paddle::prices::CountryCode& code) const noexcept -> std::size_t {
+        return std::hash<std::string_view>{}(code.GetView());
+    }
+};
+
+template <>
+struct fmt::formatter<paddle::money::CurrencyCode> : fmt::formatter<std::string_view> {
+    template <typename FormatContext>
+    auto format(const paddle::money::CurrencyCode& code, FormatContext& ctx) const {
+        return fmt::formatter<std::string_view>::format(code.GetView(), ctx);
+    }
+};
+
+template <>
+struct fmt::formatter<paddle::prices::CountryCode> : fmt::formatter<std::string_view> {
+    template <typename FormatContext>
+    auto format(const paddle::prices::CountryCode& code, FormatContext& ctx) const {
+        return fmt::formatter<std::string_view>::format(code.GetView(), ctx);
+    }
+};
+
+namespace userver::storages::postgres::io {
+
+/// Currency and country codes are stored as text
+template <>
+struct BufferFormatter<paddle::money::CurrencyCode> {
+    const paddle::money::CurrencyCode& value;
+
+    explicit BufferFormatter(const paddle::money::CurrencyCode& code) : value{code} {}
+
+    template <typename Buffer>
+    void operator()(const UserTypes& types, Buffer& buffer) const {
+        io::WriteBuffer(types, buffer, value.ToString());
+    }
+};
+
+template <>
+struct BufferParser<paddle::money::CurrencyCode> : detail::BufferParserBase<paddle::money::CurrencyCode> {
+    using BaseType = detail::BufferParserBase<paddle::money::CurrencyCode>;
+    using BaseType::BaseType;
+
+    void operator()(const FieldBuffer& buffer) {
+        std::string text;
+        io::ReadBuffer(buffer, text);
+        this->value = paddle::money::CurrencyCode{text};
+    }
+};
+
+template <>
+struct CppToSystemPg<paddle::money::CurrencyCode> : PredefinedOid<PredefinedOids::kText> {};
+
+template <>
+struct BufferFormatter<paddle::prices::CountryCode> {
+    const paddle::prices::CountryCode& value;
+
+    explicit BufferFormatter(const paddle::prices::CountryCode& code) : value{code} {}
+
+    template <typename Buffer>
+    void operator()(const UserTypes& types, Buffer& buffer) const {
+        io::WriteBuffer(types, buffer, value.ToString());
+    }
+};
+
+template <>
+struct BufferParser<paddle::prices::CountryCode> : detail::BufferParserBase<paddle::prices::CountryCode> {
+    using BaseType = detail::BufferParserBase<paddle::prices::CountryCode>;
+    using BaseType::BaseType;
+
+    void operator()(const FieldBuffer& buffer) {
+        std::string text;
+        io::ReadBuffer(buffer, text);
+        this->value = paddle::prices::CountryCode{text};
+    }
+};
+
+template <>
+struct CppToSystemPg<paddle::prices::CountryCode> : PredefinedOid<PredefinedOids::kText> {};
+
+}  // namespace userver::storages::postgres::io
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <optional>
+#include <utility>
+
+namespace paddle {
+
+/// @brief Field decoded on the first access and cached afterwards
+///
+/// Not thread safe, meant for the views owned by a single handler call.
+template <typename T>
+class LazyField {
+public:
+    template <typename Decoder>
+    auto Get(Decoder&& decoder) const -> const T& {
+        if (!value_) {
+            value_.emplace(std::forward<Decoder>(decoder)());
+        }
+        return *value_;
+    }
+
+    [[nodiscard]] auto IsDecoded() const -> bool {
+        return value_.has_value();
+    }
+
+private:
+    mutable std::optional<T> value_;
+};
+
+}  // namespace paddle
@@ -1,18 +1,22 @@
 #pragma once
 
 #include <paddle/types/formats.hpp>
+#include <paddle/types/iso_codes.hpp>
+#include <paddle/types/numeric.hpp>
 
 #include <cstdint>
 #include <string>
 
 namespace paddle::money {
 
-using CurrencyCode = userver::utils::StrongTypedef<struct CurrencyCodeTag, std::string>;
-
 struct Money {
-    std::int32_t amount;
+    /// In the lowest denomination of the currency
+    std::int64_t amount;
     CurrencyCode currency_code;
 
+    /// @brief The amount in major units, e.g. `12.34` for 1234 USD cents or `1234` for JPY
+    [[nodiscard]] auto ToDecimalString() const -> std::string;
+
     bool operator==(const Money& other) const {
         return amount == other.amount && currency_code == other.currency_code;
     }
@@ -37,7 +41,7 @@ Format Serialize(const Money& money, userver::formats::serialize::To<Format>) {
 template <typename Value>
 Money Parse(const Value& value, userver::formats::parse::To<Money>) {
     Money money;
-    money.amount = std::stoi(value["amount"].template As<std::string>());
+    money.amount = ParseAmount(value["amount"]);
     money.currency_code = value["currency_code"].template As<CurrencyCode>();
     return money;
 }
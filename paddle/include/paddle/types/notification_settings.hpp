@@ -24,6 +24,32 @@ struct NotificationSetting {
 
 using NotificationSettingsResponse = Response<NotificationSetting, MetaPaginated>;
 
+/// @brief Fields of a notification setting to change, only the event subscription for now
+struct NotificationSettingUpdate {
+    std::vector<events::EventTypeName> subscribed_events;
+};
+
+/// @brief Difference between the events a notification setting is subscribed to and the handled ones
+struct SubscriptionDiff {
+    NotificationSettingId id;
+    /// Subscribed events no handler is configured for
+    std::vector<events::EventTypeName> unhandled;
+    /// Handled events the setting is not subscribed to
+    std::vector<events::EventTypeName> missing;
+
+    [[nodiscard]] auto IsEmpty() const -> bool {
+        return unhandled.empty() && missing.empty();
+    }
+};
+
+/// @param handled event types the configured handlers process
+auto DiffSubscription(const NotificationSetting& setting, const std::vector<events::EventTypeName>& handled)
+    -> SubscriptionDiff;
+
+/// @brief Subscribed events of the setting without the unhandled ones, in the subscription order
+auto NarrowSubscription(const NotificationSetting& setting, const SubscriptionDiff& diff)
+    -> NotificationSettingUpdate;
+
 }  // namespace paddle
 
 namespace paddle {
@@ -61,4 +87,12 @@ NotificationSetting Parse(const Value& value, userver::formats::parse::To<Notifi
     return setting;
 }
 
+// NotificationSettingUpdate
+template <typename Format>
+Format Serialize(const NotificationSettingUpdate& update, userver::formats::serialize::To<Format>) {
+    typename Format::Builder builder;
+    builder["subscribed_events"] = update.subscribed_events;
+    return builder.ExtractValue();
+}
+
 }  // namespace paddle
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <paddle/types/enums.hpp>
+#include <paddle/types/formats.hpp>
+#include <paddle/types/ids.hpp>
+#include <paddle/types/timestamp.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace paddle {
+
+enum class NotificationStatus {
+    kNotAttempted,
+    kNeedsRetry,
+    kDelivered,
+    kFailed,
+};
+
+enum class NotificationOrigin {
+    kEvent,
+    kReplay,
+};
+
+/// @brief Delivery of an event to a notification destination
+struct Notification {
+    NotificationId id;
+    /// Event type name
+    std::string type;
+    NotificationStatus status;
+    /// The event with its notification_id, as it is delivered to the destination
+    JSON payload;
+    Timestamp occurred_at;
+    OptionalTimestamp delivered_at;
+    OptionalTimestamp replayed_at;
+    NotificationOrigin origin;
+    OptionalTimestamp last_attempt_at;
+    OptionalTimestamp retry_at;
+    std::int32_t times_attempted;
+    NotificationSettingId notification_setting_id;
+};
+
+/// @brief Selection of notifications to list
+struct NotificationQuery {
+    /// All statuses by default
+    std::vector<NotificationStatus> statuses;
+    std::optional<NotificationSettingId> notification_setting_id;
+    /// Notifications that occurred at or after this time point
+    OptionalTimestamp from;
+    /// Notifications that occurred before this time point
+    OptionalTimestamp to;
+
+    /// @brief Query string parameters for the notifications API, empty or starting with `&`
+    [[nodiscard]] auto GetQueryParameters() const -> std::string;
+};
+
+}  // namespace paddle
+
+// NotificationStatus
+template <>
+struct userver::storages::postgres::io::CppToUserPg<paddle::NotificationStatus>
+    : EnumMappingBase<paddle::NotificationStatus> {
+    static constexpr DBTypeName postgres_name = "paddle.notification_status";
+    static constexpr userver::utils::TrivialBiMap enumerators = [](auto selector) {
+        return selector()
+            .Case("not_attempted", EnumType::kNotAttempted)
+            .Case("needs_retry", EnumType::kNeedsRetry)
+            .Case("delivered", EnumType::kDelivered)
+            .Case("failed", EnumType::kFailed);
+    };
+};
+
+// NotificationOrigin
+template <>
+struct userver::storages::postgres::io::CppToUserPg<paddle::NotificationOrigin>
+    : EnumMappingBase<paddle::NotificationOrigin> {
+    static constexpr DBTypeName postgres_name = "paddle.notification_origin";
+    static constexpr userver::utils::TrivialBiMap enumerators = [](auto selector) {
+        return selector().Case("event", EnumType::kEvent).Case("replay", EnumType::kReplay);
+    };
+};
+
+namespace paddle {
+
+// NotificationStatus
+template <typename Format>
+Format Serialize(const NotificationStatus& status, userver::formats::serialize::To<Format> to) {
+    return SerializeEnum(status, to);
+}
+
+template <typename Value>
+NotificationStatus Parse(const Value& value, userver::formats::parse::To<NotificationStatus> to) {
+    return ParseEnum(value, to);
+}
+
+// NotificationOrigin
+template <typename Format>
+Format Serialize(const NotificationOrigin& origin, userver::formats::serialize::To<Format> to) {
+    return SerializeEnum(origin, to);
+}
+
+template <typename Value>
+NotificationOrigin Parse(const Value& value, userver::formats::parse::To<NotificationOrigin> to) {
+    return ParseEnum(value, to);
+}
+
+// Notification
+template <typename Format>
+Format Serialize(const Notification& notification, userver::formats::serialize::To<Format>) {
+    typename Format::Builder builder;
+    builder["id"] = notification.id;
+    builder["type"] = notification.type;
+    builder["status"] = notification.status;
+    builder["payload"] = notification.payload;
+    builder["occurred_at"] = notification.occurred_at;
+    builder["delivered_at"] = notification.delivered_at;
+    builder["replayed_at"] = notification.replayed_at;
+    builder["origin"] = notification.origin;
+    builder["last_attempt_at"] = notification.last_attempt_at;
+    builder["retry_at"] = notification.retry_at;
+    builder["times_attempted"] = notification.times_attempted;
+    builder["notification_setting_id"] = notification.notification_setting_id;
+    return builder.ExtractValue();
+}
+
+template <typename Value>
+Notification Parse(const Value& value, userver::formats::parse::To<Notification>) {
+    Notification notification;
+    notification.id = value["id"].template As<NotificationId>();
+    notification.type = value["type"].template As<std::string>();
+    notification.status = value["status"].template As<NotificationStatus>();
+    notification.payload = value["payload"].template As<JSON>();
+    notification.occurred_at = ParseTimestamp(value["occurred_at"]);
+    notification.delivered_at = ParseOptionalTimestamp(value["delivered_at"]);
+    notification.replayed_at = ParseOptionalTimestamp(value["replayed_at"]);
+    notification.origin = value["origin"].template As<NotificationOrigin>();
+    notification.last_attempt_at = ParseOptionalTimestamp(value["last_attempt_at"]);
+    notification.retry_at = ParseOptionalTimestamp(value["retry_at"]);
+    notification.times_attempted = value["times_attempted"].template As<std::int32_t>(0);
+    notification.notification_setting_id = value["notification_setting_id"].template As<NotificationSettingId>();
+    return notification;
+}
+
+}  // namespace paddle
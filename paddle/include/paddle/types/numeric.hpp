@@ -0,0 +1,30 @@
+#pragma once
+
+#include <paddle/types/raw_json.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace paddle {
+
+/// @brief Parse a decimal integer, e.g. an amount Paddle sends as a JSON string
+/// @throws std::invalid_argument unless the whole text is an optionally negative
+/// decimal integer without leading zeros that fits into std::int64_t
+auto ParseInteger(std::string_view text) -> std::int64_t;
+
+/// @brief Read an amount in the lowest denomination of the currency, sent as a JSON string
+///
+/// The on-demand backend parses the digits in place. With the DOM the string
+/// is copied first, amounts are short enough to fit the small string buffer.
+template <typename Value>
+auto ParseAmount(const Value& value) -> std::int64_t {
+    if constexpr (std::is_same_v<Value, raw_json::Value>) {
+        return ParseInteger(value.template As<std::string_view>());
+    } else {
+        return ParseInteger(value.template As<std::string>());
+    }
+}
+
+}  // namespace paddle
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <paddle/types/formats.hpp>
+#include <paddle/types/raw_json.hpp>
+
+#include <userver/logging/log_helper.hpp>
+#include <userver/storages/postgres/io/buffer_io.hpp>
+#include <userver/storages/postgres/io/string_types.hpp>
+#include <userver/storages/postgres/io/type_mapping.hpp>
+
+#include <fmt/format.h>
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace paddle {
+
+namespace impl {
+
+/// @brief Prefix and ULID of a Paddle id, see PaddleId
+struct PackedId {
+    static constexpr std::size_t kMaxPrefixSize = 7;
+    static constexpr std::size_t kUlidSize = 26;
+    static constexpr std::size_t kMaxSize = kMaxPrefixSize + 1 + kUlidSize;
+
+    // Declaration order is the comparison order: ULIDs order by time, the way the strings do
+    std::uint64_t ulid_high = 0;
+    std::uint64_t ulid_low = 0;
+    std::array<char, kMaxPrefixSize> prefix{};
+    std::uint8_t prefix_size = 0;
+
+    static auto TryParse(std::string_view text) -> std::optional<PackedId>;
+    /// @throws std::invalid_argument
+    static auto Parse(std::string_view text) -> PackedId;
+
+    /// @return the number of characters written, at most kMaxSize
+    auto Format(char* out) const -> std::size_t;
+    [[nodiscard]] auto ToString() const -> std::string;
+
+    auto operator<=>(const PackedId&) const = default;
+};
+
+}  // namespace impl
+
+/// @brief Paddle entity id, e.g. `txn_01k2jjjx8b9e3zv0k2gk6a3f9y`
+///
+/// Paddle ids are a short lower case prefix and a ULID. The ULID is kept as
+/// a 128-bit number, so the id is 24 bytes, trivially copyable, compares and
+/// hashes as integers, and orders by creation time as the strings do. The ULID
+/// is formatted in lower case, as Paddle sends it. Text that is not a prefix
+/// and a ULID is rejected. A default constructed id is empty and formats as an
+/// empty string.
+template <typename Tag>
+class PaddleId {
+public:
+    static constexpr std::size_t kMaxSize = impl::PackedId::kMaxSize;
+
+    constexpr PaddleId() = default;
+    /// @throws std::invalid_argument if the text is not a Paddle id
+    explicit PaddleId(std::string_view text) : packed_(impl::PackedId::Parse(text)) {}
+
+    static auto TryParse(std::string_view text) -> std::optional<PaddleId> {
+        if (auto packed = impl::PackedId::TryParse(text)) {
+            return PaddleId{*packed};
+        }
+        return std::nullopt;
+    }
+
+    [[nodiscard]] auto IsEmpty() const -> bool {
+        return packed_.prefix_size == 0;
+    }
+
+    [[nodiscard]] auto GetPrefix() const -> std::string_view {
+        return {packed_.prefix.data(), packed_.prefix_size};
+    }
+
+    [[nodiscard]] auto GetPacked() const -> const impl::PackedId& {
+        return packed_;
+    }
+
+    [[nodiscard]] auto ToString() const -> std::string {
+        return packed_.ToString();
+    }
+
+    /// @return the number of characters written, at most kMaxSize
+    auto Format(char* out) const -> std::size_t {
+        return packed_.Format(out);
+    }
+
+    auto operator<=>(const PaddleId&) const = default;
+
+private:
+    explicit PaddleId(const impl::PackedId& packed) : packed_(packed) {}
+
+    impl::PackedId packed_;
+};
+
+template <typename Tag, typename Format>
+Format Serialize(const PaddleId<Tag>& id, userver::formats::serialize::To<Format>) {
+    std::array<char, PaddleId<Tag>::kMaxSize> buffer;
+    typename Format::Builder builder(std::string{buffer.data(), id.Format(buffer.data())});
+    return builder.ExtractValue();
+}
+
+template <typename Value, typename Tag>
+PaddleId<Tag> Parse(const Value& value, userver::formats::parse::To<PaddleId<Tag>>) {
+    if constexpr (std::is_same_v<Value, raw_json::Value>) {
+        return PaddleId<Tag>{value.template As<std::string_view>()};
+    } else {
+        return PaddleId<Tag>{value.template As<std::string>()};
+    }
+}
+
+template <typename Tag>
+userver::logging::LogHelper& operator<<(userver::logging::LogHelper& helper, const PaddleId<Tag>& id) {
+    std::array<char, PaddleId<Tag>::kMaxSize> buffer;
+    helper << std::string_view{buffer.data(), id.Format(buffer.data())};
+    return helper;
+}
+
+}  // namespace paddle
+
+template <typename Tag>
+struct std::hash<paddle::PaddleId<Tag>> {
+    auto operator()(const paddle::PaddleId<Tag>& id) const noexcept -> std::size_t {
+        // The low half is the ULID randomness, the high one the time and the first random bits
+        const auto& packed = id.GetPacked();
+        return static_cast<std::size_t>(packed.ulid_low ^ (packed.ulid_high * 0x9e3779b97f4a7c15ULL));
+    }
+};
+
+template <typename Tag>
+struct fmt::formatter<paddle::PaddleId<Tag>> : fmt::formatter<std::string_view> {
+    template <typename FormatContext>
+    auto format(const paddle::PaddleId<Tag>& id, FormatContext& ctx) const {
+        std::array<char, paddle::PaddleId<Tag>::kMaxSize> buffer;
+        return fmt::formatter<std::string_view>::format(std::string_view{buffer.data(), id.Format(buffer.data())}, ctx);
+    }
+};
+
+namespace userver::storages::postgres::io {
+
+/// Paddle ids are stored as text
+template <typename Tag>
+struct BufferFormatter<paddle::PaddleId<Tag>> {
+    const paddle::PaddleId<Tag>& value;
+
+    explicit BufferFormatter(const paddle::PaddleId<Tag>& id) : value{id} {}
+
+    template <typename Buffer>
+    void operator()(const UserTypes& types, Buffer& buffer) const {
+        io::WriteBuffer(types, buffer, value.ToString());
+    }
+};
+
+template <typename Tag>
+struct BufferParser<paddle::PaddleId<Tag>> : detail::BufferParserBase<paddle::PaddleId<Tag>> {
+    using BaseType = detail::BufferParserBase<paddle::PaddleId<Tag>>;
+    using BaseType::BaseType;
+
+    void operator()(const FieldBuffer& buffer) {
+        std::string text;
+        io::ReadBuffer(buffer, text);
+        this->value = paddle::PaddleId<Tag>{text};
+    }
+};
+
+template <typename Tag>
+struct CppToSystemPg<paddle::PaddleId<Tag>> : PredefinedOid<PredefinedOids::kText> {};
+
+}  // namespace userver::storages::postgres::io
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <paddle/types/formats.hpp>
+
+#ifdef USERVER_PADDLE_ONDEMAND_JSON
+#include <paddle/types/raw_json.hpp>
+#else
+#include <userver/formats/json/serialize.hpp>
+#endif
+
+#include <string_view>
+
+namespace paddle {
+
+/// @brief Parse a Paddle API payload with the backend chosen at build time
+///
+/// The DOM backend builds a `formats::json::Value` first, the on-demand one
+/// (`USERVER_PADDLE_JSON_BACKEND=ondemand`) reads the fields straight from the text.
+template <typename T>
+auto ParseJson(std::string_view json) -> T {
+#ifdef USERVER_PADDLE_ONDEMAND_JSON
+    return raw_json::ParseAs<T>(json);
+#else
+    return userver::formats::json::FromString(json).template As<T>();
+#endif
+}
+
+}  // namespace paddle
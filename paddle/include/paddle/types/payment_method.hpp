@@ -150,8 +150,8 @@ PaymentMethodEventPayload Parse(const Value& value, userver::formats::parse::To<
     payment_method_event_payload.address_id = value["address_id"].template As<AddressId>();
     payment_method_event_payload.type = value["type"].template As<PaymentMethodType>();
     payment_method_event_payload.origin = value["origin"].template As<PaymentMethodOrigin>();
-    payment_method_event_payload.saved_at = value["saved_at"].template As<Timestamp>();
-    payment_method_event_payload.updated_at = value["updated_at"].template As<Timestamp>();
+    payment_method_event_payload.saved_at = ParseTimestamp(value["saved_at"]);
+    payment_method_event_payload.updated_at = ParseTimestamp(value["updated_at"]);
     if (value.HasMember("deletion_reason")) {
         payment_method_event_payload.deletion_reason =
             value["deletion_reason"].template As<PaymentMethodDeletionReason>();
@@ -193,8 +193,8 @@ SavedPaymentMethod Parse(const Value& value, userver::formats::parse::To<SavedPa
     if (value.HasMember("underlying_details")) {
         saved_payment_method.underlying_details = value["underlying_details"].template As<JSON>();
     }
-    saved_payment_method.saved_at = value["saved_at"].template As<Timestamp>();
-    saved_payment_method.updated_at = value["updated_at"].template As<Timestamp>();
+    saved_payment_method.saved_at = ParseTimestamp(value["saved_at"]);
+    saved_payment_method.updated_at = ParseTimestamp(value["updated_at"]);
     return saved_payment_method;
 }
 
@@ -2,14 +2,13 @@
 
 #include <paddle/types/convert.hpp>
 #include <paddle/types/duration.hpp>
+#include <paddle/types/iso_codes.hpp>
 #include <paddle/types/money.hpp>
 #include <paddle/types/response.hpp>
 #include <paddle/types/timestamp.hpp>
 
 namespace paddle::prices {
 
-using CountryCode = userver::utils::StrongTypedef<struct CountryCodeTag, std::string>;
-
 struct PriceOverride {
     std::vector<CountryCode> country_codes;
     money::Money unit_price;
@@ -124,8 +123,8 @@ PriceTemplate<CustomData> Parse(const Value& value, userver::formats::parse::To<
     price.quantity = value["quantity"].template As<PriceQuantity>();
     price.status = value["status"].template As<Status>();
     price.custom_data = value["custom_data"].template As<CustomData>();
-    price.created_at = value["created_at"].template As<Timestamp>();
-    price.updated_at = value["updated_at"].template As<Timestamp>();
+    price.created_at = ParseTimestamp(value["created_at"]);
+    price.updated_at = ParseTimestamp(value["updated_at"]);
     return price;
 }
 
@@ -2,16 +2,17 @@
 
 #include <paddle/types/discounts.hpp>
 #include <paddle/types/ids.hpp>
+#include <paddle/types/numeric.hpp>
 #include <paddle/types/price.hpp>
 #include <paddle/types/product.hpp>
 
 namespace paddle::prices {
 
 struct Totals {
-    std::int32_t subtotal;
-    std::int32_t discount;
-    std::int32_t tax;
-    std::int32_t total;
+    std::int64_t subtotal;
+    std::int64_t discount;
+    std::int64_t tax;
+    std::int64_t total;
 };
 
 struct FormattedTotals {
@@ -93,10 +94,10 @@ auto Serialize(const Totals& totals, userver::formats::serialize::To<Format>) ->
 template <typename Value>
 auto Parse(const Value& value, userver::formats::parse::To<Totals>) -> Totals {
     Totals totals;
-    totals.subtotal = std::stoi(value["subtotal"].template As<std::string>());
-    totals.discount = std::stoi(value["discount"].template As<std::string>());
-    totals.tax = std::stoi(value["tax"].template As<std::string>());
-    totals.total = std::stoi(value["total"].template As<std::string>());
+    totals.subtotal = ParseAmount(value["subtotal"]);
+    totals.discount = ParseAmount(value["discount"]);
+    totals.tax = ParseAmount(value["tax"]);
+    totals.total = ParseAmount(value["total"]);
     return totals;
 }
 
@@ -64,10 +64,10 @@ auto Parse(const Value& value, userver::formats::parse::To<ProductTemplate<Custo
     product.type = value["type"].template As<CatalogType>();
     product.tax_category = value["tax_category"].template As<std::optional<std::string>>();
     product.image_url = value["image_url"].template As<std::optional<std::string>>();
-    product.custom_data = value["custom_data"];
+    product.custom_data = value["custom_data"].template As<JSON>();
     product.status = value["status"].template As<Status>();
-    product.created_at = value["created_at"].template As<Timestamp>();
-    product.updated_at = value["updated_at"].template As<Timestamp>();
+    product.created_at = ParseTimestamp(value["created_at"]);
+    product.updated_at = ParseTimestamp(value["updated_at"]);
     return product;
 }
 
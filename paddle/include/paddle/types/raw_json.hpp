@@ -0,0 +1,208 @@
+#pragma once
+
+#include <paddle/types/formats.hpp>
+
+#include <boost/uuid/uuid.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// @brief Lightweight lookups in serialized JSON, without building a DOM
+///
+/// `FindValue` is used where only a couple of envelope fields are needed, e.g. to
+/// filter webhook events before the full parse. Malformed input is reported as a
+/// missing value, full parsing is expected to report the actual error.
+/// `Value` is the on-demand parse backend for the typed payloads.
+namespace paddle::raw_json {
+
+/// @brief Find the raw text of a value by the path of object member names
+/// @return value as it appears in the input, strings include the quotes
+auto FindValue(std::string_view json, std::initializer_list<std::string_view> path) -> std::optional<std::string_view>;
+
+/// @brief Decode a raw JSON string value, including the quotes
+/// @return std::nullopt if the value is not a string
+auto DecodeString(std::string_view raw) -> std::optional<std::string>;
+
+class ParseError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+namespace impl {
+
+template <typename T>
+struct IsOptional : std::false_type {};
+
+template <typename T>
+struct IsOptional<std::optional<T>> : std::true_type {};
+
+template <typename T>
+struct IsVector : std::false_type {};
+
+template <typename T>
+struct IsVector<std::vector<T>> : std::true_type {};
+
+template <typename T>
+concept StrongTypedef = requires(const T& value) {
+    typename T::UnderlyingType;
+    value.GetUnderlying();
+};
+
+template <typename T, typename Value>
+concept ParseableFrom = requires(const Value& value) { Parse(value, userver::formats::parse::To<T>{}); };
+
+}  // namespace impl
+
+/// @brief On-demand JSON value, accepted by the `Parse` templates of the paddle types in place of the DOM one
+///
+/// Nothing is parsed or validated up front: members are looked up in the input
+/// text when accessed and scalars are decoded straight into the fields. A member
+/// lookup resumes after the previously found member, so that the fields read in
+/// the document order cost a single pass over the object.
+/// The input text must outlive the value.
+class Value final {
+public:
+    using ParseException = ParseError;
+
+    /// @brief Missing value
+    Value() = default;
+    /// @brief Root of the document
+    /// @throws ParseError if the text is empty
+    explicit Value(std::string_view json);
+
+    /// @brief Object member, a missing value if there is no such member or the value is not an object
+    /// @throws ParseError if the object is malformed
+    auto operator[](std::string_view name) const -> Value;
+    [[nodiscard]] auto HasMember(std::string_view name) const -> bool;
+
+    [[nodiscard]] auto IsMissing() const -> bool;
+    [[nodiscard]] auto IsNull() const -> bool;
+    [[nodiscard]] auto IsObject() const -> bool;
+    [[nodiscard]] auto IsArray() const -> bool;
+    [[nodiscard]] auto IsString() const -> bool;
+    /// @brief Value as it appears in the input, strings include the quotes
+    [[nodiscard]] auto GetRaw() const -> std::string_view;
+
+    /// @throws ParseError if the value is missing or of a different type
+    /// @note As<std::string_view>() refers to the input text and only accepts strings without escape sequences
+    template <typename T>
+    auto As() const -> T;
+
+    /// @return default_value if the value is missing or null
+    template <typename T>
+    auto As(T default_value) const -> T {
+        if (IsMissing() || IsNull()) {
+            return default_value;
+        }
+        return As<T>();
+    }
+
+    /// @brief Call the function with every element of the array, null is an empty array
+    template <typename Function>
+    auto ForEachElement(Function&& function) const -> void {
+        if (IsNull()) {
+            return;
+        }
+        std::size_t pos = 0;
+        while (auto element = NextElement(pos)) {
+            function(*element);
+        }
+    }
+
+private:
+    Value(std::string_view raw, std::string_view name);
+
+    /// @param pos 0 before the first element, updated to the position after the returned one
+    auto NextElement(std::size_t& pos) const -> std::optional<Value>;
+    /// @param advance move the cursor past the member, otherwise leave it at the member
+    auto FindMember(std::string_view name, bool advance) const -> std::optional<Value>;
+
+    auto AsString() const -> std::string;
+    /// @brief String contents in place, without a copy
+    /// @throws ParseError if the string has escape sequences
+    auto AsStringView() const -> std::string_view;
+    auto AsBool() const -> bool;
+    auto AsInt64() const -> std::int64_t;
+    auto AsUint64() const -> std::uint64_t;
+    auto AsDouble() const -> double;
+    auto AsJson() const -> JSON;
+    auto AsTimePoint() const -> std::chrono::system_clock::time_point;
+    auto AsUuid() const -> boost::uuids::uuid;
+
+    [[noreturn]] auto ThrowTypeError(std::string_view expected) const -> void;
+
+    template <typename T>
+    auto CheckedCast(auto number) const -> T {
+        if (!std::in_range<T>(number)) {
+            ThrowTypeError("a number in range");
+        }
+        return static_cast<T>(number);
+    }
+
+    std::string_view raw_;
+    /// Member name for the error messages, elements keep the name of the array
+    std::string_view name_;
+    /// Offset in raw_ of the member the next lookup starts from, 0 for the first member
+    mutable std::size_t cursor_ = 0;
+    bool missing_ = true;
+};
+
+template <typename T>
+auto Value::As() const -> T {
+    if constexpr (std::is_same_v<T, std::string>) {
+        return AsString();
+    } else if constexpr (std::is_same_v<T, std::string_view>) {
+        return AsStringView();
+    } else if constexpr (std::is_same_v<T, bool>) {
+        return AsBool();
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        return CheckedCast<T>(AsInt64());
+    } else if constexpr (std::is_integral_v<T>) {
+        return CheckedCast<T>(AsUint64());
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return static_cast<T>(AsDouble());
+    } else if constexpr (std::is_same_v<T, JSON>) {
+        return AsJson();
+    } else if constexpr (std::is_same_v<T, std::chrono::system_clock::time_point>) {
+        return AsTimePoint();
+    } else if constexpr (std::is_same_v<T, boost::uuids::uuid>) {
+        return AsUuid();
+    } else if constexpr (impl::IsOptional<T>::value) {
+        if (IsMissing() || IsNull()) {
+            return std::nullopt;
+        }
+        return As<typename T::value_type>();
+    } else if constexpr (impl::IsVector<T>::value) {
+        if (!IsNull() && !IsArray()) {
+            ThrowTypeError("an array");
+        }
+        T result;
+        ForEachElement([&result](const Value& element) {
+            result.push_back(element.template As<typename T::value_type>());
+        });
+        return result;
+    } else if constexpr (impl::StrongTypedef<T>) {
+        return T{As<typename T::UnderlyingType>()};
+    } else if constexpr (impl::ParseableFrom<T, Value>) {
+        return Parse(*this, userver::formats::parse::To<T>{});
+    } else {
+        // User types parsed from the DOM only, e.g. custom data
+        return AsJson().template As<T>();
+    }
+}
+
+/// @brief Parse the JSON text into T without building a DOM
+template <typename T>
+auto ParseAs(std::string_view json) -> T {
+    return Value{json}.As<T>();
+}
+
+}  // namespace paddle::raw_json
@@ -18,6 +18,10 @@ struct Pagination {
     std::string next;
     bool has_more;
     std::int32_t estimated_total;
+
+    /// @brief The decoded `after` parameter of the next page URL, the other
+    ///        query parameters are not part of the cursor
+    [[nodiscard]] auto GetNextCursor() const -> std::optional<std::string>;
 };
 
 struct Meta {
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <paddle/types/lazy_field.hpp>
+#include <paddle/types/subscriptions.hpp>
+
+namespace paddle::subscriptions {
+
+/// @brief Subscription decoded on demand from the event JSON
+///
+/// Fields are decoded on the first access and cached, the items with their
+/// prices and products are only decoded if asked for. The event body is still
+/// parsed into a JSON DOM up front, only the conversion to the typed structs is
+/// deferred. The JSON shares the event document, copying the view is cheap.
+/// Not thread safe.
+class SubscriptionView {
+public:
+    SubscriptionView() = default;
+    explicit SubscriptionView(JSON json);
+
+    [[nodiscard]] auto GetJson() const -> const JSON&;
+
+    [[nodiscard]] auto GetId() const -> const SubscriptionId&;
+    [[nodiscard]] auto GetStatus() const -> SubscriptionStatus;
+    [[nodiscard]] auto GetCustomerId() const -> const CustomerId&;
+    [[nodiscard]] auto GetAddressId() const -> const AddressId&;
+    [[nodiscard]] auto GetBusinessId() const -> const OptionalBusinessId&;
+    [[nodiscard]] auto GetCurrencyCode() const -> const money::CurrencyCode&;
+    /// @brief Custom data subtree, shares the event document
+    [[nodiscard]] auto GetCustomData() const -> JSON;
+    [[nodiscard]] auto GetCollectionMode() const -> CollectionMode;
+    [[nodiscard]] auto GetCurrentBillingPeriod() const -> const TimePeriod&;
+    [[nodiscard]] auto GetBillingCycle() const -> const Duration&;
+    [[nodiscard]] auto GetScheduledChange() const -> const OptionalScheduledChange&;
+    [[nodiscard]] auto GetItems() const -> const std::vector<Item>&;
+    [[nodiscard]] auto GetCreatedAt() const -> Timestamp;
+    [[nodiscard]] auto GetUpdatedAt() const -> Timestamp;
+    [[nodiscard]] auto GetNextBilledAt() const -> OptionalTimestamp;
+    [[nodiscard]] auto GetPausedAt() const -> OptionalTimestamp;
+    [[nodiscard]] auto GetCanceledAt() const -> OptionalTimestamp;
+
+    /// @brief Decode the whole subscription, not cached
+    [[nodiscard]] auto ToSubscription() const -> Subscription;
+
+private:
+    JSON json_;
+    LazyField<SubscriptionId> id_;
+    LazyField<SubscriptionStatus> status_;
+    LazyField<CustomerId> customer_id_;
+    LazyField<AddressId> address_id_;
+    LazyField<OptionalBusinessId> business_id_;
+    LazyField<money::CurrencyCode> currency_code_;
+    LazyField<CollectionMode> collection_mode_;
+    LazyField<TimePeriod> current_billing_period_;
+    LazyField<Duration> billing_cycle_;
+    LazyField<OptionalScheduledChange> scheduled_change_;
+    LazyField<std::vector<Item>> items_;
+    LazyField<Timestamp> created_at_;
+    LazyField<Timestamp> updated_at_;
+    LazyField<OptionalTimestamp> next_billed_at_;
+    LazyField<OptionalTimestamp> paused_at_;
+    LazyField<OptionalTimestamp> canceled_at_;
+};
+
+template <typename Format>
+Format Serialize(const SubscriptionView& subscription, userver::formats::serialize::To<Format>) {
+    return subscription.GetJson();
+}
+
+template <typename Value>
+SubscriptionView Parse(const Value& value, userver::formats::parse::To<SubscriptionView>) {
+    return SubscriptionView{value.template As<JSON>()};
+}
+
+}  // namespace paddle::subscriptions
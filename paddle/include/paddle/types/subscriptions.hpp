@@ -84,8 +84,8 @@ template <typename Value>
 ScheduledChange Parse(const Value& value, userver::formats::parse::To<ScheduledChange>) {
     ScheduledChange scheduled_change;
     scheduled_change.action = value["action"].template As<ScheduledChangeAction>();
-    scheduled_change.effective_at = value["effective_at"].template As<Timestamp>();
-    scheduled_change.resume_at = value["resume_at"].template As<OptionalTimestamp>();
+    scheduled_change.effective_at = ParseTimestamp(value["effective_at"]);
+    scheduled_change.resume_at = ParseOptionalTimestamp(value["resume_at"]);
     return scheduled_change;
 }
 
@@ -130,10 +130,10 @@ Item Parse(const Value& value, userver::formats::parse::To<Item>) {
     item_subscription.status = value["status"].template As<SubscriptionItemStatus>();
     item_subscription.quantity = value["quantity"].template As<std::int32_t>();
     item_subscription.recurring = value["recurring"].template As<bool>();
-    item_subscription.created_at = value["created_at"].template As<Timestamp>();
-    item_subscription.updated_at = value["updated_at"].template As<Timestamp>();
-    item_subscription.previously_billed_at = value["previously_billed_at"].template As<OptionalTimestamp>();
-    item_subscription.next_billed_at = value["next_billed_at"].template As<OptionalTimestamp>();
+    item_subscription.created_at = ParseTimestamp(value["created_at"]);
+    item_subscription.updated_at = ParseTimestamp(value["updated_at"]);
+    item_subscription.previously_billed_at = ParseOptionalTimestamp(value["previously_billed_at"]);
+    item_subscription.next_billed_at = ParseOptionalTimestamp(value["next_billed_at"]);
     if (value.HasMember("trial_dates") && !value["trial_dates"].IsNull()) {
         item_subscription.trial_dates = value["trial_dates"].template As<TimePeriod>();
     }
@@ -180,13 +180,13 @@ Subscription Parse(const Value& value, userver::formats::parse::To<Subscription>
     subscription.address_id = value["address_id"].template As<AddressId>();
     subscription.business_id = value["business_id"].template As<OptionalBusinessId>();
     subscription.currency_code = value["currency_code"].template As<money::CurrencyCode>();
-    subscription.created_at = value["created_at"].template As<Timestamp>();
-    subscription.updated_at = value["updated_at"].template As<Timestamp>();
-    subscription.started_at = value["started_at"].template As<OptionalTimestamp>();
-    subscription.first_billed_at = value["first_billed_at"].template As<OptionalTimestamp>();
-    subscription.next_billed_at = value["next_billed_at"].template As<OptionalTimestamp>();
-    subscription.paused_at = value["paused_at"].template As<OptionalTimestamp>();
-    subscription.canceled_at = value["canceled_at"].template As<OptionalTimestamp>();
+    subscription.created_at = ParseTimestamp(value["created_at"]);
+    subscription.updated_at = ParseTimestamp(value["updated_at"]);
+    subscription.started_at = ParseOptionalTimestamp(value["started_at"]);
+    subscription.first_billed_at = ParseOptionalTimestamp(value["first_billed_at"]);
+    subscription.next_billed_at = ParseOptionalTimestamp(value["next_billed_at"]);
+    subscription.paused_at = ParseOptionalTimestamp(value["paused_at"]);
+    subscription.canceled_at = ParseOptionalTimestamp(value["canceled_at"]);
     subscription.discount = value["discount"].template As<OptionalDiscountSubscription>();
     subscription.collection_mode = value["collection_mode"].template As<CollectionMode>();
     subscription.billing_details = value["billing_details"].template As<OptionalBillingDetails>();
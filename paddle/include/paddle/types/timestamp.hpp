@@ -1,14 +1,50 @@
 #pragma once
 
 #include <paddle/types/formats.hpp>
+#include <paddle/types/raw_json.hpp>
 
 #include <userver/storages/postgres/io/chrono.hpp>
 
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
 namespace paddle {
 
 using Timestamp = userver::storages::postgres::TimePointTz;
 using OptionalTimestamp = std::optional<Timestamp>;
 
+/// @brief Parse an RFC 3339 timestamp, truncated to microseconds
+///
+/// Paddle's `YYYY-MM-DDTHH:MM:SS.ffffffZ` (any number of fractional digits,
+/// `Z` or a numeric offset) is parsed in place without allocating, other
+/// forms are passed to `userver::utils::datetime::Stringtime`.
+/// @throws std::invalid_argument if the text is not an RFC 3339 timestamp
+auto ParseRfc3339(std::string_view text) -> std::chrono::system_clock::time_point;
+
+/// @brief Read a timestamp field with ParseRfc3339
+///
+/// The on-demand backend parses the string in place, the DOM copies it first.
+template <typename Value>
+auto ParseTimestamp(const Value& value) -> Timestamp {
+    if constexpr (std::is_same_v<Value, raw_json::Value>) {
+        return Timestamp{ParseRfc3339(value.template As<std::string_view>())};
+    } else {
+        return Timestamp{ParseRfc3339(value.template As<std::string>())};
+    }
+}
+
+/// @brief Read a timestamp field that may be null or missing
+template <typename Value>
+auto ParseOptionalTimestamp(const Value& value) -> OptionalTimestamp {
+    if (value.IsMissing() || value.IsNull()) {
+        return std::nullopt;
+    }
+    return ParseTimestamp(value);
+}
+
 struct TimePeriod {
     Timestamp starts_at;
     Timestamp ends_at;
@@ -30,8 +66,8 @@ Format Serialize(const TimePeriod& time_period, userver::formats::serialize::To<
 template <typename Value>
 TimePeriod Parse(const Value& value, userver::formats::parse::To<TimePeriod>) {
     TimePeriod time_period;
-    time_period.starts_at = value["starts_at"].template As<Timestamp>();
-    time_period.ends_at = value["ends_at"].template As<Timestamp>();
+    time_period.starts_at = ParseTimestamp(value["starts_at"]);
+    time_period.ends_at = ParseTimestamp(value["ends_at"]);
     return time_period;
 }
 
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <paddle/types/lazy_field.hpp>
+#include <paddle/types/transactions.hpp>
+
+namespace paddle::transactions {
+
+/// @brief Transaction decoded on demand from the event JSON
+///
+/// Fields are decoded on the first access and cached, so a handler reading
+/// the id, status and totals doesn't pay for the line items, products and
+/// payment attempts. The event body is still parsed into a JSON DOM up front,
+/// only the conversion to the typed structs is deferred. The JSON shares the
+/// event document, copying the view is cheap. Not thread safe.
+class TransactionView {
+public:
+    TransactionView() = default;
+    explicit TransactionView(JSON json);
+
+    [[nodiscard]] auto GetJson() const -> const JSON&;
+
+    [[nodiscard]] auto GetId() const -> const TransactionId&;
+    [[nodiscard]] auto GetStatus() const -> TransactionStatus;
+    [[nodiscard]] auto GetCustomerId() const -> const OptionalCustomerId&;
+    [[nodiscard]] auto GetAddressId() const -> const OptionalAddressId&;
+    [[nodiscard]] auto GetBusinessId() const -> const OptionalBusinessId&;
+    /// @brief Custom data subtree, shares the event document
+    [[nodiscard]] auto GetCustomData() const -> JSON;
+    [[nodiscard]] auto GetCurrencyCode() const -> const money::CurrencyCode&;
+    [[nodiscard]] auto GetOrigin() const -> TransactionOrigin;
+    [[nodiscard]] auto GetSubscriptionId() const -> const OptionalSubscriptionId&;
+    [[nodiscard]] auto GetCollectionMode() const -> CollectionMode;
+    [[nodiscard]] auto GetBillingPeriod() const -> const std::optional<TimePeriod>&;
+    /// @brief `details.totals`, without decoding the rest of the details
+    [[nodiscard]] auto GetTotals() const -> const TransactionTotals&;
+    [[nodiscard]] auto GetDetails() const -> const Details&;
+    [[nodiscard]] auto GetItems() const -> const std::vector<Item>&;
+    [[nodiscard]] auto GetPayments() const -> const std::vector<PaymentAttempt>&;
+    [[nodiscard]] auto GetCreatedAt() const -> Timestamp;
+    [[nodiscard]] auto GetUpdatedAt() const -> Timestamp;
+    [[nodiscard]] auto GetBilledAt() const -> OptionalTimestamp;
+
+    /// @brief Decode the whole transaction, not cached
+    [[nodiscard]] auto ToTransaction() const -> Transaction;
+
+private:
+    JSON json_;
+    LazyField<TransactionId> id_;
+    LazyField<TransactionStatus> status_;
+    LazyField<OptionalCustomerId> customer_id_;
+    LazyField<OptionalAddressId> address_id_;
+    LazyField<OptionalBusinessId> business_id_;
+    LazyField<money::CurrencyCode> currency_code_;
+    LazyField<TransactionOrigin> origin_;
+    LazyField<OptionalSubscriptionId> subscription_id_;
+    LazyField<CollectionMode> collection_mode_;
+    LazyField<std::optional<TimePeriod>> billing_period_;
+    LazyField<TransactionTotals> totals_;
+    LazyField<Details> details_;
+    LazyField<std::vector<Item>> items_;
+    LazyField<std::vector<PaymentAttempt>> payments_;
+    LazyField<Timestamp> created_at_;
+    LazyField<Timestamp> updated_at_;
+    LazyField<OptionalTimestamp> billed_at_;
+};
+
+template <typename Format>
+Format Serialize(const TransactionView& transaction, userver::formats::serialize::To<Format>) {
+    return transaction.GetJson();
+}
+
+template <typename Value>
+TransactionView Parse(const Value& value, userver::formats::parse::To<TransactionView>) {
+    return TransactionView{value.template As<JSON>()};
+}
+
+}  // namespace paddle::transactions
@@ -4,6 +4,7 @@
 #include <paddle/types/enums.hpp>
 #include <paddle/types/ids.hpp>
 #include <paddle/types/money.hpp>
+#include <paddle/types/numeric.hpp>
 #include <paddle/types/payment_method.hpp>
 #include <paddle/types/price.hpp>
 #include <paddle/types/product.hpp>
@@ -331,10 +332,10 @@ Format Serialize(const Totals& totals, userver::formats::serialize::To<Format>)
 template <typename Value>
 Totals Parse(const Value& value, userver::formats::parse::To<Totals>) {
     Totals totals;
-    totals.subtotal = std::stoll(value["subtotal"].template As<std::string>());
-    totals.discount = std::stoll(value["discount"].template As<std::string>());
-    totals.tax = std::stoll(value["tax"].template As<std::string>());
-    totals.total = std::stoll(value["total"].template As<std::string>());
+    totals.subtotal = ParseAmount(value["subtotal"]);
+    totals.discount = ParseAmount(value["discount"]);
+    totals.tax = ParseAmount(value["tax"]);
+    totals.total = ParseAmount(value["total"]);
     return totals;
 }
 
@@ -411,15 +412,15 @@ Format Serialize(const TransactionTotals& totals, userver::formats::serialize::T
 template <typename Value>
 TransactionTotals Parse(const Value& value, userver::formats::parse::To<TransactionTotals>) {
     TransactionTotals totals;
-    totals.credit = std::stoll(value["credit"].template As<std::string>());
-    totals.credit_to_balance = std::stoll(value["credit_to_balance"].template As<std::string>());
-    totals.balance = std::stoll(value["balance"].template As<std::string>());
-    totals.grand_total = std::stoll(value["grand_total"].template As<std::string>());
+    totals.credit = ParseAmount(value["credit"]);
+    totals.credit_to_balance = ParseAmount(value["credit_to_balance"]);
+    totals.balance = ParseAmount(value["balance"]);
+    totals.grand_total = ParseAmount(value["grand_total"]);
     if (value.HasMember("fee") && !value["fee"].IsNull()) {
-        totals.fee = std::stoll(value["fee"].template As<std::string>());
+        totals.fee = ParseAmount(value["fee"]);
     }
     if (value.HasMember("earnings") && !value["earnings"].IsNull()) {
-        totals.earnings = std::stoll(value["earnings"].template As<std::string>());
+        totals.earnings = ParseAmount(value["earnings"]);
     }
     totals.currency_code = value["currency_code"].template As<money::CurrencyCode>();
     return totals;
@@ -450,15 +451,15 @@ Format Serialize(const TransactionTotalsAdjusted& totals, userver::formats::seri
 template <typename Value>
 TransactionTotalsAdjusted Parse(const Value& value, userver::formats::parse::To<TransactionTotalsAdjusted>) {
     TransactionTotalsAdjusted totals;
-    totals.subtotal = std::stoll(value["subtotal"].template As<std::string>());
-    totals.tax = std::stoll(value["tax"].template As<std::string>());
-    totals.total = std::stoll(value["total"].template As<std::string>());
-    totals.grand_total = std::stoll(value["grand_total"].template As<std::string>());
+    totals.subtotal = ParseAmount(value["subtotal"]);
+    totals.tax = ParseAmount(value["tax"]);
+    totals.total = ParseAmount(value["total"]);
+    totals.grand_total = ParseAmount(value["grand_total"]);
     if (value.HasMember("fee") && !value["fee"].IsNull()) {
-        totals.fee = std::stoll(value["fee"].template As<std::string>());
+        totals.fee = ParseAmount(value["fee"]);
     }
     if (value.HasMember("earnings") && !value["earnings"].IsNull()) {
-        totals.earnings = std::stoll(value["earnings"].template As<std::string>());
+        totals.earnings = ParseAmount(value["earnings"]);
     }
     totals.currency_code = value["currency_code"].template As<money::CurrencyCode>();
     return totals;
@@ -493,19 +494,19 @@ Format Serialize(const TransactionPayoutTotals& totals, userver::formats::serial
 template <typename Value>
 TransactionPayoutTotals Parse(const Value& value, userver::formats::parse::To<TransactionPayoutTotals>) {
     TransactionPayoutTotals totals;
-    totals.subtotal = std::stoll(value["subtotal"].template As<std::string>());
-    totals.discount = std::stoll(value["discount"].template As<std::string>());
-    totals.tax = std::stoll(value["tax"].template As<std::string>());
-    totals.total = std::stoll(value["total"].template As<std::string>());
-    totals.credit = std::stoll(value["credit"].template As<std::string>());
-    totals.credit_to_balance = std::stoll(value["credit_to_balance"].template As<std::string>());
-    totals.balance = std::stoll(value["balance"].template As<std::string>());
-    totals.grand_total = std::stoll(value["grand_total"].template As<std::string>());
+    totals.subtotal = ParseAmount(value["subtotal"]);
+    totals.discount = ParseAmount(value["discount"]);
+    totals.tax = ParseAmount(value["tax"]);
+    totals.total = ParseAmount(value["total"]);
+    totals.credit = ParseAmount(value["credit"]);
+    totals.credit_to_balance = ParseAmount(value["credit_to_balance"]);
+    totals.balance = ParseAmount(value["balance"]);
+    totals.grand_total = ParseAmount(value["grand_total"]);
     if (value.HasMember("fee") && !value["fee"].IsNull()) {
-        totals.fee = std::stoll(value["fee"].template As<std::string>());
+        totals.fee = ParseAmount(value["fee"]);
     }
     if (value.HasMember("earnings") && !value["earnings"].IsNull()) {
-        totals.earnings = std::stoll(value["earnings"].template As<std::string>());
+        totals.earnings = ParseAmount(value["earnings"]);
     }
     totals.currency_code = value["currency_code"].template As<money::CurrencyCode>();
     return totals;
@@ -523,7 +524,7 @@ Format Serialize(const ChargebackFee& chargeback_fee, userver::formats::serializ
 template <typename Value>
 ChargebackFee Parse(const Value& value, userver::formats::parse::To<ChargebackFee>) {
     ChargebackFee chargeback_fee;
-    chargeback_fee.amount = std::stoll(value["amount"].template As<std::string>());
+    chargeback_fee.amount = ParseAmount(value["amount"]);
     if (value.HasMember("original") && !value["original"].IsNull()) {
         chargeback_fee.original = value["original"].template As<money::Money>();
     }
@@ -548,12 +549,12 @@ template <typename Value>
 TransactionPayoutTotalsAdjusted
 Parse(const Value& value, userver::formats::parse::To<TransactionPayoutTotalsAdjusted>) {
     TransactionPayoutTotalsAdjusted totals;
-    totals.subtotal = std::stoll(value["subtotal"].template As<std::string>());
-    totals.tax = std::stoll(value["tax"].template As<std::string>());
-    totals.total = std::stoll(value["total"].template As<std::string>());
-    totals.fee = std::stoll(value["fee"].template As<std::string>());
+    totals.subtotal = ParseAmount(value["subtotal"]);
+    totals.tax = ParseAmount(value["tax"]);
+    totals.total = ParseAmount(value["total"]);
+    totals.fee = ParseAmount(value["fee"]);
     totals.chargeback_fee = value["chargeback_fee"].template As<ChargebackFee>();
-    totals.earnings = std::stoll(value["earnings"].template As<std::string>());
+    totals.earnings = ParseAmount(value["earnings"]);
     totals.currency_code = value["currency_code"].template As<money::CurrencyCode>();
     return totals;
 }
@@ -632,15 +633,15 @@ PaymentAttempt Parse(const Value& value, userver::formats::parse::To<PaymentAtte
         payment_attempt.stored_payment_method_id = value["stored_payment_method_id"].template As<boost::uuids::uuid>();
     }
     payment_attempt.payment_method_id = value["payment_method_id"].template As<PaymentMethodId>();
-    payment_attempt.amount = std::stoll(value["amount"].template As<std::string>());
+    payment_attempt.amount = ParseAmount(value["amount"]);
     payment_attempt.status = value["status"].template As<PaymentAttemptStatus>();
     if (value.HasMember("error_code")) {
         payment_attempt.error_code = value["error_code"].template As<std::optional<PaymentAttemptErrorCode>>();
     }
     payment_attempt.method_details = value["method_details"].template As<PaymentMethod>();
-    payment_attempt.created_at = value["created_at"].template As<Timestamp>();
+    payment_attempt.created_at = ParseTimestamp(value["created_at"]);
     if (value.HasMember("captured_at") && !value["captured_at"].IsNull()) {
-        payment_attempt.captured_at = value["captured_at"].template As<Timestamp>();
+        payment_attempt.captured_at = ParseTimestamp(value["captured_at"]);
     }
     return payment_attempt;
 }
@@ -736,13 +737,13 @@ Transaction Parse(const Value& value, userver::formats::parse::To<Transaction>)
     if (value.HasMember("checkout")) {
         transaction.checkout = value["checkout"].template As<std::optional<Checkout>>();
     }
-    transaction.created_at = value["created_at"].template As<Timestamp>();
-    transaction.updated_at = value["updated_at"].template As<Timestamp>();
+    transaction.created_at = ParseTimestamp(value["created_at"]);
+    transaction.updated_at = ParseTimestamp(value["updated_at"]);
     if (value.HasMember("billed_at")) {
-        transaction.billed_at = value["billed_at"].template As<OptionalTimestamp>();
+        transaction.billed_at = ParseOptionalTimestamp(value["billed_at"]);
     }
     if (value.HasMember("revised_at")) {
-        transaction.revised_at = value["revised_at"].template As<OptionalTimestamp>();
+        transaction.revised_at = ParseOptionalTimestamp(value["revised_at"]);
     }
     return transaction;
 }
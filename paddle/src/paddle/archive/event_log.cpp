@@ -0,0 +1,636 @@
+#include <paddle/archive/event_log.hpp>
+
+#include <paddle/types/raw_json.hpp>
+
+#include <userver/logging/log.hpp>
+#include <userver/utils/datetime/from_string_saturating.hpp>
+
+#include <fmt/format.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+
+namespace paddle::archive {
+
+namespace {
+
+constexpr std::array<char, 8> kIndexMagic{'P', 'D', 'L', 'I', 'D', 'X', '0', '1'};
+constexpr std::string_view kSegmentPrefix = "events-";
+constexpr std::string_view kSegmentExtension = ".ndjson";
+constexpr std::string_view kIndexExtension = ".idx";
+/// Records scanned for a single page, so that a selective query doesn't read the whole archive at once
+constexpr std::size_t kMaxScannedPerPage = 100000;
+/// Event ids and occurred_at don't have to match exactly
+constexpr std::chrono::milliseconds kRangeMargin{std::chrono::minutes{1}};
+
+struct IndexHeader {
+    std::array<char, 8> magic{};
+    std::uint64_t count = 0;
+    std::uint64_t entity_count = 0;
+};
+
+static_assert(sizeof(IndexHeader) % alignof(IndexRecord) == 0);
+static_assert(sizeof(IndexRecord) % alignof(std::uint32_t) == 0);
+
+[[noreturn]] void ThrowSystemError(std::string_view what, const std::filesystem::path& path) {
+    throw std::system_error(errno, std::generic_category(), fmt::format("{} {}", what, path.string()));
+}
+
+auto View(const std::array<char, kIndexedIdSize>& id) -> std::string_view {
+    return {id.data(), static_cast<std::size_t>(std::find(id.begin(), id.end(), '\0') - id.begin())};
+}
+
+auto Store(std::array<char, kIndexedIdSize>& id, std::string_view value) -> bool {
+    if (value.size() > id.size()) {
+        return false;
+    }
+    std::copy(value.begin(), value.end(), id.begin());
+    return true;
+}
+
+auto FindString(std::string_view raw_event, std::initializer_list<std::string_view> path) -> std::string {
+    auto raw_value = raw_json::FindValue(raw_event, path);
+    auto value = raw_value ? raw_json::DecodeString(*raw_value) : std::nullopt;
+    return value.value_or(std::string{});
+}
+
+auto ToMilliseconds(std::chrono::system_clock::time_point time_point) -> std::int64_t {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time_point.time_since_epoch()).count();
+}
+
+auto GetSegmentPath(const std::filesystem::path& directory, std::uint32_t number) -> std::filesystem::path {
+    return directory / fmt::format("{}{:06}{}", kSegmentPrefix, number, kSegmentExtension);
+}
+
+auto GetIndexPath(std::filesystem::path segment_path) -> std::filesystem::path {
+    return segment_path.replace_extension(kIndexExtension);
+}
+
+/// @return segment number, std::nullopt for the other files
+auto ParseSegmentNumber(const std::filesystem::path& path) -> std::optional<std::uint32_t> {
+    auto name = path.filename().string();
+    if (!name.starts_with(kSegmentPrefix) || !name.ends_with(kSegmentExtension)) {
+        return std::nullopt;
+    }
+    auto digits = std::string_view{name}.substr(
+        kSegmentPrefix.size(), name.size() - kSegmentPrefix.size() - kSegmentExtension.size()
+    );
+    if (digits.empty() || !std::all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+        return std::nullopt;
+    }
+    return static_cast<std::uint32_t>(std::stoul(std::string{digits}));
+}
+
+class FileDescriptor {
+public:
+    FileDescriptor(const std::filesystem::path& path, int flags)
+        : fd_{::open(path.c_str(), flags | O_CLOEXEC, 0644)} {
+        if (fd_ < 0) {
+            ThrowSystemError("Failed to open", path);
+        }
+    }
+    ~FileDescriptor() {
+        ::close(fd_);
+    }
+
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    [[nodiscard]] auto Get() const -> int {
+        return fd_;
+    }
+
+private:
+    int fd_;
+};
+
+auto GetFileSize(const FileDescriptor& file, const std::filesystem::path& path) -> std::uint64_t {
+    struct stat stats {};
+    if (::fstat(file.Get(), &stats) != 0) {
+        ThrowSystemError("Failed to stat", path);
+    }
+    return static_cast<std::uint64_t>(stats.st_size);
+}
+
+auto ReadAt(const FileDescriptor& file, std::uint64_t offset, std::uint64_t length, const std::filesystem::path& path)
+    -> std::string {
+    std::string data(length, '\0');
+    std::uint64_t done = 0;
+    while (done < length) {
+        auto result = ::pread(file.Get(), data.data() + done, length - done, static_cast<off_t>(offset + done));
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            ThrowSystemError("Failed to read", path);
+        }
+        done += static_cast<std::uint64_t>(result);
+    }
+    return data;
+}
+
+auto WriteAll(const FileDescriptor& file, std::string_view data, const std::filesystem::path& path) -> void {
+    while (!data.empty()) {
+        auto result = ::write(file.Get(), data.data(), data.size());
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result < 0) {
+            ThrowSystemError("Failed to write", path);
+        }
+        data.remove_prefix(static_cast<std::size_t>(result));
+    }
+}
+
+auto SyncFile(const FileDescriptor& file, const std::filesystem::path& path) -> void {
+    if (::fsync(file.Get()) != 0) {
+        ThrowSystemError("Failed to sync", path);
+    }
+}
+
+/// Read-only memory mapping of a whole file
+class MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path& path) {
+        FileDescriptor file{path, O_RDONLY};
+        size_ = GetFileSize(file, path);
+        if (size_ == 0) {
+            return;
+        }
+        data_ = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, file.Get(), 0);
+        if (data_ == MAP_FAILED) {
+            data_ = nullptr;
+            ThrowSystemError("Failed to map", path);
+        }
+    }
+    ~MappedFile() {
+        if (data_) {
+            ::munmap(data_, size_);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] auto GetData() const -> const char* {
+        return static_cast<const char*>(data_);
+    }
+    [[nodiscard]] auto GetSize() const -> std::uint64_t {
+        return size_;
+    }
+
+private:
+    void* data_ = nullptr;
+    std::uint64_t size_ = 0;
+};
+
+auto ByEventId(const IndexRecord& lhs, const IndexRecord& rhs) -> bool {
+    return lhs.GetEventId() < rhs.GetEventId();
+}
+
+auto ByEntityId(const IndexRecord& lhs, const IndexRecord& rhs) -> bool {
+    return std::pair{lhs.GetEntityId(), lhs.GetEventId()} < std::pair{rhs.GetEntityId(), rhs.GetEventId()};
+}
+
+/// Past the time range, as are all the events with greater ids
+auto IsPastRange(const events::EventQuery& query, const IndexRecord& record) -> bool {
+    return query.occurred_before &&
+           record.occurred_at >= ToMilliseconds(query.occurred_before->GetUnderlying()) + kRangeMargin.count();
+}
+
+}  // namespace
+
+auto IndexRecord::GetEventId() const -> std::string_view {
+    return View(event_id);
+}
+
+auto IndexRecord::GetEntityId() const -> std::string_view {
+    return View(entity_id);
+}
+
+auto IndexRecord::GetEventType() const -> std::string_view {
+    return View(event_type);
+}
+
+auto MakeIndexRecord(std::string_view raw_event) -> std::optional<IndexRecord> {
+    IndexRecord record;
+    auto event_id = FindString(raw_event, {"event_id"});
+    if (event_id.empty() || !Store(record.event_id, event_id)) {
+        return std::nullopt;
+    }
+    // Ids too long to be indexed are left empty, the event is still archived
+    Store(record.entity_id, FindString(raw_event, {"data", "id"}));
+    Store(record.event_type, FindString(raw_event, {"event_type"}));
+    auto occurred_at = FindString(raw_event, {"occurred_at"});
+    if (!occurred_at.empty()) {
+        record.occurred_at = ToMilliseconds(userver::utils::datetime::FromRfc3339StringSaturating(occurred_at));
+    }
+    return record;
+}
+
+auto Matches(const events::EventQuery& query, const IndexRecord& record) -> bool {
+    if (!query.event_types.empty()) {
+        auto event_type = record.GetEventType();
+        auto matches = std::any_of(query.event_types.begin(), query.event_types.end(), [event_type](auto type) {
+            return EnumToString(type) == event_type;
+        });
+        if (!matches) {
+            return false;
+        }
+    }
+    if (query.occurred_after && record.occurred_at < ToMilliseconds(query.occurred_after->GetUnderlying())) {
+        return false;
+    }
+    if (query.occurred_before && record.occurred_at >= ToMilliseconds(query.occurred_before->GetUnderlying())) {
+        return false;
+    }
+    if (!query.entity_ids.empty()) {
+        auto entity_id = record.GetEntityId();
+        return std::find(query.entity_ids.begin(), query.entity_ids.end(), entity_id) != query.entity_ids.end();
+    }
+    return true;
+}
+
+/// Segment file with its index, either sealed (mapped index) or active (index in memory)
+class EventLog::Segment {
+public:
+    /// Open a sealed segment
+    Segment(std::filesystem::path path, std::unique_ptr<MappedFile> index)
+        : path_{std::move(path)}
+        , read_file_{path_, O_RDONLY}
+        , index_{std::move(index)} {
+        const auto* data = index_->GetData();
+        IndexHeader header;
+        if (index_->GetSize() < sizeof(header)) {
+            throw std::runtime_error(fmt::format("Truncated archive index of {}", path_.string()));
+        }
+        std::memcpy(&header, data, sizeof(header));
+        const auto expected_size =
+            sizeof(header) + header.count * sizeof(IndexRecord) + header.entity_count * sizeof(std::uint32_t);
+        if (header.magic != kIndexMagic || index_->GetSize() != expected_size || header.entity_count > header.count) {
+            throw std::runtime_error(fmt::format("Invalid archive index of {}", path_.string()));
+        }
+        // The mapping is page aligned and the header size is a multiple of the record alignment
+        const auto* records = reinterpret_cast<const IndexRecord*>(data + sizeof(header));
+        records_ = {records, header.count};
+        by_entity_ = {
+            reinterpret_cast<const std::uint32_t*>(data + sizeof(header) + header.count * sizeof(IndexRecord)),
+            header.entity_count
+        };
+    }
+
+    /// Open the active segment, the index is rebuilt from the file
+    explicit Segment(std::filesystem::path path)
+        : path_{std::move(path)}
+        , read_file_{path_, O_RDONLY | O_CREAT}
+        , write_file_{std::make_unique<FileDescriptor>(path_, O_WRONLY | O_APPEND | O_CREAT)} {
+        Recover();
+    }
+
+    [[nodiscard]] auto IsSealed() const -> bool {
+        return index_ != nullptr;
+    }
+
+    [[nodiscard]] auto GetPath() const -> const std::filesystem::path& {
+        return path_;
+    }
+
+    [[nodiscard]] auto GetSize() const -> std::uint64_t {
+        return size_;
+    }
+
+    /// Records sorted by event id
+    [[nodiscard]] auto GetRecords() const -> std::span<const IndexRecord> {
+        return IsSealed() ? records_ : std::span<const IndexRecord>{active_records_};
+    }
+
+    [[nodiscard]] auto Find(std::string_view event_id) const -> const IndexRecord* {
+        auto records = GetRecords();
+        auto it = std::lower_bound(records.begin(), records.end(), event_id, [](const auto& record, auto id) {
+            return record.GetEventId() < id;
+        });
+        return it != records.end() && it->GetEventId() == event_id ? &*it : nullptr;
+    }
+
+    /// Records of the entity in event id order
+    [[nodiscard]] auto FindEntity(std::string_view entity_id) const -> std::vector<const IndexRecord*> {
+        std::vector<const IndexRecord*> found;
+        if (!IsSealed()) {
+            for (const auto& record : active_records_) {
+                if (record.GetEntityId() == entity_id) {
+                    found.push_back(&record);
+                }
+            }
+            return found;
+        }
+        auto entity_of = [this](std::uint32_t position) { return records_[position].GetEntityId(); };
+        auto first = std::lower_bound(by_entity_.begin(), by_entity_.end(), entity_id, [&](auto position, auto id) {
+            return entity_of(position) < id;
+        });
+        for (auto it = first; it != by_entity_.end() && entity_of(*it) == entity_id; ++it) {
+            found.push_back(&records_[*it]);
+        }
+        return found;
+    }
+
+    [[nodiscard]] auto ReadEvent(const IndexRecord& record) const -> std::string {
+        return ReadAt(read_file_, record.offset, record.length, path_);
+    }
+
+    auto Append(std::string_view raw_event, IndexRecord record) -> void {
+        std::string line;
+        line.reserve(raw_event.size() + 1);
+        line.append(raw_event).push_back('\n');
+        WriteAll(*write_file_, line, path_);
+        record.offset = size_;
+        record.length = raw_event.size();
+        size_ += line.size();
+        Insert(record);
+    }
+
+    auto Sync() const -> void {
+        if (write_file_) {
+            SyncFile(*write_file_, path_);
+        }
+    }
+
+    /// Write the index and switch to it
+    auto Seal() -> void {
+        Sync();
+        std::vector<std::uint32_t> by_entity;
+        for (std::uint32_t position = 0; position < active_records_.size(); ++position) {
+            if (!active_records_[position].GetEntityId().empty()) {
+                by_entity.push_back(position);
+            }
+        }
+        std::stable_sort(by_entity.begin(), by_entity.end(), [this](auto lhs, auto rhs) {
+            return ByEntityId(active_records_[lhs], active_records_[rhs]);
+        });
+        IndexHeader header;
+        header.magic = kIndexMagic;
+        header.count = active_records_.size();
+        header.entity_count = by_entity.size();
+
+        const auto index_path = GetIndexPath(path_);
+        auto temp_path = index_path;
+        temp_path += ".tmp";
+        {
+            FileDescriptor file{temp_path, O_WRONLY | O_CREAT | O_TRUNC};
+            WriteAll(file, {reinterpret_cast<const char*>(&header), sizeof(header)}, temp_path);
+            WriteAll(
+                file,
+                {reinterpret_cast<const char*>(active_records_.data()), active_records_.size() * sizeof(IndexRecord)},
+                temp_path
+            );
+            WriteAll(
+                file,
+                {reinterpret_cast<const char*>(by_entity.data()), by_entity.size() * sizeof(std::uint32_t)},
+                temp_path
+            );
+            SyncFile(file, temp_path);
+        }
+        std::filesystem::rename(temp_path, index_path);
+
+        index_ = std::make_unique<MappedFile>(index_path);
+        const auto* data = index_->GetData();
+        records_ = {reinterpret_cast<const IndexRecord*>(data + sizeof(header)), header.count};
+        by_entity_ = {
+            reinterpret_cast<const std::uint32_t*>(data + sizeof(header) + header.count * sizeof(IndexRecord)),
+            header.entity_count
+        };
+        write_file_.reset();
+        active_records_ = {};
+    }
+
+private:
+    /// Events mostly come in id order, so a record is usually appended at the end
+    auto Insert(const IndexRecord& record) -> void {
+        auto it = std::upper_bound(active_records_.begin(), active_records_.end(), record, ByEventId);
+        active_records_.insert(it, record);
+    }
+
+    auto Recover() -> void {
+        const auto file_size = GetFileSize(read_file_, path_);
+        const auto contents = ReadAt(read_file_, 0, file_size, path_);
+        std::uint64_t offset = 0;
+        while (offset < contents.size()) {
+            auto end = contents.find('\n', offset);
+            if (end == std::string::npos) {
+                break;
+            }
+            auto record = MakeIndexRecord(std::string_view{contents}.substr(offset, end - offset));
+            if (record) {
+                record->offset = offset;
+                record->length = end - offset;
+                Insert(*record);
+            }
+            offset = end + 1;
+        }
+        if (offset < file_size) {
+            LOG_WARNING() << "Discarding a partially written event at the end of " << path_.string();
+            if (::ftruncate(write_file_->Get(), static_cast<off_t>(offset)) != 0) {
+                ThrowSystemError("Failed to truncate", path_);
+            }
+        }
+        size_ = offset;
+    }
+
+    std::filesystem::path path_;
+    FileDescriptor read_file_;
+    std::uint64_t size_ = 0;
+
+    std::unique_ptr<MappedFile> index_;
+    std::span<const IndexRecord> records_;
+    std::span<const std::uint32_t> by_entity_;
+
+    std::unique_ptr<FileDescriptor> write_file_;
+    std::vector<IndexRecord> active_records_;
+};
+
+EventLog::EventLog(EventLogSettings settings)
+    : settings_{std::move(settings)} {
+    std::filesystem::create_directories(settings_.directory);
+    OpenSegments();
+}
+
+EventLog::~EventLog() {
+    try {
+        Sync();
+    } catch (const std::exception& e) {
+        LOG_ERROR() << "Failed to sync the event archive: " << e.what();
+    }
+}
+
+auto EventLog::OpenSegments() -> void {
+    std::vector<std::pair<std::uint32_t, std::filesystem::path>> files;
+    for (const auto& entry : std::filesystem::directory_iterator{settings_.directory}) {
+        if (auto number = ParseSegmentNumber(entry.path())) {
+            files.emplace_back(*number, entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    for (std::size_t index = 0; index < files.size(); ++index) {
+        const auto& [number, path] = files[index];
+        const auto is_last = index + 1 == files.size();
+        const auto index_path = GetIndexPath(path);
+        if (std::filesystem::exists(index_path)) {
+            try {
+                segments_.push_back(std::make_unique<Segment>(path, std::make_unique<MappedFile>(index_path)));
+                continue;
+            } catch (const std::exception& e) {
+                LOG_WARNING() << "Rebuilding the archive index of " << path.string() << ": " << e.what();
+            }
+            std::filesystem::remove(index_path);
+        }
+        // Either the active segment or the service stopped while sealing it
+        auto segment = std::make_unique<Segment>(path);
+        if (!is_last) {
+            segment->Seal();
+        }
+        segments_.push_back(std::move(segment));
+    }
+    if (segments_.empty() || segments_.back()->IsSealed()) {
+        StartSegment(files.empty() ? 1 : files.back().first + 1);
+    }
+}
+
+auto EventLog::StartSegment(std::uint32_t number) -> void {
+    segments_.push_back(std::make_unique<Segment>(GetSegmentPath(settings_.directory, number)));
+}
+
+auto EventLog::ContainsLocked(std::string_view event_id) const -> bool {
+    return std::any_of(segments_.begin(), segments_.end(), [event_id](const auto& segment) {
+        return segment->Find(event_id) != nullptr;
+    });
+}
+
+auto EventLog::Append(std::string_view raw_event) -> bool {
+    auto record = MakeIndexRecord(raw_event);
+    if (!record) {
+        return false;
+    }
+    std::string line;
+    if (raw_event.find_first_of("\r\n") != std::string_view::npos) {
+        // Line breaks can only be whitespace in a valid JSON, strings have them escaped
+        line = std::string{raw_event};
+        std::replace_if(line.begin(), line.end(), [](char c) { return c == '\n' || c == '\r'; }, ' ');
+        raw_event = line;
+    }
+    std::unique_lock lock{mutex_};
+    if (ContainsLocked(record->GetEventId())) {
+        return false;
+    }
+    auto& active = *segments_.back();
+    active.Append(raw_event, *record);
+    if (active.GetSize() >= settings_.segment_max_size) {
+        active.Seal();
+        StartSegment(*ParseSegmentNumber(active.GetPath()) + 1);
+    }
+    return true;
+}
+
+auto EventLog::Contains(std::string_view event_id) const -> bool {
+    std::shared_lock lock{mutex_};
+    return ContainsLocked(event_id);
+}
+
+auto EventLog::Find(std::string_view event_id) const -> std::optional<std::string> {
+    std::shared_lock lock{mutex_};
+    for (const auto& segment : segments_) {
+        if (const auto* record = segment->Find(event_id)) {
+            return segment->ReadEvent(*record);
+        }
+    }
+    return std::nullopt;
+}
+
+auto EventLog::Read(std::string_view cursor, const events::EventQuery& query, std::size_t limit) const
+    -> ResponseWithCursor<std::string> {
+    const auto start = query.GetStartCursor(cursor);
+    std::shared_lock lock{mutex_};
+    // Segments overlap in event ids, so they are merged
+    struct Position {
+        const Segment* segment;
+        std::span<const IndexRecord>::iterator current;
+        std::span<const IndexRecord>::iterator end;
+    };
+    std::vector<Position> positions;
+    for (const auto& segment : segments_) {
+        auto records = segment->GetRecords();
+        auto after_start = [](std::string_view id, const IndexRecord& record) { return id < record.GetEventId(); };
+        auto it = std::upper_bound(records.begin(), records.end(), std::string_view{start}, after_start);
+        if (it != records.end()) {
+            positions.push_back({segment.get(), it, records.end()});
+        }
+    }
+    std::vector<std::pair<const Segment*, const IndexRecord*>> selected;
+    std::string next_cursor = start;
+    std::size_t scanned = 0;
+    bool have_more = false;
+    while (!positions.empty()) {
+        if (selected.size() >= limit || scanned >= kMaxScannedPerPage) {
+            have_more = true;
+            break;
+        }
+        auto next = std::min_element(positions.begin(), positions.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.current->GetEventId() < rhs.current->GetEventId();
+        });
+        const auto& record = *next->current;
+        if (IsPastRange(query, record)) {
+            break;
+        }
+        ++scanned;
+        next_cursor = record.GetEventId();
+        if (Matches(query, record)) {
+            selected.emplace_back(next->segment, &record);
+        }
+        if (++next->current == next->end) {
+            positions.erase(next);
+        }
+    }
+    std::vector<std::string> events;
+    events.reserve(selected.size());
+    for (const auto& [segment, record] : selected) {
+        events.push_back(segment->ReadEvent(*record));
+    }
+    return {std::move(events), std::move(next_cursor), have_more};
+}
+
+auto EventLog::GetEntityHistory(std::string_view entity_id) const -> std::vector<std::string> {
+    std::shared_lock lock{mutex_};
+    std::vector<std::pair<const Segment*, const IndexRecord*>> found;
+    for (const auto& segment : segments_) {
+        for (const auto* record : segment->FindEntity(entity_id)) {
+            found.emplace_back(segment.get(), record);
+        }
+    }
+    std::sort(found.begin(), found.end(), [](const auto& lhs, const auto& rhs) {
+        return ByEventId(*lhs.second, *rhs.second);
+    });
+    std::vector<std::string> events;
+    events.reserve(found.size());
+    for (const auto& [segment, record] : found) {
+        events.push_back(segment->ReadEvent(*record));
+    }
+    return events;
+}
+
+auto EventLog::Sync() const -> void {
+    std::shared_lock lock{mutex_};
+    segments_.back()->Sync();
+}
+
+}  // namespace paddle::archive
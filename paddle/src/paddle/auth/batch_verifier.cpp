@@ -0,0 +1,76 @@
+#include <paddle/auth/batch_verifier.hpp>
+
+#include <paddle/auth/signature.hpp>
+
+#include <userver/engine/task/cancel.hpp>
+
+#include <mutex>
+#include <vector>
+
+namespace paddle::auth {
+
+struct BatchVerifier::Batch {
+    /// Views of the callers' data, the callers wait until the batch is done
+    std::vector<HmacInput> inputs;
+    std::vector<Sha256Digest> digests;
+    bool done = false;
+    userver::engine::ConditionVariable completed;
+};
+
+BatchVerifier::BatchVerifier(BatchVerifierSettings settings)
+    : settings_{settings} {
+}
+
+BatchVerifier::~BatchVerifier() = default;
+
+auto BatchVerifier::Verify(
+    std::span<const std::string> secrets,
+    std::string_view signature_header,
+    std::string_view payload,
+    std::int32_t max_age_seconds
+) const -> std::optional<std::size_t> {
+    auto header = ParseSignatureHeader(signature_header, max_age_seconds);
+    if (!header || secrets.empty()) {
+        return std::nullopt;
+    }
+    // The batch refers to the caller's data, so the caller must not leave before it is hashed.
+    // The wait is bounded by the window and the hashing time.
+    userver::engine::TaskCancellationBlocker cancellation_blocker;
+
+    std::unique_lock lock{mutex_};
+    auto batch = pending_;
+    const bool leader = !batch;
+    if (leader) {
+        batch = pending_ = std::make_shared<Batch>();
+    }
+    const auto first = batch->inputs.size();
+    for (const auto& secret : secrets) {
+        batch->inputs.push_back(HmacInput{secret, {header->timestamp, ":", payload}});
+    }
+    const auto is_full = [this, &batch] { return batch->inputs.size() >= settings_.max_batch_size; };
+    if (leader) {
+        [[maybe_unused]] auto full = batch_full_.WaitFor(lock, settings_.window, is_full);
+        pending_.reset();
+        lock.unlock();
+        batch->digests.resize(batch->inputs.size());
+        HmacSha256Batch(batch->inputs, batch->digests);
+        lock.lock();
+        batch->done = true;
+        batch->completed.NotifyAll();
+    } else {
+        if (is_full()) {
+            batch_full_.NotifyOne();
+        }
+        [[maybe_unused]] auto done = batch->completed.Wait(lock, [&batch] { return batch->done; });
+    }
+    lock.unlock();
+
+    for (std::size_t index = 0; index < secrets.size(); ++index) {
+        if (MatchesSignature(*header, batch->digests[first + index])) {
+            return index;
+        }
+    }
+    return std::nullopt;
+}
+
+}  // namespace paddle::auth
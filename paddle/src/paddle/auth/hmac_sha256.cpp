@@ -0,0 +1,538 @@
+#include <paddle/auth/hmac_sha256.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <immintrin.h>
+#define PADDLE_SHA256_X86 1
+#endif
+
+namespace paddle::auth {
+
+namespace {
+
+constexpr std::size_t kBlockSize = 64;
+constexpr std::size_t kLanes = 8;
+
+using State = std::array<std::uint32_t, 8>;
+using Block = std::array<std::uint8_t, kBlockSize>;
+
+constexpr State kInitialState{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+alignas(64) constexpr std::array<std::uint32_t, 64> kRoundConstants{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+constexpr auto RotateRight(std::uint32_t value, int bits) -> std::uint32_t {
+    return (value >> bits) | (value << (32 - bits));
+}
+
+auto LoadBigEndian(const std::uint8_t* data) -> std::uint32_t {
+    return (std::uint32_t{data[0]} << 24) | (std::uint32_t{data[1]} << 16) | (std::uint32_t{data[2]} << 8) |
+           std::uint32_t{data[3]};
+}
+
+auto ToDigest(const State& state) -> Sha256Digest {
+    Sha256Digest digest;
+    for (std::size_t index = 0; index < state.size(); ++index) {
+        digest[index * 4] = static_cast<std::uint8_t>(state[index] >> 24);
+        digest[index * 4 + 1] = static_cast<std::uint8_t>(state[index] >> 16);
+        digest[index * 4 + 2] = static_cast<std::uint8_t>(state[index] >> 8);
+        digest[index * 4 + 3] = static_cast<std::uint8_t>(state[index]);
+    }
+    return digest;
+}
+
+auto CompressScalar(State& state, const std::uint8_t* block) -> void {
+    std::array<std::uint32_t, 64> words;
+    for (std::size_t t = 0; t < 16; ++t) {
+        words[t] = LoadBigEndian(block + t * 4);
+    }
+    for (std::size_t t = 16; t < 64; ++t) {
+        auto s0 = RotateRight(words[t - 15], 7) ^ RotateRight(words[t - 15], 18) ^ (words[t - 15] >> 3);
+        auto s1 = RotateRight(words[t - 2], 17) ^ RotateRight(words[t - 2], 19) ^ (words[t - 2] >> 10);
+        words[t] = words[t - 16] + s0 + words[t - 7] + s1;
+    }
+    auto [a, b, c, d, e, f, g, h] = state;
+    for (std::size_t t = 0; t < 64; ++t) {
+        auto s1 = RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+        auto choice = (e & f) ^ (~e & g);
+        auto temp1 = h + s1 + choice + kRoundConstants[t] + words[t];
+        auto s0 = RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+        auto majority = (a & b) ^ (a & c) ^ (b & c);
+        auto temp2 = s0 + majority;
+        h = g;
+        g = f;
+        f = e;
+        e = d + temp1;
+        d = c;
+        c = b;
+        b = a;
+        a = temp1 + temp2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+#ifdef PADDLE_SHA256_X86
+
+[[gnu::target("sha,sse4.1")]] auto CompressShaNi(State& state, const std::uint8_t* block) -> void {
+    const auto byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    auto cdab = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0])), 0xB1);
+    auto efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4])), 0x1B);
+    auto abef = _mm_alignr_epi8(cdab, efgh, 8);
+    auto cdgh = _mm_blend_epi16(efgh, cdab, 0xF0);
+    const auto abef_saved = abef;
+    const auto cdgh_saved = cdgh;
+
+    // Plain arrays, std::array drops the vector type attributes
+    __m128i messages[16];
+    for (std::size_t group = 0; group < 16; ++group) {
+        if (group < 4) {
+            auto data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + group * 16));
+            messages[group] = _mm_shuffle_epi8(data, byte_swap);
+        } else {
+            auto partial = _mm_sha256msg1_epu32(messages[group - 4], messages[group - 3]);
+            partial = _mm_add_epi32(partial, _mm_alignr_epi8(messages[group - 1], messages[group - 2], 4));
+            messages[group] = _mm_sha256msg2_epu32(partial, messages[group - 1]);
+        }
+        auto round_input = _mm_add_epi32(
+            messages[group], _mm_load_si128(reinterpret_cast<const __m128i*>(&kRoundConstants[group * 4]))
+        );
+        cdgh = _mm_sha256rnds2_epu32(cdgh, abef, round_input);
+        abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(round_input, 0x0E));
+    }
+
+    abef = _mm_add_epi32(abef, abef_saved);
+    cdgh = _mm_add_epi32(cdgh, cdgh_saved);
+    auto feba = _mm_shuffle_epi32(abef, 0x1B);
+    auto dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), _mm_blend_epi16(feba, dchg, 0xF0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+[[gnu::target("avx2")]] inline auto Rotate8(__m256i value, int bits) -> __m256i {
+    return _mm256_or_si256(_mm256_srli_epi32(value, bits), _mm256_slli_epi32(value, 32 - bits));
+}
+
+/// Compresses one block of each of the eight lanes
+[[gnu::target("avx2")]] auto CompressAvx2(State* const* states, const std::uint8_t* const* blocks) -> void {
+    // Plain arrays, std::array drops the vector type attributes
+    __m256i vars[8];
+    for (std::size_t word = 0; word < 8; ++word) {
+        vars[word] = _mm256_setr_epi32(
+            static_cast<int>((*states[0])[word]),
+            static_cast<int>((*states[1])[word]),
+            static_cast<int>((*states[2])[word]),
+            static_cast<int>((*states[3])[word]),
+            static_cast<int>((*states[4])[word]),
+            static_cast<int>((*states[5])[word]),
+            static_cast<int>((*states[6])[word]),
+            static_cast<int>((*states[7])[word])
+        );
+    }
+    auto [a, b, c, d, e, f, g, h] = vars;
+
+    __m256i words[16];
+    for (std::size_t t = 0; t < 64; ++t) {
+        __m256i word;
+        if (t < 16) {
+            const auto offset = t * 4;
+            word = _mm256_setr_epi32(
+                static_cast<int>(LoadBigEndian(blocks[0] + offset)),
+                static_cast<int>(LoadBigEndian(blocks[1] + offset)),
+                static_cast<int>(LoadBigEndian(blocks[2] + offset)),
+                static_cast<int>(LoadBigEndian(blocks[3] + offset)),
+                static_cast<int>(LoadBigEndian(blocks[4] + offset)),
+                static_cast<int>(LoadBigEndian(blocks[5] + offset)),
+                static_cast<int>(LoadBigEndian(blocks[6] + offset)),
+                static_cast<int>(LoadBigEndian(blocks[7] + offset))
+            );
+        } else {
+            const auto w15 = words[(t - 15) % 16];
+            const auto w2 = words[(t - 2) % 16];
+            auto s0 = _mm256_xor_si256(_mm256_xor_si256(Rotate8(w15, 7), Rotate8(w15, 18)), _mm256_srli_epi32(w15, 3));
+            auto s1 = _mm256_xor_si256(_mm256_xor_si256(Rotate8(w2, 17), Rotate8(w2, 19)), _mm256_srli_epi32(w2, 10));
+            word = _mm256_add_epi32(
+                _mm256_add_epi32(words[t % 16], s0), _mm256_add_epi32(words[(t - 7) % 16], s1)
+            );
+        }
+        words[t % 16] = word;
+
+        auto s1 = _mm256_xor_si256(_mm256_xor_si256(Rotate8(e, 6), Rotate8(e, 11)), Rotate8(e, 25));
+        auto choice = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        auto temp1 = _mm256_add_epi32(
+            _mm256_add_epi32(h, s1),
+            _mm256_add_epi32(
+                choice, _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(kRoundConstants[t])), word)
+            )
+        );
+        auto s0 = _mm256_xor_si256(_mm256_xor_si256(Rotate8(a, 2), Rotate8(a, 13)), Rotate8(a, 22));
+        auto majority = _mm256_xor_si256(
+            _mm256_xor_si256(_mm256_and_si256(a, b), _mm256_and_si256(a, c)), _mm256_and_si256(b, c)
+        );
+        auto temp2 = _mm256_add_epi32(s0, majority);
+        h = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, temp1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi32(temp1, temp2);
+    }
+
+    const __m256i result[8] = {a, b, c, d, e, f, g, h};
+    for (std::size_t word = 0; word < 8; ++word) {
+        alignas(32) std::array<std::uint32_t, kLanes> lanes;
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes.data()), _mm256_add_epi32(result[word], vars[word]));
+        for (std::size_t lane = 0; lane < kLanes; ++lane) {
+            (*states[lane])[word] = lanes[lane];
+        }
+    }
+}
+
+struct CpuFeatures {
+    bool sha = false;
+    bool avx2 = false;
+};
+
+auto ReadExtendedControlRegister() -> std::uint64_t {
+    std::uint32_t low = 0;
+    std::uint32_t high = 0;
+    __asm__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+    return (std::uint64_t{high} << 32) | low;
+}
+
+auto DetectCpuFeatures() -> CpuFeatures {
+    CpuFeatures features;
+    unsigned eax = 0;
+    unsigned ebx = 0;
+    unsigned ecx = 0;
+    unsigned edx = 0;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return features;
+    }
+    const bool sse41 = (ecx & bit_SSE4_1) != 0;
+    // AVX state must be enabled by the OS
+    const bool avx_enabled =
+        (ecx & bit_OSXSAVE) != 0 && (ecx & bit_AVX) != 0 && (ReadExtendedControlRegister() & 0x6) == 0x6;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        return features;
+    }
+    features.sha = sse41 && (ebx & bit_SHA) != 0;
+    features.avx2 = avx_enabled && (ebx & bit_AVX2) != 0;
+    return features;
+}
+
+#else
+
+struct CpuFeatures {
+    bool sha = false;
+    bool avx2 = false;
+};
+
+auto DetectCpuFeatures() -> CpuFeatures {
+    return {};
+}
+
+#endif
+
+auto GetCpuFeatures() -> const CpuFeatures& {
+    static const auto features = DetectCpuFeatures();
+    return features;
+}
+
+/// Splits a message given in parts into padded SHA-256 blocks, full blocks
+/// inside a part are not copied
+class BlockReader {
+public:
+    static constexpr std::size_t kMaxParts = 4;
+
+    BlockReader() = default;
+
+    explicit BlockReader(const std::array<std::string_view, kMaxParts>& parts)
+        : parts_{parts} {
+        for (auto part : parts_) {
+            length_ += part.size();
+        }
+    }
+
+    /// @return the next block, valid until the next call, or nullptr after the last one
+    auto Next() -> const std::uint8_t* {
+        switch (stage_) {
+            case Stage::kData:
+                return NextData();
+            case Stage::kLength:
+                std::memset(buffer_.data(), 0, kBlockSize);
+                WriteLength();
+                stage_ = Stage::kDone;
+                return buffer_.data();
+            case Stage::kDone:
+                return nullptr;
+        }
+        return nullptr;
+    }
+
+private:
+    enum class Stage {
+        kData,
+        kLength,
+        kDone,
+    };
+
+    auto NextData() -> const std::uint8_t* {
+        while (part_ < parts_.size() && offset_ == parts_[part_].size()) {
+            ++part_;
+            offset_ = 0;
+        }
+        if (part_ < parts_.size() && parts_[part_].size() - offset_ >= kBlockSize) {
+            const auto* block = reinterpret_cast<const std::uint8_t*>(parts_[part_].data() + offset_);
+            offset_ += kBlockSize;
+            return block;
+        }
+        std::size_t filled = 0;
+        while (filled < kBlockSize && part_ < parts_.size()) {
+            auto count = std::min(kBlockSize - filled, parts_[part_].size() - offset_);
+            if (count != 0) {
+                std::memcpy(buffer_.data() + filled, parts_[part_].data() + offset_, count);
+            }
+            filled += count;
+            offset_ += count;
+            if (offset_ == parts_[part_].size()) {
+                ++part_;
+                offset_ = 0;
+            }
+        }
+        if (filled == kBlockSize) {
+            return buffer_.data();
+        }
+        // The last data block, followed by the padding
+        buffer_[filled++] = 0x80;
+        std::memset(buffer_.data() + filled, 0, kBlockSize - filled);
+        if (filled <= kBlockSize - 8) {
+            WriteLength();
+            stage_ = Stage::kDone;
+        } else {
+            stage_ = Stage::kLength;
+        }
+        return buffer_.data();
+    }
+
+    auto WriteLength() -> void {
+        const auto bits = static_cast<std::uint64_t>(length_) * 8;
+        for (std::size_t index = 0; index < 8; ++index) {
+            buffer_[kBlockSize - 1 - index] = static_cast<std::uint8_t>(bits >> (index * 8));
+        }
+    }
+
+    std::array<std::string_view, kMaxParts> parts_{};
+    std::size_t length_ = 0;
+    std::size_t part_ = 0;
+    std::size_t offset_ = 0;
+    Stage stage_ = Stage::kData;
+    Block buffer_{};
+};
+
+auto Compress(State& state, const std::uint8_t* block, Sha256Kernel kernel) -> void {
+#ifdef PADDLE_SHA256_X86
+    if (kernel == Sha256Kernel::kShaNi) {
+        CompressShaNi(state, block);
+        return;
+    }
+#endif
+    static_cast<void>(kernel);
+    CompressScalar(state, block);
+}
+
+auto Sha256(const std::array<std::string_view, BlockReader::kMaxParts>& parts, Sha256Kernel kernel) -> Sha256Digest {
+    BlockReader reader{parts};
+    auto state = kInitialState;
+    while (const auto* block = reader.Next()) {
+        Compress(state, block, kernel);
+    }
+    return ToDigest(state);
+}
+
+auto AsStringView(const std::uint8_t* data, std::size_t size) -> std::string_view {
+    return {reinterpret_cast<const char*>(data), size};
+}
+
+/// Key blocks XORed with the HMAC pads
+struct HmacKey {
+    Block inner;
+    Block outer;
+
+    HmacKey(std::string_view key, Sha256Kernel kernel) {
+        Block padded{};
+        if (key.size() > kBlockSize) {
+            auto hashed = Sha256({key}, kernel);
+            std::copy(hashed.begin(), hashed.end(), padded.begin());
+        } else {
+            std::copy(key.begin(), key.end(), padded.begin());
+        }
+        for (std::size_t index = 0; index < kBlockSize; ++index) {
+            inner[index] = padded[index] ^ 0x36;
+            outer[index] = padded[index] ^ 0x5c;
+        }
+    }
+};
+
+auto HmacSha256(const HmacInput& input, Sha256Kernel kernel) -> Sha256Digest {
+    const HmacKey key{input.key, kernel};
+    const auto& [first, second, third] = input.message;
+    auto inner = Sha256({AsStringView(key.inner.data(), kBlockSize), first, second, third}, kernel);
+    return Sha256(
+        {AsStringView(key.outer.data(), kBlockSize), AsStringView(inner.data(), inner.size())}, kernel
+    );
+}
+
+#ifdef PADDLE_SHA256_X86
+
+struct LaneJob {
+    BlockReader reader;
+    Sha256Digest* digest = nullptr;
+};
+
+/// Hashes the messages eight at a time, a lane takes the next message as soon as its one is done
+auto Sha256MultiBuffer(std::vector<LaneJob>& jobs) -> void {
+    const Block idle_block{};
+    std::array<State, kLanes> states;
+    std::array<State, kLanes> idle_states{};
+    std::array<State*, kLanes> state_pointers;
+    std::array<const std::uint8_t*, kLanes> blocks;
+    std::array<LaneJob*, kLanes> lane_jobs{};
+    std::size_t next_job = 0;
+    while (true) {
+        std::size_t active = 0;
+        for (std::size_t lane = 0; lane < kLanes; ++lane) {
+            blocks[lane] = nullptr;
+            while (!blocks[lane]) {
+                if (lane_jobs[lane]) {
+                    blocks[lane] = lane_jobs[lane]->reader.Next();
+                    if (blocks[lane]) {
+                        break;
+                    }
+                    *lane_jobs[lane]->digest = ToDigest(states[lane]);
+                    lane_jobs[lane] = nullptr;
+                }
+                if (next_job == jobs.size()) {
+                    break;
+                }
+                lane_jobs[lane] = &jobs[next_job++];
+                states[lane] = kInitialState;
+            }
+            if (blocks[lane]) {
+                state_pointers[lane] = &states[lane];
+                ++active;
+            } else {
+                blocks[lane] = idle_block.data();
+                state_pointers[lane] = &idle_states[lane];
+            }
+        }
+        if (active == 0) {
+            return;
+        }
+        CompressAvx2(state_pointers.data(), blocks.data());
+    }
+}
+
+auto HmacSha256Avx2(std::span<const HmacInput> inputs, std::span<Sha256Digest> digests) -> void {
+    std::vector<HmacKey> keys;
+    keys.reserve(inputs.size());
+    for (const auto& input : inputs) {
+        keys.emplace_back(input.key, Sha256Kernel::kScalar);
+    }
+    std::vector<Sha256Digest> inner(inputs.size());
+    std::vector<LaneJob> jobs(inputs.size());
+    for (std::size_t index = 0; index < inputs.size(); ++index) {
+        const auto& [first, second, third] = inputs[index].message;
+        jobs[index].reader = BlockReader{{AsStringView(keys[index].inner.data(), kBlockSize), first, second, third}};
+        jobs[index].digest = &inner[index];
+    }
+    Sha256MultiBuffer(jobs);
+    for (std::size_t index = 0; index < inputs.size(); ++index) {
+        jobs[index].reader = BlockReader{
+            {AsStringView(keys[index].outer.data(), kBlockSize), AsStringView(inner[index].data(), inner[index].size())}
+        };
+        jobs[index].digest = &digests[index];
+    }
+    Sha256MultiBuffer(jobs);
+}
+
+#endif
+
+}  // namespace
+
+auto IsSupported(Sha256Kernel kernel) -> bool {
+    switch (kernel) {
+        case Sha256Kernel::kScalar:
+            return true;
+        case Sha256Kernel::kShaNi:
+            return GetCpuFeatures().sha;
+        case Sha256Kernel::kAvx2:
+            return GetCpuFeatures().avx2;
+    }
+    return false;
+}
+
+auto GetSha256Kernel() -> Sha256Kernel {
+    return IsSupported(Sha256Kernel::kShaNi) ? Sha256Kernel::kShaNi : Sha256Kernel::kScalar;
+}
+
+auto GetBatchSha256Kernel() -> Sha256Kernel {
+    // SHA extensions hash a single message faster than AVX2 hashes eight
+    if (IsSupported(Sha256Kernel::kShaNi)) {
+        return Sha256Kernel::kShaNi;
+    }
+    if (IsSupported(Sha256Kernel::kAvx2)) {
+        return Sha256Kernel::kAvx2;
+    }
+    return Sha256Kernel::kScalar;
+}
+
+auto HmacSha256(std::string_view key, std::string_view message) -> Sha256Digest {
+    return HmacSha256(HmacInput{key, {message}}, GetSha256Kernel());
+}
+
+auto HmacSha256(const HmacInput& input) -> Sha256Digest {
+    return HmacSha256(input, GetSha256Kernel());
+}
+
+auto HmacSha256Batch(std::span<const HmacInput> inputs, std::span<Sha256Digest> digests) -> void {
+    HmacSha256Batch(inputs, digests, inputs.size() > 1 ? GetBatchSha256Kernel() : GetSha256Kernel());
+}
+
+auto HmacSha256Batch(std::span<const HmacInput> inputs, std::span<Sha256Digest> digests, Sha256Kernel kernel)
+    -> void {
+#ifdef PADDLE_SHA256_X86
+    if (kernel == Sha256Kernel::kAvx2) {
+        HmacSha256Avx2(inputs, digests);
+        return;
+    }
+#endif
+    for (std::size_t index = 0; index < inputs.size(); ++index) {
+        digests[index] = HmacSha256(inputs[index], kernel);
+    }
+}
+
+}  // namespace paddle::auth
@@ -0,0 +1,184 @@
+#include <paddle/auth/ip_allowlist.hpp>
+
+#include <fmt/format.h>
+
+#include <arpa/inet.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <stdexcept>
+
+namespace paddle {
+
+namespace {
+
+constexpr std::size_t kMaxAddressLength = 64;
+constexpr int kV4MappedPrefix = 96;
+constexpr int kMaxPrefix = 128;
+
+auto Trim(std::string_view value) -> std::string_view {
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+        value.remove_prefix(1);
+    }
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+        value.remove_suffix(1);
+    }
+    return value;
+}
+
+/// @brief Address with the host bits of the prefix set, i.e. the mask inverted
+auto HostMask(int prefix) -> IpAllowlist::Address {
+    auto half_mask = [](int bits) -> std::uint64_t {
+        if (bits <= 0) {
+            return ~std::uint64_t{0};
+        }
+        if (bits >= 64) {
+            return 0;
+        }
+        return ~std::uint64_t{0} >> bits;
+    };
+    return {half_mask(prefix), half_mask(prefix - 64)};
+}
+
+auto Next(IpAllowlist::Address address) -> std::optional<IpAllowlist::Address> {
+    if (++address.low == 0 && ++address.high == 0) {
+        return std::nullopt;
+    }
+    return address;
+}
+
+}  // namespace
+
+auto IpAllowlist::FromV4(std::uint32_t address) -> Address {
+    return {0, (std::uint64_t{0xffff} << 32) | address};
+}
+
+auto IpAllowlist::FromV6(std::span<const std::uint8_t, 16> address) -> Address {
+    Address result;
+    for (std::size_t i = 0; i < 8; ++i) {
+        result.high = (result.high << 8) | address[i];
+        result.low = (result.low << 8) | address[i + 8];
+    }
+    return result;
+}
+
+auto IpAllowlist::ParseAddress(std::string_view address) -> std::optional<Address> {
+    // inet_pton wants a null terminated string
+    if (address.empty() || address.size() >= kMaxAddressLength) {
+        return std::nullopt;
+    }
+    std::array<char, kMaxAddressLength> buffer{};
+    std::copy(address.begin(), address.end(), buffer.begin());
+    if (address.find(':') == std::string_view::npos) {
+        in_addr v4{};
+        if (inet_pton(AF_INET, buffer.data(), &v4) != 1) {
+            return std::nullopt;
+        }
+        return FromV4(ntohl(v4.s_addr));
+    }
+    in6_addr v6{};
+    if (inet_pton(AF_INET6, buffer.data(), &v6) != 1) {
+        return std::nullopt;
+    }
+    return FromV6(std::span<const std::uint8_t, 16>{v6.s6_addr});
+}
+
+IpAllowlist::IpAllowlist(const std::vector<std::string>& cidrs) {
+    intervals_.reserve(cidrs.size());
+    for (const auto& cidr : cidrs) {
+        std::string_view range = Trim(cidr);
+        auto slash = range.find('/');
+        auto address = ParseAddress(range.substr(0, slash));
+        if (!address) {
+            throw std::invalid_argument(fmt::format("Invalid address range: '{}'", cidr));
+        }
+        const bool is_v4 = range.substr(0, slash).find(':') == std::string_view::npos;
+        int prefix = kMaxPrefix;
+        if (slash != std::string_view::npos) {
+            auto length = range.substr(slash + 1);
+            auto [ptr, ec] = std::from_chars(length.data(), length.data() + length.size(), prefix);
+            if (ec != std::errc{} || ptr != length.data() + length.size() || prefix < 0 ||
+                prefix > (is_v4 ? kMaxPrefix - kV4MappedPrefix : kMaxPrefix)) {
+                throw std::invalid_argument(fmt::format("Invalid address range: '{}'", cidr));
+            }
+            if (is_v4) {
+                prefix += kV4MappedPrefix;
+            }
+        }
+        auto host_mask = HostMask(prefix);
+        Address first{address->high & ~host_mask.high, address->low & ~host_mask.low};
+        Address last{first.high | host_mask.high, first.low | host_mask.low};
+        intervals_.push_back({first, last});
+    }
+    std::sort(intervals_.begin(), intervals_.end(), [](const Interval& lhs, const Interval& rhs) {
+        return lhs.first < rhs.first;
+    });
+    // Merge the overlapping and adjacent intervals
+    std::vector<Interval> merged;
+    merged.reserve(intervals_.size());
+    for (const auto& interval : intervals_) {
+        if (!merged.empty()) {
+            auto& previous = merged.back();
+            auto after_previous = Next(previous.last);
+            if (!after_previous || interval.first <= *after_previous) {
+                previous.last = std::max(previous.last, interval.last);
+                continue;
+            }
+        }
+        merged.push_back(interval);
+    }
+    intervals_ = std::move(merged);
+}
+
+auto IpAllowlist::Contains(Address address) const -> bool {
+    // First interval starting after the address, the one before it is the only candidate
+    auto it = std::upper_bound(
+        intervals_.begin(),
+        intervals_.end(),
+        address,
+        [](const Address& value, const Interval& interval) { return value < interval.first; }
+    );
+    if (it == intervals_.begin()) {
+        return false;
+    }
+    return address <= std::prev(it)->last;
+}
+
+auto IpAllowlist::Contains(std::string_view address) const -> bool {
+    auto parsed = ParseAddress(Trim(address));
+    return parsed && Contains(*parsed);
+}
+
+auto IpAllowlist::IsEmpty() const -> bool {
+    return intervals_.empty();
+}
+
+auto IpAllowlist::GetSize() const -> std::size_t {
+    return intervals_.size();
+}
+
+auto GetForwardedAddress(std::string_view forwarded_for, std::size_t trusted_proxy_depth)
+    -> std::optional<std::string_view> {
+    if (trusted_proxy_depth == 0) {
+        return std::nullopt;
+    }
+    // Walk the entries from the right, the last one was appended by the nearest proxy
+    auto rest = forwarded_for;
+    for (std::size_t entry = 1;; ++entry) {
+        auto comma = rest.rfind(',');
+        auto address = Trim(comma == std::string_view::npos ? rest : rest.substr(comma + 1));
+        if (entry == trusted_proxy_depth) {
+            if (address.empty()) {
+                return std::nullopt;
+            }
+            return address;
+        }
+        if (comma == std::string_view::npos) {
+            return std::nullopt;
+        }
+        rest = rest.substr(0, comma);
+    }
+}
+
+}  // namespace paddle
@@ -0,0 +1,74 @@
+#include <paddle/auth/secret_refresher.hpp>
+
+#include <userver/logging/log.hpp>
+
+#include <exception>
+#include <mutex>
+
+namespace paddle::auth {
+
+SecretRefresher::SecretRefresher(SecretRefresherSettings settings, FetchFunction fetch)
+    : settings_{settings}
+    , fetch_{std::move(fetch)}
+    , unknown_paths_{settings.max_unknown_paths} {
+}
+
+auto SecretRefresher::GetGeneration() const -> std::uint64_t {
+    return generation_.load();
+}
+
+auto SecretRefresher::Update(const FetchFunction& fetch) -> void {
+    std::lock_guard lock{refresh_mutex_};
+    fetch();
+    last_refresh_ = Clock::now();
+    ++generation_;
+}
+
+auto SecretRefresher::Refresh(std::uint64_t seen_generation) -> bool {
+    std::lock_guard lock{refresh_mutex_};
+    if (generation_.load() != seen_generation) {
+        // Refreshed while we were waiting
+        return true;
+    }
+    if (Clock::now() - last_refresh_ < settings_.min_refresh_interval) {
+        return false;
+    }
+    LOG_INFO() << "Refreshing webhook secrets on demand";
+    try {
+        fetch_();
+    } catch (const std::exception& e) {
+        // Failed refreshes are rate limited as well
+        last_refresh_ = Clock::now();
+        LOG_ERROR() << "Failed to refresh webhook secrets: " << e.what();
+        return false;
+    }
+    last_refresh_ = Clock::now();
+    ++generation_;
+    return true;
+}
+
+auto SecretRefresher::IsUnknownPath(std::string_view path) -> bool {
+    const auto key = GetPathKey(path);
+    std::lock_guard lock{unknown_paths_mutex_};
+    auto* expires_at = unknown_paths_.Get(key);
+    if (!expires_at) {
+        return false;
+    }
+    if (*expires_at <= Clock::now()) {
+        unknown_paths_.Erase(key);
+        return false;
+    }
+    return true;
+}
+
+auto SecretRefresher::RememberUnknownPath(std::string_view path) -> void {
+    const auto key = GetPathKey(path);
+    std::lock_guard lock{unknown_paths_mutex_};
+    unknown_paths_.Put(key, Clock::now() + settings_.unknown_path_ttl);
+}
+
+auto SecretRefresher::GetPathKey(std::string_view path) -> std::size_t {
+    return std::hash<std::string_view>{}(path);
+}
+
+}  // namespace paddle::auth
@@ -1,9 +1,7 @@
 #include <paddle/auth/signature.hpp>
 
-#include <userver/crypto/hash.hpp>
-
-#include <fmt/format.h>
-
+#include <array>
+#include <charconv>
 #include <ctime>
 
 namespace paddle {
@@ -16,40 +14,58 @@ namespace paddle {
 // The payload is the body of the request
 // Signed payload is <timestamp>:<payload>
 // Signature is HMAC-SHA256(secret, signed payload)
-bool VerifySignature(
-    std::string_view secret,
-    std::string_view signature_header,
-    std::string_view payload,
-    std::int32_t max_age_seconds
-) {
+auto ParseSignatureHeader(std::string_view signature_header, std::int32_t max_age_seconds)
+    -> std::optional<SignatureHeader> {
     auto first_equal = signature_header.find('=');
-    if (first_equal == std::string::npos) {
-        return false;
+    if (first_equal == std::string_view::npos) {
+        return std::nullopt;
     }
     auto first_semicolon = signature_header.find(';');
-    if (first_semicolon == std::string::npos) {
-        return false;
+    if (first_semicolon == std::string_view::npos || first_semicolon < first_equal) {
+        return std::nullopt;
     }
-    std::string_view timestamp{signature_header.data() + first_equal + 1, signature_header.data() + first_semicolon};
+    auto timestamp = signature_header.substr(first_equal + 1, first_semicolon - first_equal - 1);
 
     if (max_age_seconds >= 0) {
-        const auto now = std::time(nullptr);
-        const auto ts = std::stoi(std::string{timestamp});
-        if (now - ts > max_age_seconds) {
-            return false;
+        std::int64_t ts = 0;
+        auto [end, error] = std::from_chars(timestamp.data(), timestamp.data() + timestamp.size(), ts);
+        if (error != std::errc{} || end != timestamp.data() + timestamp.size()) {
+            return std::nullopt;
+        }
+        if (std::time(nullptr) - ts > max_age_seconds) {
+            return std::nullopt;
         }
     }
 
     auto second_equal = signature_header.find('=', first_semicolon + 1);
-    if (second_equal == std::string::npos) {
+    if (second_equal == std::string_view::npos) {
+        return std::nullopt;
+    }
+    return SignatureHeader{timestamp, signature_header.substr(second_equal + 1)};
+}
+
+auto MatchesSignature(const SignatureHeader& header, const auth::Sha256Digest& digest) -> bool {
+    constexpr std::string_view kHexDigits = "0123456789abcdef";
+    std::array<char, 2 * std::tuple_size_v<auth::Sha256Digest>> hex;
+    for (std::size_t index = 0; index < digest.size(); ++index) {
+        hex[index * 2] = kHexDigits[digest[index] >> 4];
+        hex[index * 2 + 1] = kHexDigits[digest[index] & 0x0f];
+    }
+    return header.signature == std::string_view{hex.data(), hex.size()};
+}
+
+auto VerifySignature(
+    std::string_view secret,
+    std::string_view signature_header,
+    std::string_view payload,
+    std::int32_t max_age_seconds
+) -> bool {
+    auto header = ParseSignatureHeader(signature_header, max_age_seconds);
+    if (!header) {
         return false;
     }
-    std::string_view signature{
-        signature_header.data() + second_equal + 1, signature_header.data() + signature_header.size()
-    };
-    auto signed_payload = fmt::format("{}:{}", timestamp, payload);
-    auto calculated_signature = userver::crypto::hash::HmacSha256(secret, signed_payload);
-    return signature == calculated_signature;
+    auto digest = auth::HmacSha256(auth::HmacInput{secret, {header->timestamp, ":", payload}});
+    return MatchesSignature(*header, digest);
 }
 
 }  // namespace paddle
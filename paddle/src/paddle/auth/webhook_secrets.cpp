@@ -0,0 +1,107 @@
+#include <paddle/auth/webhook_secrets.hpp>
+
+#include <paddle/auth/batch_verifier.hpp>
+#include <paddle/auth/signature.hpp>
+
+#include <algorithm>
+
+namespace paddle {
+
+namespace {
+
+auto StripQuery(std::string_view path) -> std::string_view {
+    return path.substr(0, path.find('?'));
+}
+
+}  // namespace
+
+auto WebhookSecrets::Entry::AddSecret(std::string secret) -> void {
+    if (std::find(secrets.begin(), secrets.end(), secret) == secrets.end()) {
+        secrets.push_back(std::move(secret));
+    }
+}
+
+WebhookSecrets::WebhookSecrets(const std::vector<std::string>& wildcard_paths) {
+    for (std::string_view pattern : wildcard_paths) {
+        if (pattern.ends_with('*')) {
+            pattern.remove_suffix(1);
+        }
+        prefixes_.try_emplace(std::string{pattern});
+        prefix_lengths_.push_back(pattern.size());
+    }
+    std::sort(prefix_lengths_.begin(), prefix_lengths_.end(), std::greater<>{});
+    prefix_lengths_.erase(std::unique(prefix_lengths_.begin(), prefix_lengths_.end()), prefix_lengths_.end());
+}
+
+auto WebhookSecrets::Add(std::string_view path, std::string secret) -> void {
+    path = StripQuery(path);
+    for (auto& [prefix, entry] : prefixes_) {
+        if (path.starts_with(prefix)) {
+            entry.AddSecret(secret);
+        }
+    }
+    auto it = paths_.find(path);
+    if (it == paths_.end()) {
+        it = paths_.try_emplace(std::string{path}).first;
+    }
+    it->second.AddSecret(std::move(secret));
+}
+
+auto WebhookSecrets::Find(std::string_view path) const -> const Entry* {
+    if (auto it = paths_.find(path); it != paths_.end()) {
+        return &it->second;
+    }
+    for (auto length : prefix_lengths_) {
+        if (length > path.size()) {
+            continue;
+        }
+        auto it = prefixes_.find(path.substr(0, length));
+        if (it != prefixes_.end() && !it->second.secrets.empty()) {
+            return &it->second;
+        }
+    }
+    return nullptr;
+}
+
+auto WebhookSecrets::Contains(std::string_view path) const -> bool {
+    return Find(path) != nullptr;
+}
+
+auto WebhookSecrets::GetSize() const -> std::size_t {
+    return paths_.size();
+}
+
+auto WebhookSecrets::Verify(
+    std::string_view path,
+    std::string_view signature,
+    std::string_view payload,
+    std::int32_t max_age_seconds,
+    const auth::BatchVerifier* verifier
+) const -> SecretMatch {
+    const auto* entry = Find(path);
+    if (!entry) {
+        return SecretMatch::kUnknownPath;
+    }
+    const auto& secrets = entry->secrets;
+    if (verifier) {
+        auto index = verifier->Verify(secrets, signature, payload, max_age_seconds);
+        if (!index) {
+            return SecretMatch::kMismatch;
+        }
+        entry->last_verified.store(*index, std::memory_order_relaxed);
+        return SecretMatch::kVerified;
+    }
+    const auto first = entry->last_verified.load(std::memory_order_relaxed);
+    for (std::size_t offset = 0; offset < secrets.size(); ++offset) {
+        const auto index = (first + offset) % secrets.size();
+        if (VerifySignature(secrets[index], signature, payload, max_age_seconds)) {
+            if (index != first) {
+                entry->last_verified.store(index, std::memory_order_relaxed);
+            }
+            return SecretMatch::kVerified;
+        }
+    }
+    return SecretMatch::kMismatch;
+}
+
+}  // namespace paddle
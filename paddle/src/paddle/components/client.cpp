@@ -1,5 +1,8 @@
 #include <paddle/components/client.hpp>
 
+#include <paddle/types/event_query.hpp>
+#include <paddle/types/events.hpp>
+#include <paddle/types/parse.hpp>
 #include <paddle/types/price.hpp>
 #include <paddle/types/product.hpp>
 #include <paddle/types/subscriptions.hpp>
@@ -8,11 +11,24 @@
 #include <userver/clients/http/component.hpp>
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
+#include <userver/http/url.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 namespace paddle::components {
 
+namespace {
+
+auto GetEnvelope(const events::Event<JSON>& event) -> const events::Event<JSON>& {
+    return event;
+}
+
+auto GetEnvelope(const events::RawEvent& event) -> const events::Event<JSON>& {
+    return event.event;
+}
+
+}  // namespace
+
 struct Client::Impl {
     userver::components::HttpClient& http_client;
     std::string api_version;
@@ -40,10 +56,15 @@ struct Client::Impl {
     }
 
     template <typename T>
-    ResponseWithCursor<T> GetPaginated(std::string_view path, std::string_view cursor, std::int32_t per_page) const {
-        auto url = fmt::format("{}/{}?per_page={}&order_by=id[ASC]", base_url, path, per_page);
+    ResponseWithCursor<T> GetPaginated(
+        std::string_view path,
+        std::string_view cursor,
+        std::int32_t per_page,
+        std::string_view parameters = {}
+    ) const {
+        auto url = fmt::format("{}/{}?per_page={}&order_by=id[ASC]{}", base_url, path, per_page, parameters);
         if (!cursor.empty()) {
-            url += fmt::format("&after={}", cursor);
+            url += fmt::format("&after={}", userver::http::UrlEncode(cursor));
         }
         auto http_response = http_client.GetHttpClient()
                                  .CreateRequest()
@@ -56,18 +77,35 @@ struct Client::Impl {
                                  .perform();
         ThrowIfNotOk(http_response, url, "get paginated");
         auto body = http_response->body();
-        auto json = userver::formats::json::FromString(body);
-        auto response = json.As<Response<T, MetaPaginated>>();
-        // Now we need to find the next cursor
-        // The cursor is in meta.pagination.next
-        // We need to extract the cursor from the next field, which is a url
-        // that has ?after=<cursor>
-        auto pos = response.meta.pagination.next.find("after=");
-        if (pos == std::string::npos) {
+        auto response = ParseJson<Response<T, MetaPaginated>>(body);
+        // The next page URL repeats the query parameters, only the cursor is kept
+        auto next_cursor = response.meta.pagination.GetNextCursor();
+        if (!next_cursor) {
             return {std::move(response.data), {}, false};
         }
-        auto next_cursor = response.meta.pagination.next.substr(pos + 6);
-        return {std::move(response.data), next_cursor, response.meta.pagination.has_more};
+        return {std::move(response.data), std::move(*next_cursor), response.meta.pagination.has_more};
+    }
+
+    template <typename Result>
+    Result Get(std::string_view path, std::string_view operation) const {
+        auto request_path = fmt::format("{}/{}", base_url, path);
+        auto response = http_client.GetHttpClient()
+                            .CreateRequest()
+                            .get(request_path)
+                            .headers({
+                                {"Authorization", api_key},
+                                {"Paddle-Api-Version", api_version},
+                            })
+                            .timeout(std::chrono::seconds(30))
+                            .perform();
+        ThrowIfNotOk(response, request_path, operation);
+        auto body = response->body();
+        try {
+            return ParseJson<Result>(body);
+        } catch (const std::exception& e) {
+            LOG_ERROR() << fmt::format("Failed to parse response for {}: {}\n{}", operation, e.what(), body);
+            throw;
+        }
     }
 
     template <typename Result, typename Request>
@@ -87,8 +125,31 @@ struct Client::Impl {
         ThrowIfNotOk(response, request_path, operation);
         auto body = response->body();
         try {
-            auto result = userver::formats::json::FromString(body).template As<Result>();
-            return result;
+            return ParseJson<Result>(body);
+        } catch (const std::exception& e) {
+            LOG_ERROR() << fmt::format("Failed to parse response for {}: {}\n{}", operation, e.what(), body);
+            throw;
+        }
+    }
+
+    template <typename Result, typename Request>
+    Result Patch(std::string_view path, std::string_view operation, const Request& request) const {
+        auto request_body = Serialize(request, userver::formats::serialize::To<JSON>{});
+        auto request_path = fmt::format("{}/{}", base_url, path);
+        auto response = http_client.GetHttpClient()
+                            .CreateRequest()
+                            .patch(request_path, ToString(request_body))
+                            .headers({
+                                {"Authorization", api_key},
+                                {"Paddle-Api-Version", api_version},
+                                {"Content-Type", "application/json"},
+                            })
+                            .timeout(std::chrono::seconds(30))
+                            .perform();
+        ThrowIfNotOk(response, request_path, operation);
+        auto body = response->body();
+        try {
+            return ParseJson<Result>(body);
         } catch (const std::exception& e) {
             LOG_ERROR() << fmt::format("Failed to parse response for {}: {}\n{}", operation, e.what(), body);
             throw;
@@ -118,6 +179,23 @@ struct Client::Impl {
         return GetPaginated<NotificationSetting>("notification-settings", cursor, per_page);
     }
 
+    NotificationSetting
+    UpdateNotificationSetting(const NotificationSettingId& id, const NotificationSettingUpdate& update) const {
+        return Patch<SingleObjectResponse<NotificationSetting, Meta>>(
+                   fmt::format("notification-settings/{}", id), "update notification setting", update
+        )
+            .data;
+    }
+
+    ResponseWithCursor<Notification>
+    GetNotifications(std::string_view cursor, const NotificationQuery& query, std::int32_t per_page) const {
+        return GetPaginated<Notification>("notifications", cursor, per_page, query.GetQueryParameters());
+    }
+
+    IpAddresses GetIpAddresses() const {
+        return Get<SingleObjectResponse<IpAddresses, Meta>>("ips", "get ip addresses").data;
+    }
+
     std::vector<events::Event<JSON>> GetAllEvents() const {
         return GetAll<events::Event<JSON>>("events", 200);
     }
@@ -126,6 +204,33 @@ struct Client::Impl {
         return GetPaginated<events::Event<JSON>>("events", cursor, per_page);
     }
 
+    ResponseWithCursor<events::RawEvent> GetRawEvents(std::string_view cursor, std::int32_t per_page) const {
+        return GetPaginated<events::RawEvent>("events", cursor, per_page);
+    }
+
+    /// Event types are filtered by Paddle, the rest of the query is checked here
+    template <typename T>
+    ResponseWithCursor<T> GetSelectedEvents(
+        std::string_view cursor,
+        const events::EventQuery& query,
+        std::int32_t per_page
+    ) const {
+        auto [events, next_cursor, has_more] =
+            GetPaginated<T>("events", query.GetStartCursor(cursor), per_page, query.GetQueryParameters());
+        std::vector<T> selected;
+        selected.reserve(events.size());
+        for (auto& event : events) {
+            if (query.IsPastRange(GetEnvelope(event))) {
+                has_more = false;
+                break;
+            }
+            if (query.Matches(GetEnvelope(event))) {
+                selected.push_back(std::move(event));
+            }
+        }
+        return {std::move(selected), std::move(next_cursor), has_more};
+    }
+
     ResponseWithCursor<products::JsonProduct> GetProducts(std::string_view cursor, std::int32_t per_page) const {
         return GetPaginated<products::JsonProduct>("products", cursor, per_page);
     }
@@ -188,6 +293,25 @@ ResponseWithCursor<NotificationSetting> Client::GetNotificationSettings(std::str
     return impl_->GetNotificationSettings(cursor, per_page);
 }
 
+NotificationSetting Client::UpdateNotificationSetting(
+    const NotificationSettingId& id,
+    const NotificationSettingUpdate& update
+) const {
+    return impl_->UpdateNotificationSetting(id, update);
+}
+
+ResponseWithCursor<Notification> Client::GetNotifications(
+    std::string_view cursor,
+    const NotificationQuery& query,
+    std::int32_t per_page
+) const {
+    return impl_->GetNotifications(cursor, query, per_page);
+}
+
+IpAddresses Client::GetIpAddresses() const {
+    return impl_->GetIpAddresses();
+}
+
 std::vector<events::Event<JSON>> Client::GetAllEvents() const {
     return impl_->GetAllEvents();
 }
@@ -196,6 +320,26 @@ ResponseWithCursor<events::Event<JSON>> Client::GetEvents(std::string_view curso
     return impl_->GetEvents(cursor, per_page);
 }
 
+ResponseWithCursor<events::RawEvent> Client::GetRawEvents(std::string_view cursor, std::int32_t per_page) const {
+    return impl_->GetRawEvents(cursor, per_page);
+}
+
+ResponseWithCursor<events::Event<JSON>> Client::GetEvents(
+    std::string_view cursor,
+    const events::EventQuery& query,
+    std::int32_t per_page
+) const {
+    return impl_->GetSelectedEvents<events::Event<JSON>>(cursor, query, per_page);
+}
+
+ResponseWithCursor<events::RawEvent> Client::GetRawEvents(
+    std::string_view cursor,
+    const events::EventQuery& query,
+    std::int32_t per_page
+) const {
+    return impl_->GetSelectedEvents<events::RawEvent>(cursor, query, per_page);
+}
+
 std::vector<products::JsonProduct> Client::GetAllProducts() const {
     return impl_->GetAllProducts();
 }
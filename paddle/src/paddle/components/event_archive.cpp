@@ -0,0 +1,122 @@
+#include <paddle/components/event_archive.hpp>
+
+#include <paddle/archive/event_log.hpp>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <memory>
+#include <utility>
+
+namespace paddle::components {
+
+namespace engine = userver::engine;
+
+namespace {
+
+constexpr auto kDefaultFsTaskProcessor = "fs-task-processor";
+
+auto ParseEvent(const std::string& raw_event) -> events::RawEvent {
+    return userver::formats::json::FromString(raw_event).As<events::RawEvent>();
+}
+
+auto ParseEvents(const std::vector<std::string>& raw_events) -> std::vector<events::RawEvent> {
+    std::vector<events::RawEvent> events;
+    events.reserve(raw_events.size());
+    for (const auto& raw_event : raw_events) {
+        events.push_back(ParseEvent(raw_event));
+    }
+    return events;
+}
+
+}  // namespace
+
+struct EventArchive::Impl {
+    engine::TaskProcessor& fs_task_processor;
+    std::unique_ptr<archive::EventLog> log;
+
+    Impl(const userver::components::ComponentConfig& config, const userver::components::ComponentContext& context)
+        : fs_task_processor{
+              context.GetTaskProcessor(config["fs_task_processor"].As<std::string>(kDefaultFsTaskProcessor))
+          } {
+        archive::EventLogSettings settings;
+        settings.directory = config["directory"].As<std::string>();
+        settings.segment_max_size = config["segment_max_size"].As<std::uint64_t>(settings.segment_max_size);
+        log = RunBlocking([&settings] { return std::make_unique<archive::EventLog>(std::move(settings)); });
+    }
+
+    ~Impl() {
+        RunBlocking([this] { log.reset(); });
+    }
+
+    /// File IO runs on the fs task processor, JSON is parsed by the caller
+    template <typename Function>
+    auto RunBlocking(Function&& function) const {
+        return engine::AsyncNoSpan(fs_task_processor, std::forward<Function>(function)).Get();
+    }
+};
+
+EventArchive::EventArchive(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context
+)
+    : BaseType{config, context}
+    , impl_{config, context} {
+}
+
+EventArchive::~EventArchive() = default;
+
+auto EventArchive::GetStaticConfigSchema() -> userver::yaml_config::Schema {
+    return userver::yaml_config::MergeSchemas<BaseType>(R"(
+type: object
+description: Paddle event archive component
+additionalProperties: false
+properties:
+    directory:
+        type: string
+        description: Directory of the archive segment files
+    segment_max_size:
+        type: integer
+        minimum: 1
+        description: Segment file size in bytes after which a new segment is started (64MiB by default)
+    fs_task_processor:
+        type: string
+        description: Task processor for the file IO (fs-task-processor by default)
+    )");
+}
+
+auto EventArchive::Append(std::string_view raw_event) const -> bool {
+    return impl_->RunBlocking([this, raw_event] { return impl_->log->Append(raw_event); });
+}
+
+auto EventArchive::Append(const events::RawEvent& event) const -> bool {
+    return Append(userver::formats::json::ToString(event.json));
+}
+
+auto EventArchive::Contains(const EventId& event_id) const -> bool {
+    return impl_->RunBlocking([this, &event_id] { return impl_->log->Contains(event_id.ToString()); });
+}
+
+auto EventArchive::GetEvent(const EventId& event_id) const -> std::optional<events::RawEvent> {
+    auto raw_event = impl_->RunBlocking([this, &event_id] { return impl_->log->Find(event_id.ToString()); });
+    if (!raw_event) {
+        return std::nullopt;
+    }
+    return ParseEvent(*raw_event);
+}
+
+auto EventArchive::GetEvents(std::string_view cursor, const events::EventQuery& query, std::size_t per_page) const
+    -> ResponseWithCursor<events::RawEvent> {
+    auto [raw_events, next_cursor, have_more] =
+        impl_->RunBlocking([this, cursor, &query, per_page] { return impl_->log->Read(cursor, query, per_page); });
+    return {ParseEvents(raw_events), std::move(next_cursor), have_more};
+}
+
+auto EventArchive::GetEntityHistory(std::string_view entity_id) const -> std::vector<events::RawEvent> {
+    return ParseEvents(impl_->RunBlocking([this, entity_id] { return impl_->log->GetEntityHistory(entity_id); }));
+}
+
+}  // namespace paddle::components
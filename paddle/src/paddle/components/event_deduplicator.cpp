@@ -0,0 +1,98 @@
+#include <paddle/components/event_deduplicator.hpp>
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <chrono>
+#include <mutex>
+
+namespace paddle::components {
+
+namespace {
+
+constexpr std::size_t kDefaultMaxSize = 100000;
+constexpr std::chrono::seconds kDefaultTtl{3600};
+
+struct EventState {
+    bool in_progress;
+    std::chrono::steady_clock::time_point updated_at;
+};
+
+}  // namespace
+
+struct EventDeduplicator::Impl {
+    std::chrono::milliseconds ttl;
+    mutable userver::engine::Mutex mutex;
+    mutable userver::cache::LruMap<EventId, EventState> events;
+
+    Impl(const userver::components::ComponentConfig& config)
+        : ttl{config["ttl"].As<std::chrono::milliseconds>(kDefaultTtl)}
+        , events{config["max_size"].As<std::size_t>(kDefaultMaxSize)} {
+    }
+
+    auto TryBegin(const EventId& event_id) const -> bool {
+        const auto now = std::chrono::steady_clock::now();
+        std::lock_guard lock{mutex};
+        auto* state = events.Get(event_id);
+        if (state && (state->in_progress || now - state->updated_at < ttl)) {
+            LOG_INFO() << "Duplicate event " << event_id << (state->in_progress ? " is in progress" : " was processed");
+            return false;
+        }
+        events.Put(event_id, EventState{true, now});
+        return true;
+    }
+
+    auto Complete(const EventId& event_id) const -> void {
+        std::lock_guard lock{mutex};
+        events.Put(event_id, EventState{false, std::chrono::steady_clock::now()});
+    }
+
+    auto Abort(const EventId& event_id) const -> void {
+        std::lock_guard lock{mutex};
+        events.Erase(event_id);
+    }
+};
+
+EventDeduplicator::EventDeduplicator(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context
+)
+    : BaseType{config, context}
+    , impl_{config} {
+}
+
+EventDeduplicator::~EventDeduplicator() = default;
+
+auto EventDeduplicator::GetStaticConfigSchema() -> userver::yaml_config::Schema {
+    return userver::yaml_config::MergeSchemas<BaseType>(R"(
+type: object
+description: Paddle event deduplicator component
+additionalProperties: false
+properties:
+    max_size:
+        type: integer
+        minimum: 1
+        description: Maximum number of remembered events (100000 by default)
+    ttl:
+        type: string
+        description: How long a processed event is remembered (1h by default)
+    )");
+}
+
+auto EventDeduplicator::TryBegin(const EventId& event_id) const -> bool {
+    return impl_->TryBegin(event_id);
+}
+
+auto EventDeduplicator::Complete(const EventId& event_id) const -> void {
+    impl_->Complete(event_id);
+}
+
+auto EventDeduplicator::Abort(const EventId& event_id) const -> void {
+    impl_->Abort(event_id);
+}
+
+}  // namespace paddle::components
@@ -1,44 +1,44 @@
 #include <paddle/components/event_replay_controller.hpp>
 
 #include <paddle/components/client.hpp>
+#include <paddle/components/event_archive.hpp>
+#include <paddle/components/replay_checkpoint_store.hpp>
 
-#include <paddle/handlers/address_handler_base.hpp>
-#include <paddle/handlers/api_key_handler_base.hpp>
-#include <paddle/handlers/business_handler_base.hpp>
-#include <paddle/handlers/client_token_handler_base.hpp>
-#include <paddle/handlers/customer_handler_base.hpp>
-#include <paddle/handlers/payment_method_handler_base.hpp>
-#include <paddle/handlers/price_handler_base.hpp>
-#include <paddle/handlers/product_handler_base.hpp>
-#include <paddle/handlers/subscription_handler_base.hpp>
-#include <paddle/handlers/transaction_handler_base.hpp>
-
+#include <paddle/handlers/event_dispatcher.hpp>
 #include <paddle/handlers/handlers.hpp>
+#include <paddle/handlers/replay_throttle.hpp>
 
-#include <paddle/types/api_keys.hpp>
-#include <paddle/types/client_token.hpp>
-#include <paddle/types/customers.hpp>
+#include <paddle/types/event_query.hpp>
 #include <paddle/types/events.hpp>
-#include <paddle/types/price.hpp>
-#include <paddle/types/product.hpp>
-#include <paddle/types/subscriptions.hpp>
-#include <paddle/types/transactions.hpp>
 
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
-#include <userver/concurrent/background_task_storage.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/formats/serialize/to.hpp>
 #include <userver/logging/log.hpp>
-#include <userver/server/handlers/exceptions.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/utils/cpu_relax.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 #include <fmt/format.h>
-#include <iostream>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 
 namespace paddle::components {
 
+namespace engine = userver::engine;
 namespace tracing = userver::tracing;
 
 namespace {
@@ -46,90 +46,345 @@ namespace {
 constexpr auto kEventPerBatch = 200;
 constexpr auto kCpuRelaxIterations = 10;
 constexpr auto kReplayScopeName = "replay-events";
+constexpr auto kReplayLaneTaskName = "replay-lane";
+constexpr auto kFetchEventsTaskName = "replay-fetch-events";
+constexpr std::size_t kDefaultConcurrency = 1;
+
+using EventsPage = ResponseWithCursor<events::RawEvent>;
+
+/// Indices of the page events grouped by entity, each lane keeps the page order
+auto PartitionByEntity(const std::vector<events::RawEvent>& events) -> std::vector<std::vector<std::size_t>> {
+    std::vector<std::vector<std::size_t>> lanes;
+    std::unordered_map<std::string, std::size_t> lane_by_entity;
+    for (std::size_t index = 0; index < events.size(); ++index) {
+        const auto& event = events[index].event;
+        auto entity_id = event.data["id"].As<std::string>("");
+        if (entity_id.empty()) {
+            entity_id = event.event_id.ToString();
+        }
+        auto [it, inserted] = lane_by_entity.try_emplace(std::move(entity_id), lanes.size());
+        if (inserted) {
+            lanes.emplace_back();
+        }
+        lanes[it->second].push_back(index);
+    }
+    return lanes;
+}
+
+/// Tracks replayed events of a page and reports them in the page order,
+/// an event is reported only when all the events before it are replayed
+class PageProgress {
+public:
+    PageProgress(
+        const std::vector<events::RawEvent>& events,
+        const EventReplayController::ReplayInfoCallback& callback
+    )
+        : events_{events}
+        , callback_{callback}
+        , replayed_(events.size(), false) {
+    }
+
+    void Complete(std::size_t index) {
+        std::lock_guard lock{mutex_};
+        replayed_[index] = true;
+        while (watermark_ < replayed_.size() && replayed_[watermark_]) {
+            if (callback_) {
+                callback_(events_[watermark_].event);
+            }
+            ++watermark_;
+        }
+    }
+
+    void Fail(std::exception_ptr error) {
+        std::lock_guard lock{mutex_};
+        if (!error_) {
+            error_ = std::move(error);
+        }
+        failed_ = true;
+    }
+
+    /// @return number of leading events replayed
+    [[nodiscard]] auto GetWatermark() const -> std::size_t {
+        std::lock_guard lock{mutex_};
+        return watermark_;
+    }
+
+    [[nodiscard]] auto IsFailed() const -> bool {
+        return failed_.load();
+    }
+
+    void RethrowIfFailed() const {
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+private:
+    const std::vector<events::RawEvent>& events_;
+    const EventReplayController::ReplayInfoCallback& callback_;
+    mutable engine::Mutex mutex_;
+    std::vector<bool> replayed_;
+    std::size_t watermark_ = 0;
+    std::atomic<bool> failed_{false};
+    std::exception_ptr error_;
+};
+
+auto FindCheckpointStore(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context
+) -> const ReplayCheckpointStore* {
+    auto name = config["checkpoint"].As<std::string>("");
+    if (name.empty()) {
+        return nullptr;
+    }
+    return &context.FindComponent<ReplayCheckpointStore>(name);
+}
+
+auto FindArchive(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context
+) -> const EventArchive* {
+    auto name = config["archive"].As<std::string>("");
+    if (name.empty()) {
+        return nullptr;
+    }
+    return &context.FindComponent<EventArchive>(name);
+}
 
 }  // namespace
 
+auto GetPageCheckpoint(
+    const events::EventQuery& query,
+    const ReplayOptions& options,
+    const std::vector<events::RawEvent>& events,
+    std::size_t replayed,
+    std::string_view page_cursor
+) -> std::optional<std::string> {
+    // The page cursor of a filtered replay points past the events the query didn't select
+    if (!options.save_checkpoint || options.from_archive || !query.IsEmpty()) {
+        return std::nullopt;
+    }
+    if (replayed == events.size() && !page_cursor.empty()) {
+        return std::string{page_cursor};
+    }
+    if (replayed > 0) {
+        return events[replayed - 1].event.event_id.ToString();
+    }
+    return std::nullopt;
+}
+
 struct EventReplayController::Impl {
+    using FetchPage = std::function<EventsPage(std::string_view cursor)>;
+
+    struct ReplayLimits {
+        std::size_t concurrency;
+        /// Rate limit of a single replay, null if none
+        handlers::ReplayThrottle* throttle;
+    };
+
     Client& client;
-    handlers::Handlers handlers;
+    std::size_t concurrency;
+    const ReplayCheckpointStore* checkpoint;
+    std::string checkpoint_key;
+    const EventArchive* archive;
+    mutable handlers::ReplayThrottle throttle;
+    handlers::EventDispatcher dispatcher;
 
     Impl(const userver::components::ComponentConfig& config, const userver::components::ComponentContext& context)
         : client{context.FindComponent<Client>(config["client_name"].As<std::string>("paddle-client"))}
-        , handlers{config, context} {
+        , concurrency{std::max<std::size_t>(config["concurrency"].As<std::size_t>(kDefaultConcurrency), 1)}
+        , checkpoint{FindCheckpointStore(config, context)}
+        , checkpoint_key{config.Name()}
+        , archive{FindArchive(config, context)}
+        , throttle{config["throttle"].As<handlers::ReplayThrottleSettings>(handlers::ReplayThrottleSettings{})}
+        , dispatcher{config, context, [this](events::EventTypeName, std::chrono::milliseconds elapsed) {
+            throttle.Account(elapsed);
+        }} {
+        if (config["catch_up_on_start"].As<bool>(false)) {
+            CatchUp(config["catch_up_from"].As<std::string>());
+        }
+    }
+
+    auto GetCheckpointStore() const -> const ReplayCheckpointStore& {
+        if (!checkpoint) {
+            throw std::runtime_error("Replay checkpoint store is not configured");
+        }
+        return *checkpoint;
+    }
+
+    /// Replays the events missed by the webhook handler while the service was down
+    void CatchUp(const std::string& webhook_name) const {
+        const auto& store = GetCheckpointStore();
+        auto cursor = store.Load(webhook_name);
+        if (!cursor) {
+            LOG_WARNING() << "No events processed by " << webhook_name << " yet, nothing to catch up with";
+            return;
+        }
+        LOG_INFO() << "Catching up with the events after " << *cursor << " processed by " << webhook_name;
+        ReplayOptions options;
+        options.save_checkpoint = true;
+        ReplaySince(*cursor, events::EventQuery{}, options, [&store, &webhook_name](const events::Event<JSON>& event) {
+            store.Advance(webhook_name, event.event_id);
+        });
+        store.Flush();
+    }
+
+    void Resume(const ReplayInfoCallback& callback) const {
+        auto cursor = GetCheckpointStore().Load(checkpoint_key);
+        if (!cursor) {
+            throw std::runtime_error(fmt::format("No replay checkpoint for {}", checkpoint_key));
+        }
+        ReplayOptions options;
+        options.save_checkpoint = true;
+        ReplaySince(*cursor, events::EventQuery{}, options, callback);
     }
 
     void Replay(const JSON& event_json, events::Event<JSON>&& event) const {
         LOG_INFO() << "Replay event: " << event.event_type << " " << event.event_id << " " << event.occurred_at;
-        auto category = events::GetEventCategory(event.event_type);
-        switch (category) {
-            case events::EventCategory::kTransaction:
-                HandleEvent(event_json, std::move(event), handlers.transaction_handler);
-                break;
-            case events::EventCategory::kSubscription:
-                HandleEvent(event_json, std::move(event), handlers.subscription_handler);
-                break;
-            case events::EventCategory::kCustomer:
-                HandleEvent(event_json, std::move(event), handlers.customer_handler);
-                break;
-            case events::EventCategory::kPaymentMethod:
-                HandleEvent(event_json, std::move(event), handlers.payment_method_handler);
-                break;
-            case events::EventCategory::kPrice:
-                HandleEvent(event_json, std::move(event), handlers.price_handler);
-                break;
-            case events::EventCategory::kProduct:
-                HandleEvent(event_json, std::move(event), handlers.product_handler);
-                break;
-            case events::EventCategory::kAddress:
-                HandleEvent(event_json, std::move(event), handlers.address_handler);
-                break;
-            case events::EventCategory::kBusiness:
-                HandleEvent(event_json, std::move(event), handlers.business_handler);
-                break;
-            case events::EventCategory::kApiKey:
-                HandleEvent(event_json, std::move(event), handlers.api_key_handler);
-                break;
-            case events::EventCategory::kClientToken:
-                HandleEvent(event_json, std::move(event), handlers.client_token_handler);
-                break;
-            default:
-                LOG_INFO() << "Event category not supported: " << category;
-                break;
+        auto event_type = event.event_type;
+        if (dispatcher.Dispatch(event_json, std::move(event)) == handlers::DispatchResult::kUnsupported) {
+            LOG_INFO() << "Event category not supported: " << events::GetEventCategory(event_type);
         }
     }
 
-    template <typename T>
-    void HandleEvent(const JSON& event_json, events::Event<JSON>&& event, T* handler) const {
-        using EventType = typename T::EventType;
-        using PayloadType = typename EventType::PayloadType;
-        if (handler) {
-            auto event_with_payload = events::ParsePayload<PayloadType>(std::move(event));
-            handler->HandleEvent(event_json, std::move(event_with_payload));
-            return;
+    void ReplaySince(std::string_view cursor, const events::EventQuery& query, const ReplayInfoCallback& callback)
+        const {
+        ReplaySince(cursor, query, ReplayOptions{}, callback);
+    }
+
+    void ReplaySince(
+        std::string_view cursor,
+        const events::EventQuery& query,
+        const ReplayOptions& options,
+        const ReplayInfoCallback& callback
+    ) const {
+        if (options.from_archive && !archive) {
+            throw std::runtime_error("Event archive is not configured");
+        }
+        const auto job_concurrency = std::max<std::size_t>(options.concurrency.value_or(concurrency), 1);
+        LOG_INFO() << "Replay " << (options.from_archive ? "from archive " : "") << "since: " << cursor
+                   << ", concurrency: " << job_concurrency << (query.IsEmpty() ? "" : ", filtered");
+        // Paces this replay only, the shared throttle applies as well
+        std::optional<handlers::ReplayThrottle> job_throttle;
+        if (options.max_rate > 0) {
+            handlers::ReplayThrottleSettings settings;
+            settings.max_rate = options.max_rate;
+            job_throttle.emplace(settings);
         }
-        LOG_INFO() << "No event handler configured for event category: " << T::kEventCategory;
+        FetchPage fetch;
+        if (options.from_archive) {
+            fetch = [this, &query](std::string_view page_cursor) {
+                return archive->GetEvents(page_cursor, query, kEventPerBatch);
+            };
+        } else {
+            fetch = [this, &query](std::string_view page_cursor) { return FetchEvents(page_cursor, query); };
+        }
+        const ReplayLimits limits{job_concurrency, job_throttle ? &*job_throttle : nullptr};
+        ReplayPages(cursor, query, options, fetch, limits, callback);
     }
 
-    void ReplaySince(std::string_view cursor, ReplayInfoCallback callback) const {
-        LOG_INFO() << "Replay since: " << cursor;
-        auto have_more = true;
+    /// Fetched events are archived, so that the next replay doesn't need the API
+    auto FetchEvents(std::string_view cursor, const events::EventQuery& query) const -> EventsPage {
+        auto page = client.GetRawEvents(cursor, query, kEventPerBatch);
+        if (archive) {
+            try {
+                for (const auto& event : std::get<0>(page)) {
+                    archive->Append(event);
+                }
+            } catch (const std::exception& e) {
+                LOG_ERROR() << "Failed to archive fetched events: " << e.what();
+            }
+        }
+        return page;
+    }
+
+    void ReplayPages(
+        std::string_view cursor,
+        const events::EventQuery& query,
+        const ReplayOptions& options,
+        const FetchPage& fetch,
+        const ReplayLimits& limits,
+        const ReplayInfoCallback& callback
+    ) const {
         tracing::ScopeTime scope_time{kReplayScopeName};
-        userver::utils::CpuRelax cpu_relax{kCpuRelaxIterations, &scope_time};
-        while (have_more) {
-            auto [events, next_cursor, next_have_more] = client.GetEvents(cursor, kEventPerBatch);
-            for (auto& event : events) {
-                // Not too efficient, but we don't want some ugly signatures
-                // Anyway, this is not a hot path
-                auto json = Serialize(event, userver::formats::serialize::To<JSON>());
-                if (callback) {
-                    callback(event);
+        auto page = fetch(cursor);
+        while (true) {
+            auto& [events, next_cursor, have_more] = page;
+            // Fetch the next page while the current one is replayed
+            std::optional<engine::TaskWithResult<EventsPage>> next_page;
+            if (have_more) {
+                next_page = userver::utils::Async(kFetchEventsTaskName, [&fetch, next_cursor = next_cursor] {
+                    return fetch(next_cursor);
+                });
+            }
+            // Pages are replayed one by one, so that events of an entity spanning
+            // several pages stay in order
+            ReplayPage(events, next_cursor, query, options, limits, callback);
+            if (!next_page) {
+                break;
+            }
+            page = next_page->Get();
+        }
+    }
+
+    /// @param page_cursor cursor after the page, see GetPageCheckpoint
+    void ReplayPage(
+        const std::vector<events::RawEvent>& events,
+        std::string_view page_cursor,
+        const events::EventQuery& query,
+        const ReplayOptions& options,
+        const ReplayLimits& limits,
+        const ReplayInfoCallback& callback
+    ) const {
+        const auto lanes = PartitionByEntity(events);
+        PageProgress progress{events, callback};
+        std::atomic<std::size_t> next_lane{0};
+        auto replay_lanes = [&] {
+            userver::utils::CpuRelax cpu_relax{kCpuRelaxIterations, nullptr};
+            for (auto lane = next_lane++; lane < lanes.size(); lane = next_lane++) {
+                for (auto index : lanes[lane]) {
+                    // Events of an entity after a failed one must not be replayed out of order
+                    if (progress.IsFailed()) {
+                        return;
+                    }
+                    const auto& [event_json, event] = events[index];
+                    try {
+                        if (limits.throttle) {
+                            limits.throttle->Acquire();
+                        }
+                        throttle.Acquire();
+                        Replay(event_json, events::Event<JSON>{event});
+                    } catch (const std::exception& e) {
+                        LOG_ERROR() << "Failed to replay event " << event.event_id << ": " << e.what();
+                        progress.Fail(std::current_exception());
+                        return;
+                    }
+                    progress.Complete(index);
+                    // Only yields when the throttle does not make the worker wait anyway
+                    cpu_relax.Relax();
                 }
-                Replay(json, std::move(event));
-                cpu_relax.Relax();
             }
-            cursor = next_cursor;
-            have_more = next_have_more;
+        };
+        const auto worker_count = std::min(limits.concurrency, lanes.size());
+        if (worker_count <= 1) {
+            replay_lanes();
+        } else {
+            std::vector<engine::TaskWithResult<void>> workers;
+            workers.reserve(worker_count);
+            for (std::size_t i = 0; i < worker_count; ++i) {
+                workers.push_back(userver::utils::Async(kReplayLaneTaskName, replay_lanes));
+            }
+            for (auto& worker : workers) {
+                worker.Get();
+            }
+        }
+        if (checkpoint) {
+            // Saved on failure as well, the checkpoint only covers the completed prefix
+            if (auto saved = GetPageCheckpoint(query, options, events, progress.GetWatermark(), page_cursor)) {
+                checkpoint->Save(checkpoint_key, *saved);
+            }
         }
+        progress.RethrowIfFailed();
     }
 };
 
@@ -154,8 +409,34 @@ properties:
         type: string
         description: |
             name of the Paddle client component (default: paddle-client)
-{})",
-        handlers::Handlers::GetHanderNames()
+    concurrency:
+        type: integer
+        minimum: 1
+        description: |
+            Number of entities replayed concurrently, events of the same entity are always
+            replayed in order (default: 1, fully serial replay)
+    checkpoint:
+        type: string
+        description: |
+            Replay checkpoint store component name, the id of the last replayed event is
+            saved after every page under the name of this component
+    catch_up_on_start:
+        type: boolean
+        description: |
+            Replay the events missed by the webhook handler before the service starts
+            (requires checkpoint and catch_up_from)
+    catch_up_from:
+        type: string
+        description: Name of the webhook handler component whose checkpoint the catch-up starts from
+    archive:
+        type: string
+        description: |
+            Event archive component name, the events fetched from Paddle are archived and
+            ReplayFromArchive replays the archived ones
+{}{}{})",
+        handlers::Handlers::GetHanderNames(),
+        handlers::ReplayThrottle::GetConfigSchema(),
+        handlers::EventDispatcher::GetConfigSchema()
     ));
 }
 
@@ -164,8 +445,61 @@ void EventReplayController::Replay(events::Event<JSON>&& event) const {
     impl_->Replay(event_json, std::move(event));
 }
 
+void EventReplayController::Replay(events::RawEvent&& event) const {
+    impl_->Replay(event.json, std::move(event.event));
+}
+
 void EventReplayController::ReplaySince(std::string_view cursor, ReplayInfoCallback callback) const {
-    impl_->ReplaySince(cursor, callback);
+    ReplayOptions options;
+    options.save_checkpoint = true;
+    impl_->ReplaySince(cursor, events::EventQuery{}, options, callback);
+}
+
+void EventReplayController::ReplaySince(
+    std::string_view cursor,
+    const events::EventQuery& query,
+    ReplayInfoCallback callback
+) const {
+    impl_->ReplaySince(cursor, query, callback);
+}
+
+void EventReplayController::ReplaySince(
+    std::string_view cursor,
+    const events::EventQuery& query,
+    const ReplayOptions& options,
+    ReplayInfoCallback callback
+) const {
+    impl_->ReplaySince(cursor, query, options, callback);
+}
+
+void EventReplayController::ReplayFromArchive(
+    std::string_view cursor,
+    const events::EventQuery& query,
+    ReplayInfoCallback callback
+) const {
+    ReplayOptions options;
+    options.from_archive = true;
+    impl_->ReplaySince(cursor, query, options, callback);
+}
+
+void EventReplayController::Resume(ReplayInfoCallback callback) const {
+    impl_->Resume(callback);
+}
+
+void EventReplayController::SetPaused(bool paused) const {
+    if (paused) {
+        impl_->throttle.Pause();
+    } else {
+        impl_->throttle.Resume();
+    }
+}
+
+auto EventReplayController::IsPaused() const -> bool {
+    return impl_->throttle.IsPaused();
+}
+
+auto EventReplayController::GetRate() const -> double {
+    return impl_->throttle.GetRate();
 }
 
 }  // namespace paddle::components
\ No newline at end of file
@@ -0,0 +1,242 @@
+#include <paddle/components/failed_notification_reconciler.hpp>
+
+#include <paddle/components/client.hpp>
+#include <paddle/components/event_deduplicator.hpp>
+
+#include <paddle/handlers/event_dispatcher.hpp>
+#include <paddle/handlers/handlers.hpp>
+
+#include <paddle/types/events.hpp>
+#include <paddle/types/notifications.hpp>
+
+#include <userver/cache/lru_set.hpp>
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/datetime.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <fmt/format.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace paddle::components {
+
+namespace engine = userver::engine;
+namespace statistics = userver::utils::statistics;
+
+namespace {
+
+constexpr auto kStatisticsPrefix = "paddle.reconciler";
+constexpr auto kReconcileTaskName = "paddle-reconcile-notifications";
+constexpr auto kNotificationsPerPage = 200;
+constexpr std::chrono::milliseconds kDefaultInterval{std::chrono::minutes{1}};
+constexpr std::chrono::milliseconds kDefaultLookback{std::chrono::hours{24}};
+constexpr std::size_t kDefaultMaxRemembered = 100000;
+
+auto FindDeduplicator(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context
+) -> const EventDeduplicator* {
+    auto name = config["deduplicator"].As<std::string>("");
+    if (name.empty()) {
+        return nullptr;
+    }
+    return &context.FindComponent<EventDeduplicator>(name);
+}
+
+auto ParseNotificationSettingId(const userver::components::ComponentConfig& config)
+    -> std::optional<NotificationSettingId> {
+    auto id = config["notification_setting_id"].As<std::string>("");
+    if (id.empty()) {
+        return std::nullopt;
+    }
+    return NotificationSettingId{std::move(id)};
+}
+
+}  // namespace
+
+struct FailedNotificationReconciler::Impl {
+    Client& client;
+    const EventDeduplicator* deduplicator;
+    std::optional<NotificationSettingId> notification_setting_id;
+    std::chrono::milliseconds lookback;
+    handlers::EventDispatcher dispatcher;
+
+    /// Passes don't overlap, so that a notification is not dispatched twice
+    mutable engine::Mutex run_mutex;
+    /// Notifications stay failed in Paddle after they are reconciled. Kept in memory only,
+    /// after a restart the failed notifications within the lookback are dispatched again
+    mutable userver::cache::LruSet<NotificationId> reconciled_notifications;
+
+    mutable std::atomic<std::uint64_t> reconciled{0};
+    mutable std::atomic<std::uint64_t> duplicates{0};
+    mutable std::atomic<std::uint64_t> failed{0};
+    statistics::Entry statistics_holder;
+    userver::utils::PeriodicTask reconcile_task;
+
+    Impl(const userver::components::ComponentConfig& config, const userver::components::ComponentContext& context)
+        : client{context.FindComponent<Client>(config["client_name"].As<std::string>("paddle-client"))}
+        , deduplicator{FindDeduplicator(config, context)}
+        , notification_setting_id{ParseNotificationSettingId(config)}
+        , lookback{config["lookback"].As<std::chrono::milliseconds>(kDefaultLookback)}
+        , dispatcher{config, context}
+        , reconciled_notifications{config["max_remembered"].As<std::size_t>(kDefaultMaxRemembered)} {
+        statistics_holder =
+            context.FindComponent<userver::components::StatisticsStorage>().GetStorage().RegisterWriter(
+                kStatisticsPrefix,
+                [this](statistics::Writer& writer) { WriteStatistics(writer); },
+                {{"paddle_reconciler", config.Name()}}
+            );
+        reconcile_task.Start(
+            kReconcileTaskName,
+            userver::utils::PeriodicTask::Settings{
+                config["interval"].As<std::chrono::milliseconds>(kDefaultInterval),
+                userver::utils::PeriodicTask::Flags::kNow
+            },
+            [this] { Reconcile(); }
+        );
+    }
+
+    ~Impl() {
+        reconcile_task.Stop();
+        statistics_holder.Unregister();
+    }
+
+    auto WriteStatistics(statistics::Writer& writer) const -> void {
+        writer["reconciled"] = reconciled.load();
+        writer["duplicates"] = duplicates.load();
+        writer["failed"] = failed.load();
+    }
+
+    auto MakeQuery() const -> NotificationQuery {
+        NotificationQuery query;
+        // Paddle still retries the needs_retry ones, dispatching them here would process them twice
+        query.statuses = {NotificationStatus::kFailed};
+        query.notification_setting_id = notification_setting_id;
+        query.from = Timestamp{userver::utils::datetime::Now() - lookback};
+        return query;
+    }
+
+    auto Reconcile() const -> ReconcileResult {
+        std::lock_guard run_lock{run_mutex};
+        const auto query = MakeQuery();
+        ReconcileResult result;
+        std::string cursor;
+        bool has_more = true;
+        while (has_more) {
+            auto [notifications, next_cursor, more] = client.GetNotifications(cursor, query, kNotificationsPerPage);
+            for (const auto& notification : notifications) {
+                Reconcile(notification, result);
+            }
+            cursor = std::move(next_cursor);
+            has_more = more && !notifications.empty();
+        }
+        if (result.reconciled || result.duplicates || result.failed) {
+            LOG_INFO() << "Reconciled failed notifications: " << result.reconciled << " dispatched, "
+                       << result.duplicates << " duplicates, " << result.failed << " failed";
+        }
+        return result;
+    }
+
+    auto Reconcile(const Notification& notification, ReconcileResult& result) const -> void {
+        if (reconciled_notifications.Has(notification.id)) {
+            return;
+        }
+        auto event = notification.payload.As<events::Event<JSON>>();
+        const auto event_id = event.event_id;
+        if (deduplicator && !deduplicator->TryBegin(event_id)) {
+            LOG_INFO() << "Event " << event_id << " of notification " << notification.id << " is already processed";
+            reconciled_notifications.Put(notification.id);
+            ++result.duplicates;
+            ++duplicates;
+            return;
+        }
+        LOG_INFO() << "Reconcile notification " << notification.id << " (" << EnumToString(notification.status) << ", "
+                   << notification.times_attempted << " attempts): " << event.event_type << " " << event_id;
+        try {
+            auto dispatched = dispatcher.Dispatch(notification.payload, std::move(event));
+            if (dispatched == handlers::DispatchResult::kUnsupported) {
+                LOG_INFO() << "Event category not supported: " << notification.type;
+            }
+        } catch (const std::exception& e) {
+            LOG_ERROR() << "Failed to reconcile notification " << notification.id << ": " << e.what();
+            if (deduplicator) {
+                deduplicator->Abort(event_id);
+            }
+            ++result.failed;
+            ++failed;
+            return;
+        }
+        if (deduplicator) {
+            deduplicator->Complete(event_id);
+        }
+        reconciled_notifications.Put(notification.id);
+        ++result.reconciled;
+        ++reconciled;
+    }
+};
+
+FailedNotificationReconciler::FailedNotificationReconciler(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context
+)
+    : BaseType{config, context}
+    , impl_{config, context} {
+}
+
+FailedNotificationReconciler::~FailedNotificationReconciler() = default;
+
+auto FailedNotificationReconciler::GetStaticConfigSchema() -> userver::yaml_config::Schema {
+    return userver::yaml_config::MergeSchemas<BaseType>(fmt::format(
+        R"(
+type: object
+description: Paddle failed notification reconciler component
+additionalProperties: false
+properties:
+    client_name:
+        type: string
+        description: |
+            name of the Paddle client component (default: paddle-client)
+    deduplicator:
+        type: string
+        description: |
+            Event deduplicator component name, share it with the webhook handler so that
+            the events it has processed are not dispatched again
+    notification_setting_id:
+        type: string
+        description: Reconcile the notifications of this notification setting only (all by default)
+    interval:
+        type: string
+        description: How often the failed notifications are checked (1m by default)
+    lookback:
+        type: string
+        description: How far back the failed notifications are checked (24h by default)
+    max_remembered:
+        type: integer
+        minimum: 1
+        description: |
+            Number of reconciled notification ids to remember in memory (100000 by default),
+            they are forgotten on restart
+{}{})",
+        handlers::Handlers::GetHanderNames(),
+        handlers::EventDispatcher::GetConfigSchema()
+    ));
+}
+
+auto FailedNotificationReconciler::Reconcile() const -> ReconcileResult {
+    return impl_->Reconcile();
+}
+
+}  // namespace paddle::components
@@ -0,0 +1,152 @@
+#include <paddle/components/ip_allowlist_cache.hpp>
+
+#include <paddle/components/client.hpp>
+#include <paddle/components/scope_names.hpp>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/engine/io/sockaddr.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <netinet/in.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace paddle::components {
+
+namespace {
+
+constexpr auto kForwardedForHeader = "X-Forwarded-For";
+
+auto ToAddress(const userver::engine::io::Sockaddr& sockaddr) -> std::optional<IpAllowlist::Address> {
+    switch (sockaddr.Domain()) {
+        case userver::engine::io::AddrDomain::kInet:
+            return IpAllowlist::FromV4(ntohl(sockaddr.As<sockaddr_in>()->sin_addr.s_addr));
+        case userver::engine::io::AddrDomain::kInet6: {
+            const auto& address = sockaddr.As<sockaddr_in6>()->sin6_addr;
+            return IpAllowlist::FromV6(std::span<const std::uint8_t, 16>{address.s6_addr});
+        }
+        default:
+            return std::nullopt;
+    }
+}
+
+auto FindClient(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context
+) -> const Client* {
+    if (!config["fetch_paddle_ips"].As<bool>(true)) {
+        return nullptr;
+    }
+    return &context.FindComponent<Client>(config["client_name"].As<std::string>("paddle-client"));
+}
+
+}  // namespace
+
+struct IpAllowlistCache::Impl {
+    /// Null if the Paddle ranges are not fetched
+    const Client* client;
+    std::vector<std::string> cidrs;
+    std::size_t trusted_proxy_depth;
+
+    Impl(const userver::components::ComponentConfig& config, const userver::components::ComponentContext& context)
+        : client(FindClient(config, context))
+        , cidrs(config["cidrs"].As<std::vector<std::string>>(std::vector<std::string>{}))
+        , trusted_proxy_depth(config["trusted_proxy_depth"].As<std::size_t>(0)) {
+        // Fail on a malformed range at startup rather than on every update
+        [[maybe_unused]] IpAllowlist static_ranges{cidrs};
+    }
+
+    auto FetchAllowlist(userver::cache::UpdateStatisticsScope& stats_scope) const -> std::unique_ptr<IpAllowlist> {
+        auto scope = userver::tracing::Span::CurrentSpan().CreateScopeTime(std::string{scope_names::kFetchStage});
+        auto ranges = cidrs;
+        if (client) {
+            auto addresses = client->GetIpAddresses();
+            LOG_INFO() << "Fetched " << addresses.ipv4_cidrs.size() << " Paddle webhook address ranges";
+            stats_scope.IncreaseDocumentsReadCount(addresses.ipv4_cidrs.size());
+            ranges.insert(ranges.end(), addresses.ipv4_cidrs.begin(), addresses.ipv4_cidrs.end());
+        }
+        scope.Reset(std::string{scope_names::kParseStage});
+        return std::make_unique<IpAllowlist>(ranges);
+    }
+
+    auto GetClientAddress(const userver::server::http::HttpRequest& request) const
+        -> std::optional<IpAllowlist::Address> {
+        if (trusted_proxy_depth == 0) {
+            return ToAddress(request.GetRemoteAddress());
+        }
+        auto forwarded = GetForwardedAddress(request.GetHeader(kForwardedForHeader), trusted_proxy_depth);
+        if (!forwarded) {
+            return std::nullopt;
+        }
+        return IpAllowlist::ParseAddress(*forwarded);
+    }
+};
+
+IpAllowlistCache::IpAllowlistCache(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context
+)
+    : BaseType{config, context}
+    , impl_{config, context} {
+    StartPeriodicUpdates();
+}
+
+IpAllowlistCache::~IpAllowlistCache() {
+    StopPeriodicUpdates();
+}
+
+auto IpAllowlistCache::GetStaticConfigSchema() -> userver::yaml_config::Schema {
+    return userver::yaml_config::MergeSchemas<BaseType>(R"(
+type: object
+description: Allowlist of the webhook source addresses
+additionalProperties: false
+properties:
+    client_name:
+        type: string
+        description: Component name for Paddle client (paddle-client by default)
+    fetch_paddle_ips:
+        type: boolean
+        description: Allow the addresses Paddle sends webhooks from, fetched on every update (true by default)
+    cidrs:
+        type: array
+        description: Additional address ranges, e.g. for the local testing
+        items:
+            type: string
+            description: IPv4 or IPv6 range, e.g. 10.0.0.0/8
+    trusted_proxy_depth:
+        type: integer
+        minimum: 0
+        description: |
+            Number of reverse proxies in front of the service, each appending to X-Forwarded-For.
+            The client address is taken from the header entry appended by the outermost of them
+            (0 by default, the connection peer address is checked)
+    )");
+}
+
+auto IpAllowlistCache::Update(
+    [[maybe_unused]] userver::cache::UpdateType type,
+    [[maybe_unused]] const std::chrono::system_clock::time_point& last_update,
+    [[maybe_unused]] const std::chrono::system_clock::time_point& now,
+    userver::cache::UpdateStatisticsScope& stats_scope
+) -> void {
+    auto allowlist = impl_->FetchAllowlist(stats_scope);
+    LOG_INFO() << "Webhook address allowlist updated with " << allowlist->GetSize() << " ranges";
+    stats_scope.Finish(allowlist->GetSize());
+    Set(std::move(allowlist));
+}
+
+auto IpAllowlistCache::IsAllowed(const userver::server::http::HttpRequest& request) const -> bool {
+    auto address = impl_->GetClientAddress(request);
+    return address && this->GetUnsafe()->Contains(*address);
+}
+
+}  // namespace paddle::components
@@ -0,0 +1,199 @@
+#include <paddle/components/notification_subscription_sync.hpp>
+
+#include <paddle/components/client.hpp>
+
+#include <paddle/handlers/handlers.hpp>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <fmt/format.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace paddle::components {
+
+namespace statistics = userver::utils::statistics;
+
+namespace {
+
+constexpr auto kStatisticsPrefix = "paddle.subscriptions";
+constexpr auto kSyncTaskName = "paddle-sync-subscriptions";
+constexpr std::chrono::milliseconds kDefaultInterval{std::chrono::hours{1}};
+
+auto JoinEventTypes(const std::vector<events::EventTypeName>& event_types) -> std::string {
+    std::string result;
+    for (auto event_type : event_types) {
+        if (!result.empty()) {
+            result += ", ";
+        }
+        result += EnumToString(event_type);
+    }
+    return result;
+}
+
+}  // namespace
+
+struct NotificationSubscriptionSync::Impl {
+    Client& client;
+    std::string webhook_host;
+    std::string webhook_path;
+    bool narrow;
+    std::vector<events::EventTypeName> handled;
+
+    mutable std::atomic<std::uint64_t> unhandled_count{0};
+    mutable std::atomic<std::uint64_t> missing_count{0};
+    mutable std::atomic<std::uint64_t> narrowed_count{0};
+    statistics::Entry statistics_holder;
+    userver::utils::PeriodicTask sync_task;
+
+    Impl(const userver::components::ComponentConfig& config, const userver::components::ComponentContext& context)
+        : client{context.FindComponent<Client>(config["client_name"].As<std::string>("paddle-client"))}
+        , webhook_host{config["webhook_host"].As<std::string>()}
+        , webhook_path{config["webhook_path"].As<std::string>("")}
+        , narrow{config["narrow"].As<bool>(false)}
+        , handled{handlers::Handlers{config, context}.GetHandledEventTypes()} {
+        if (handled.empty()) {
+            throw std::runtime_error("No event handlers configured, the subscriptions can't be checked");
+        }
+        statistics_holder =
+            context.FindComponent<userver::components::StatisticsStorage>().GetStorage().RegisterWriter(
+                kStatisticsPrefix,
+                [this](statistics::Writer& writer) { WriteStatistics(writer); },
+                {{"paddle_subscriptions", config.Name()}}
+            );
+        sync_task.Start(
+            kSyncTaskName,
+            userver::utils::PeriodicTask::Settings{
+                config["interval"].As<std::chrono::milliseconds>(kDefaultInterval),
+                userver::utils::PeriodicTask::Flags::kNow
+            },
+            [this] { Sync(); }
+        );
+    }
+
+    ~Impl() {
+        sync_task.Stop();
+        statistics_holder.Unregister();
+    }
+
+    auto WriteStatistics(statistics::Writer& writer) const -> void {
+        writer["unhandled"] = unhandled_count.load();
+        writer["missing"] = missing_count.load();
+        writer["narrowed"] = narrowed_count.load();
+    }
+
+    auto IsWebhookSetting(const NotificationSetting& setting) const -> bool {
+        if (setting.type != NotificationSettingType::kUrl || !setting.active) {
+            return false;
+        }
+        auto pos = setting.destination.find(webhook_host);
+        if (pos == std::string::npos) {
+            return false;
+        }
+        return webhook_path.empty() || setting.destination.substr(pos + webhook_host.size()) == webhook_path;
+    }
+
+    auto Sync() const -> std::vector<SubscriptionDiff> {
+        std::vector<SubscriptionDiff> diffs;
+        std::uint64_t unhandled = 0;
+        std::uint64_t missing = 0;
+        for (const auto& setting : client.GetAllNotificationSettings()) {
+            if (!IsWebhookSetting(setting)) {
+                continue;
+            }
+            auto diff = DiffSubscription(setting, handled);
+            unhandled += diff.unhandled.size();
+            missing += diff.missing.size();
+            if (!diff.missing.empty()) {
+                LOG_WARNING() << "Notification setting " << setting.id << " (" << setting.destination
+                              << ") is not subscribed to handled events: " << JoinEventTypes(diff.missing);
+            }
+            if (!diff.unhandled.empty()) {
+                LOG_WARNING() << "Notification setting " << setting.id << " (" << setting.destination
+                              << ") is subscribed to unhandled events: " << JoinEventTypes(diff.unhandled);
+                if (narrow) {
+                    Narrow(setting, diff);
+                }
+            }
+            diffs.push_back(std::move(diff));
+        }
+        unhandled_count = unhandled;
+        missing_count = missing;
+        return diffs;
+    }
+
+    auto Narrow(const NotificationSetting& setting, const SubscriptionDiff& diff) const -> void {
+        auto update = NarrowSubscription(setting, diff);
+        // Paddle requires at least one subscribed event
+        if (update.subscribed_events.empty()) {
+            LOG_WARNING() << "Notification setting " << setting.id
+                          << " has no handled events, deactivate it instead of narrowing";
+            return;
+        }
+        try {
+            client.UpdateNotificationSetting(setting.id, update);
+            ++narrowed_count;
+            LOG_INFO() << "Notification setting " << setting.id << " narrowed to "
+                       << update.subscribed_events.size() << " events";
+        } catch (const std::exception& e) {
+            LOG_ERROR() << "Failed to narrow notification setting " << setting.id << ": " << e.what();
+        }
+    }
+};
+
+NotificationSubscriptionSync::NotificationSubscriptionSync(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context
+)
+    : BaseType{config, context}
+    , impl_{config, context} {
+}
+
+NotificationSubscriptionSync::~NotificationSubscriptionSync() = default;
+
+auto NotificationSubscriptionSync::GetStaticConfigSchema() -> userver::yaml_config::Schema {
+    return userver::yaml_config::MergeSchemas<BaseType>(fmt::format(
+        R"(
+type: object
+description: Paddle notification subscription sync component
+additionalProperties: false
+properties:
+    client_name:
+        type: string
+        description: |
+            name of the Paddle client component (default: paddle-client)
+    webhook_host:
+        type: string
+        description: Hostname of the webhook server
+    webhook_path:
+        type: string
+        description: Check the notification settings of this webhook path only (all by default)
+    narrow:
+        type: boolean
+        description: |
+            Unsubscribe the notification settings from the unhandled events, requires the
+            notification setting write permission (false by default)
+    interval:
+        type: string
+        description: How often the subscriptions are checked (1h by default)
+{})",
+        handlers::Handlers::GetHanderNames()
+    ));
+}
+
+auto NotificationSubscriptionSync::Sync() const -> std::vector<SubscriptionDiff> {
+    return impl_->Sync();
+}
+
+}  // namespace paddle::components
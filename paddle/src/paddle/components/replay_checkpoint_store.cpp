@@ -0,0 +1,394 @@
+#include <paddle/components/replay_checkpoint_store.hpp>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/fs/read.hpp>
+#include <userver/fs/write.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/component.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace paddle::components {
+
+namespace engine = userver::engine;
+namespace postgres = userver::storages::postgres;
+
+namespace {
+
+constexpr std::chrono::milliseconds kDefaultFlushInterval{1000};
+constexpr auto kFlushTaskName = "paddle-checkpoint-flush";
+constexpr auto kDefaultFsTaskProcessor = "fs-task-processor";
+constexpr auto kDefaultTable = "paddle.replay_checkpoints";
+
+using Cursors = std::map<std::string, std::string, std::less<>>;
+
+class CheckpointBackend {
+public:
+    virtual ~CheckpointBackend() = default;
+
+    virtual auto Load(std::string_view key) const -> std::optional<std::string> = 0;
+    virtual auto Save(std::string_view key, std::string_view cursor) const -> void = 0;
+};
+
+/// All the cursors are kept in a single JSON object, the file is rewritten atomically
+class FileBackend final : public CheckpointBackend {
+public:
+    FileBackend(std::string path, engine::TaskProcessor& fs_task_processor)
+        : path_{std::move(path)}
+        , fs_task_processor_{fs_task_processor} {
+    }
+
+    auto Load(std::string_view key) const -> std::optional<std::string> override {
+        std::lock_guard lock{mutex_};
+        auto cursors = ReadAll();
+        auto it = cursors.find(key);
+        if (it == cursors.end()) {
+            return std::nullopt;
+        }
+        return std::move(it->second);
+    }
+
+    auto Save(std::string_view key, std::string_view cursor) const -> void override {
+        std::lock_guard lock{mutex_};
+        auto cursors = ReadAll();
+        cursors.insert_or_assign(std::string{key}, std::string{cursor});
+        userver::formats::json::ValueBuilder builder{userver::formats::common::Type::kObject};
+        for (const auto& [name, value] : cursors) {
+            builder[name] = value;
+        }
+        userver::fs::RewriteFileContentsAtomically(
+            fs_task_processor_,
+            path_,
+            userver::formats::json::ToString(builder.ExtractValue()),
+            boost::filesystem::perms::owner_read | boost::filesystem::perms::owner_write
+        );
+    }
+
+private:
+    auto ReadAll() const -> Cursors {
+        if (!userver::fs::FileExists(fs_task_processor_, path_)) {
+            return {};
+        }
+        auto contents = userver::fs::ReadFileContents(fs_task_processor_, path_);
+        auto json = userver::formats::json::FromString(contents);
+        Cursors cursors;
+        for (auto it = json.begin(); it != json.end(); ++it) {
+            cursors.emplace(it.GetName(), it->As<std::string>());
+        }
+        return cursors;
+    }
+
+    std::string path_;
+    engine::TaskProcessor& fs_task_processor_;
+    mutable engine::Mutex mutex_;
+};
+
+class PostgresBackend final : public CheckpointBackend {
+public:
+    PostgresBackend(postgres::ClusterPtr cluster, std::string_view table)
+        : cluster_{std::move(cluster)}
+        , load_query_{
+              fmt::format("SELECT last_event_id FROM {} WHERE name = $1", table),
+              postgres::Query::Name{"paddle_load_replay_checkpoint"}
+          }
+        , save_query_{
+              fmt::format(
+                  "INSERT INTO {} (name, last_event_id, updated_at) VALUES ($1, $2, now()) "
+                  "ON CONFLICT (name) DO UPDATE SET last_event_id = excluded.last_event_id, updated_at = now()",
+                  table
+              ),
+              postgres::Query::Name{"paddle_save_replay_checkpoint"}
+          } {
+    }
+
+    auto Load(std::string_view key) const -> std::optional<std::string> override {
+        auto result = cluster_->Execute(postgres::ClusterHostType::kMaster, load_query_, std::string{key});
+        return result.AsOptionalSingleRow<std::string>();
+    }
+
+    auto Save(std::string_view key, std::string_view cursor) const -> void override {
+        cluster_->Execute(postgres::ClusterHostType::kMaster, save_query_, std::string{key}, std::string{cursor});
+    }
+
+private:
+    postgres::ClusterPtr cluster_;
+    postgres::Query load_query_;
+    postgres::Query save_query_;
+};
+
+auto MakeBackend(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context
+) -> std::unique_ptr<CheckpointBackend> {
+    auto storage = config["storage"].As<std::string>();
+    if (storage == "file") {
+        return std::make_unique<FileBackend>(
+            config["file_path"].As<std::string>(),
+            context.GetTaskProcessor(config["fs_task_processor"].As<std::string>(kDefaultFsTaskProcessor))
+        );
+    }
+    if (storage == "postgres") {
+        auto& component =
+            context.FindComponent<userver::components::Postgres>(config["postgres_component"].As<std::string>());
+        return std::make_unique<PostgresBackend>(
+            component.GetCluster(), config["postgres_table"].As<std::string>(kDefaultTable)
+        );
+    }
+    throw std::runtime_error(fmt::format("Unknown replay checkpoint storage: {}", storage));
+}
+
+}  // namespace
+
+EventWatermark::EventWatermark(std::size_t max_tracked)
+    : max_tracked_{std::max<std::size_t>(max_tracked, 1)} {
+}
+
+auto EventWatermark::Begin(const EventId& event_id) -> void {
+    if (cursor_ && event_id <= *cursor_) {
+        return;
+    }
+    completed_.erase(event_id);
+    pending_.insert(event_id);
+    Trim();
+}
+
+auto EventWatermark::Fail(const EventId& event_id) -> void {
+    Begin(event_id);
+}
+
+auto EventWatermark::Complete(const EventId& event_id) -> std::optional<EventId> {
+    pending_.erase(event_id);
+    if (cursor_ && event_id <= *cursor_) {
+        return std::nullopt;
+    }
+    completed_.insert(event_id);
+    auto moved = MoveCursor();
+    moved = Trim() || moved;
+    if (!moved) {
+        return std::nullopt;
+    }
+    return cursor_;
+}
+
+auto EventWatermark::GetCursor() const -> const std::optional<EventId>& {
+    return cursor_;
+}
+
+auto EventWatermark::MoveCursor() -> bool {
+    auto moved = false;
+    // Event ids are ULID based, so their order is the order of the events
+    while (!completed_.empty() && (pending_.empty() || *completed_.begin() < *pending_.begin())) {
+        cursor_ = *completed_.begin();
+        completed_.erase(completed_.begin());
+        moved = true;
+    }
+    // Events older than the cursor no longer hold it back
+    while (!pending_.empty() && cursor_ && *pending_.begin() <= *cursor_) {
+        pending_.erase(pending_.begin());
+    }
+    return moved;
+}
+
+auto EventWatermark::Trim() -> bool {
+    auto moved = false;
+    while (pending_.size() + completed_.size() > max_tracked_ && !pending_.empty()) {
+        LOG_WARNING() << "Too many events pending, the checkpoint moves past " << *pending_.begin();
+        pending_.erase(pending_.begin());
+        moved = MoveCursor() || moved;
+    }
+    return moved;
+}
+
+struct ReplayCheckpointStore::Impl {
+    std::unique_ptr<CheckpointBackend> backend;
+    mutable engine::Mutex mutex;
+    /// Latest known cursors, advanced ones are not necessarily persisted yet
+    mutable Cursors cursors;
+    mutable std::set<std::string, std::less<>> dirty;
+    mutable std::map<std::string, EventWatermark, std::less<>> watermarks;
+    userver::utils::PeriodicTask flush_task;
+
+    Impl(const userver::components::ComponentConfig& config, const userver::components::ComponentContext& context)
+        : backend{MakeBackend(config, context)} {
+        flush_task.Start(
+            kFlushTaskName,
+            userver::utils::PeriodicTask::Settings{
+                config["flush_interval"].As<std::chrono::milliseconds>(kDefaultFlushInterval)
+            },
+            [this] { Flush(); }
+        );
+    }
+
+    ~Impl() {
+        flush_task.Stop();
+        try {
+            Flush();
+        } catch (const std::exception& e) {
+            LOG_ERROR() << "Failed to flush replay checkpoints: " << e.what();
+        }
+    }
+
+    auto Load(std::string_view key) const -> std::optional<std::string> {
+        {
+            std::lock_guard lock{mutex};
+            auto it = cursors.find(key);
+            if (it != cursors.end()) {
+                return it->second;
+            }
+        }
+        return backend->Load(key);
+    }
+
+    auto Save(std::string_view key, std::string_view cursor) const -> void {
+        backend->Save(key, cursor);
+        std::lock_guard lock{mutex};
+        cursors.insert_or_assign(std::string{key}, std::string{cursor});
+        if (auto it = dirty.find(key); it != dirty.end()) {
+            dirty.erase(it);
+        }
+    }
+
+    auto Begin(std::string_view key, const EventId& event_id) const -> void {
+        std::lock_guard lock{mutex};
+        GetWatermark(key).Begin(event_id);
+    }
+
+    auto Fail(std::string_view key, const EventId& event_id) const -> void {
+        std::lock_guard lock{mutex};
+        GetWatermark(key).Fail(event_id);
+    }
+
+    auto Advance(std::string_view key, const EventId& event_id) const -> void {
+        std::lock_guard lock{mutex};
+        auto cursor = GetWatermark(key).Complete(event_id);
+        if (!cursor) {
+            return;
+        }
+        auto it = cursors.find(key);
+        if (it == cursors.end()) {
+            it = cursors.emplace(std::string{key}, std::string{}).first;
+        }
+        // A cursor saved explicitly may be ahead of the processed events
+        if (it->second < cursor->ToString()) {
+            it->second = cursor->ToString();
+            dirty.emplace(key);
+        }
+    }
+
+    /// Called under the mutex
+    auto GetWatermark(std::string_view key) const -> EventWatermark& {
+        auto it = watermarks.find(key);
+        if (it == watermarks.end()) {
+            it = watermarks.emplace(std::string{key}, EventWatermark{}).first;
+        }
+        return it->second;
+    }
+
+    auto Flush() const -> void {
+        std::vector<std::pair<std::string, std::string>> pending;
+        {
+            std::lock_guard lock{mutex};
+            for (const auto& key : dirty) {
+                pending.emplace_back(key, cursors.find(key)->second);
+            }
+            dirty.clear();
+        }
+        for (auto it = pending.begin(); it != pending.end(); ++it) {
+            try {
+                backend->Save(it->first, it->second);
+            } catch (const std::exception& e) {
+                LOG_ERROR() << "Failed to save replay checkpoint " << it->first << ": " << e.what();
+                // Retry with the next flush
+                std::lock_guard lock{mutex};
+                for (; it != pending.end(); ++it) {
+                    dirty.emplace(it->first);
+                }
+                throw;
+            }
+        }
+    }
+};
+
+ReplayCheckpointStore::ReplayCheckpointStore(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context
+)
+    : BaseType{config, context}
+    , impl_{config, context} {
+}
+
+ReplayCheckpointStore::~ReplayCheckpointStore() = default;
+
+auto ReplayCheckpointStore::GetStaticConfigSchema() -> userver::yaml_config::Schema {
+    return userver::yaml_config::MergeSchemas<BaseType>(R"(
+type: object
+description: Paddle replay checkpoint store component
+additionalProperties: false
+properties:
+    storage:
+        type: string
+        enum:
+          - file
+          - postgres
+        description: Where the checkpoints are kept
+    file_path:
+        type: string
+        description: Checkpoint file, required for the file storage
+    fs_task_processor:
+        type: string
+        description: Task processor for the file IO (fs-task-processor by default)
+    postgres_component:
+        type: string
+        description: PostgreSQL component name, required for the postgres storage
+    postgres_table:
+        type: string
+        description: Checkpoint table (paddle.replay_checkpoints by default)
+    flush_interval:
+        type: string
+        description: How often the advanced cursors are persisted (1s by default)
+    )");
+}
+
+auto ReplayCheckpointStore::Load(std::string_view key) const -> std::optional<std::string> {
+    return impl_->Load(key);
+}
+
+auto ReplayCheckpointStore::Save(std::string_view key, std::string_view cursor) const -> void {
+    impl_->Save(key, cursor);
+}
+
+auto ReplayCheckpointStore::Begin(std::string_view key, const EventId& event_id) const -> void {
+    impl_->Begin(key, event_id);
+}
+
+auto ReplayCheckpointStore::Fail(std::string_view key, const EventId& event_id) const -> void {
+    impl_->Fail(key, event_id);
+}
+
+auto ReplayCheckpointStore::Advance(std::string_view key, const EventId& event_id) const -> void {
+    impl_->Advance(key, event_id);
+}
+
+auto ReplayCheckpointStore::Flush() const -> void {
+    impl_->Flush();
+}
+
+}  // namespace paddle::components
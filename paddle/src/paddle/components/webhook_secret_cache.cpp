@@ -1,5 +1,7 @@
 #include <paddle/components/webhook_secret_cache.hpp>
 
+#include <paddle/auth/batch_verifier.hpp>
+#include <paddle/auth/secret_refresher.hpp>
 #include <paddle/auth/signature.hpp>
 #include <paddle/components/client.hpp>
 
@@ -9,8 +11,12 @@
 #include <userver/tracing/span.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 namespace paddle::components {
 
@@ -18,6 +24,25 @@ namespace {
 constexpr static auto kCopyStage = "copy";
 constexpr static auto kFetchStage = "fetch";
 constexpr static auto kParseStage = "parse";
+
+auto MakeBatchVerifier(const userver::components::ComponentConfig& config) -> std::unique_ptr<auth::BatchVerifier> {
+    const auto& batch_config = config["batch_verification"];
+    if (batch_config.IsMissing()) {
+        return nullptr;
+    }
+    auth::BatchVerifierSettings settings;
+    settings.window = std::chrono::microseconds{batch_config["window_us"].As<std::int64_t>(settings.window.count())};
+    settings.max_batch_size = batch_config["max_batch_size"].As<std::size_t>(settings.max_batch_size);
+    return std::make_unique<auth::BatchVerifier>(settings);
+}
+
+auto MakeRefresherSettings(const userver::components::ComponentConfig& config) -> auth::SecretRefresherSettings {
+    auth::SecretRefresherSettings settings;
+    settings.min_refresh_interval =
+        config["min_refresh_interval"].As<std::chrono::milliseconds>(settings.min_refresh_interval);
+    settings.unknown_path_ttl = config["unknown_path_ttl"].As<std::chrono::milliseconds>(settings.unknown_path_ttl);
+    return settings;
+}
 }  // namespace
 
 struct WebhookSecretCache::Impl {
@@ -26,18 +51,27 @@ struct WebhookSecretCache::Impl {
     Client& client;
     std::string webhook_host;
     std::int32_t max_signature_age_seconds;
+    std::vector<std::string> wildcard_paths;
+    /// Null unless batch verification is enabled
+    std::unique_ptr<auth::BatchVerifier> batch_verifier;
+    /// Publishes refreshed secrets, set by the component
+    std::function<void(std::unique_ptr<DataType>)> set_secrets;
+    mutable auth::SecretRefresher refresher;
 
     Impl(const userver::components::ComponentConfig& config, const userver::components::ComponentContext& context)
         : client(context.FindComponent<Client>(config["client_name"].As<std::string>("paddle-client")))
         , webhook_host(config["webhook_host"].As<std::string>())
-        , max_signature_age_seconds(config["max_signature_age_seconds"].As<std::int32_t>(60)) {
+        , max_signature_age_seconds(config["max_signature_age_seconds"].As<std::int32_t>(60))
+        , wildcard_paths(config["wildcard_paths"].As<std::vector<std::string>>(std::vector<std::string>{}))
+        , batch_verifier(MakeBatchVerifier(config))
+        , refresher(MakeRefresherSettings(config), [this] { set_secrets(FetchSecrets(nullptr)); }) {
     }
 
-    std::unique_ptr<DataType> FetchSecrets(userver::cache::UpdateStatisticsScope& stats_scope) const {
+    std::unique_ptr<DataType> FetchSecrets(userver::cache::UpdateStatisticsScope* stats_scope) const {
         namespace tracing = userver::tracing;
         // Get all notification settings from the client
         auto scope = tracing::Span::CurrentSpan().CreateScopeTime(std::string{kCopyStage});
-        auto data_cache = std::make_unique<DataType>();
+        auto data_cache = std::make_unique<DataType>(wildcard_paths);
 
         scope.Reset(std::string{kFetchStage});
 
@@ -60,13 +94,15 @@ struct WebhookSecretCache::Impl {
             }
             auto webhook_path = notification_setting.destination.substr(pos + webhook_host.size());
             LOG_INFO() << "Adding webhook secret: '" << webhook_path << "'";
-            data_cache->insert_or_assign(std::move(webhook_path), std::move(notification_setting.endpoint_secret_key));
+            data_cache->Add(webhook_path, notification_setting.endpoint_secret_key);
         }
-        LOG_INFO() << "Webhook secret cache updated with " << data_cache->size() << " webhooks";
+        LOG_INFO() << "Webhook secret cache updated with " << data_cache->GetSize() << " webhooks";
         // Update the cache
-        auto final_size = data_cache->size();
-        stats_scope.IncreaseDocumentsReadCount(notification_settings.size());
-        stats_scope.Finish(final_size);
+        if (stats_scope) {
+            auto final_size = data_cache->GetSize();
+            stats_scope->IncreaseDocumentsReadCount(notification_settings.size());
+            stats_scope->Finish(final_size);
+        }
         return data_cache;
     }
 };
@@ -77,6 +113,7 @@ WebhookSecretCache::WebhookSecretCache(
 )
     : BaseType{config, context}
     , impl_{config, context} {
+    impl_->set_secrets = [this](std::unique_ptr<DataType> data) { this->Set(std::move(data)); };
     StartPeriodicUpdates();
 }
 
@@ -99,6 +136,39 @@ properties:
     max_signature_age_seconds:
         type: integer
         description: Maximum age of the signature in seconds
+    min_refresh_interval:
+        type: string
+        description: |
+            Minimum time between the secret refreshes triggered by an unknown path or a signature
+            mismatch (10s by default)
+    wildcard_paths:
+        type: array
+        description: |
+            Webhook path patterns ending with `*`, a request to a path under a pattern without
+            secrets of its own is checked against the secrets of all the destinations under it
+        items:
+            type: string
+            description: path pattern, e.g. /paddle/webhook/*
+    batch_verification:
+        type: object
+        description: |
+            Verify the signatures of concurrent requests together with the multi-buffer HMAC kernel,
+            worth it under bursts of large payloads on CPUs without the SHA extensions
+        additionalProperties: false
+        properties:
+            window_us:
+                type: integer
+                minimum: 0
+                description: How long a batch waits for more requests, microseconds (200 by default)
+            max_batch_size:
+                type: integer
+                minimum: 1
+                description: Number of HMACs the batch is hashed at without waiting further (64 by default)
+    unknown_path_ttl:
+        type: string
+        description: |
+            How long a path still unknown after a refresh is rejected without another refresh
+            (1m by default)
    )");
 }
 
@@ -108,25 +178,37 @@ auto WebhookSecretCache::Update(
     [[maybe_unused]] const std::chrono::system_clock::time_point& now,
     userver::cache::UpdateStatisticsScope& stats_scope
 ) -> void {
-    auto data_cache = impl_->FetchSecrets(stats_scope);
-    this->Set(std::move(data_cache));
+    impl_->refresher.Update([this, &stats_scope] { impl_->set_secrets(impl_->FetchSecrets(&stats_scope)); });
 }
 
 auto WebhookSecretCache::ValidateSignature(const userver::server::http::HttpRequest& request) const -> bool {
-    auto path = request.GetRequestPath();
-    auto secret_cache = this->GetUnsafe();
-    auto secret = secret_cache->find(path);
-    if (secret == secret_cache->end()) {
-        LOG_WARNING() << "No secret found for path: " << path;
-        return false;
-    }
+    const auto& path = request.GetRequestPath();
     auto signature = request.GetHeader("Paddle-Signature");
     if (signature.empty()) {
         LOG_WARNING() << "No signature found in request";
         return false;
     }
-    auto payload = request.RequestBody();
-    return VerifySignature(secret->second, signature, payload, impl_->max_signature_age_seconds);
+    const auto& payload = request.RequestBody();
+    // Read before the lookup, so that a refresh completed after it is not repeated
+    const auto seen_generation = impl_->refresher.GetGeneration();
+    const auto* verifier = impl_->batch_verifier.get();
+    auto match = this->GetUnsafe()->Verify(path, signature, payload, impl_->max_signature_age_seconds, verifier);
+    if (match == SecretMatch::kVerified) {
+        return true;
+    }
+    if (match == SecretMatch::kUnknownPath && impl_->refresher.IsUnknownPath(path)) {
+        LOG_WARNING() << "No secret found for path: " << path;
+        return false;
+    }
+    // A notification setting created or a secret rotated after the last update
+    if (impl_->refresher.Refresh(seen_generation)) {
+        match = this->GetUnsafe()->Verify(path, signature, payload, impl_->max_signature_age_seconds, verifier);
+    }
+    if (match == SecretMatch::kUnknownPath) {
+        impl_->refresher.RememberUnknownPath(path);
+        LOG_WARNING() << "No secret found for path: " << path;
+    }
+    return match == SecretMatch::kVerified;
 }
 
-}  // namespace paddle::components
\ No newline at end of file
+}  // namespace paddle::components
@@ -0,0 +1,149 @@
+#include <paddle/handlers/event_coalescer.hpp>
+
+#include <userver/engine/exception.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <numeric>
+
+namespace paddle::handlers {
+
+namespace {
+
+constexpr auto kBatchTaskName = "coalesce-batch";
+
+}  // namespace
+
+auto CoalesceEvents(const std::vector<events::Event<JSON>>& events) -> std::vector<std::size_t> {
+    std::vector<std::size_t> order(events.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&events](std::size_t lhs, std::size_t rhs) {
+        return events[lhs].occurred_at.GetUnderlying() < events[rhs].occurred_at.GetUnderlying();
+    });
+    auto latest_update = std::find_if(order.rbegin(), order.rend(), [&events](std::size_t index) {
+        return events::IsUpdatedEvent(events[index].event_type);
+    });
+    if (latest_update == order.rend()) {
+        return order;
+    }
+    auto latest_index = *latest_update;
+    std::erase_if(order, [&events, latest_index](std::size_t index) {
+        return index != latest_index && events::IsUpdatedEvent(events[index].event_type);
+    });
+    return order;
+}
+
+struct EventCoalescer::Batch {
+    std::vector<JSON> event_jsons;
+    std::vector<events::Event<JSON>> events;
+    std::vector<std::optional<DispatchResult>> results;
+    std::exception_ptr error;
+    /// The window is closed, new events of the entity open the next batch
+    bool closed = false;
+    bool done = false;
+
+    auto Add(const JSON& event_json, events::Event<JSON>&& event) -> std::size_t {
+        event_jsons.push_back(event_json);
+        events.push_back(std::move(event));
+        results.emplace_back();
+        return events.size() - 1;
+    }
+};
+
+EventCoalescer::EventCoalescer(std::chrono::milliseconds window)
+    : window_{window} {
+}
+
+EventCoalescer::~EventCoalescer() = default;
+
+auto EventCoalescer::Submit(
+    const std::string& entity_id,
+    const JSON& event_json,
+    events::Event<JSON>&& event,
+    const DispatchFunction& dispatch
+) -> std::optional<DispatchResult> {
+    std::unique_lock lock{mutex_};
+    auto& queue = batches_[entity_id];
+    if (!queue.empty() && !queue.back()->closed) {
+        auto batch = queue.back();
+        auto index = batch->Add(event_json, std::move(event));
+        return WaitForResult(lock, batch, index);
+    }
+    auto batch = std::make_shared<Batch>();
+    batch->Add(event_json, std::move(event));
+    queue.push_back(batch);
+    bts_.AsyncDetach(kBatchTaskName, [this, entity_id, batch, dispatch] { Run(entity_id, batch, dispatch); });
+    return WaitForResult(lock, batch, 0);
+}
+
+auto EventCoalescer::Run(
+    const std::string& entity_id,
+    const std::shared_ptr<Batch>& batch,
+    const DispatchFunction& dispatch
+) -> void {
+    userver::engine::InterruptibleSleepFor(window_);
+    {
+        std::unique_lock lock{mutex_};
+        // Events arriving from now on open a new window
+        batch->closed = true;
+        // The previous batch of the entity is still being dispatched
+        const auto is_first = [this, &entity_id, &batch] { return batches_.at(entity_id).front() == batch; };
+        if (!batch_done_.Wait(lock, is_first)) {
+            batch->error = std::make_exception_ptr(
+                userver::engine::WaitInterruptedException(userver::engine::current_task::CancellationReason())
+            );
+            lock.unlock();
+            Finish(entity_id, batch);
+            return;
+        }
+    }
+    Process(*batch, dispatch);
+    Finish(entity_id, batch);
+}
+
+auto EventCoalescer::Process(Batch& batch, const DispatchFunction& dispatch) -> void {
+    auto order = CoalesceEvents(batch.events);
+    if (order.size() < batch.events.size()) {
+        LOG_INFO() << "Coalesced " << batch.events.size() << " buffered events into " << order.size();
+    }
+    try {
+        for (auto index : order) {
+            batch.results[index] = dispatch(batch.event_jsons[index], std::move(batch.events[index]));
+        }
+    } catch (const std::exception&) {
+        batch.error = std::current_exception();
+    }
+}
+
+auto EventCoalescer::Finish(const std::string& entity_id, const std::shared_ptr<Batch>& batch) -> void {
+    std::lock_guard lock{mutex_};
+    auto it = batches_.find(entity_id);
+    std::erase(it->second, batch);
+    if (it->second.empty()) {
+        batches_.erase(it);
+    }
+    batch->done = true;
+    batch_done_.NotifyAll();
+}
+
+auto EventCoalescer::WaitForResult(
+    std::unique_lock<userver::engine::Mutex>& lock,
+    const std::shared_ptr<Batch>& batch,
+    std::size_t index
+) -> std::optional<DispatchResult> {
+    if (!batch_done_.Wait(lock, [&batch] { return batch->done; })) {
+        throw userver::engine::WaitInterruptedException(userver::engine::current_task::CancellationReason());
+    }
+    if (batch->results[index]) {
+        return batch->results[index];
+    }
+    if (batch->error) {
+        std::rethrow_exception(batch->error);
+    }
+    return std::nullopt;
+}
+
+}  // namespace paddle::handlers
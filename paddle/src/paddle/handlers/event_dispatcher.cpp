@@ -0,0 +1,519 @@
+#include <paddle/handlers/event_dispatcher.hpp>
+
+#include <paddle/handlers/address_handler_base.hpp>
+#include <paddle/handlers/api_key_handler_base.hpp>
+#include <paddle/handlers/business_handler_base.hpp>
+#include <paddle/handlers/client_token_handler_base.hpp>
+#include <paddle/handlers/customer_handler_base.hpp>
+#include <paddle/handlers/payment_method_handler_base.hpp>
+#include <paddle/handlers/price_handler_base.hpp>
+#include <paddle/handlers/product_handler_base.hpp>
+#include <paddle/handlers/subscription_handler_base.hpp>
+#include <paddle/handlers/transaction_handler_base.hpp>
+
+#include <paddle/handlers/handler_slots.hpp>
+#include <paddle/handlers/handlers.hpp>
+#include <paddle/handlers/snapshot_store.hpp>
+
+#include <paddle/types/api_keys.hpp>
+#include <paddle/types/changes.hpp>
+#include <paddle/types/client_token.hpp>
+#include <paddle/types/customers.hpp>
+#include <paddle/types/events.hpp>
+#include <paddle/types/price.hpp>
+#include <paddle/types/product.hpp>
+#include <paddle/types/subscription_view.hpp>
+#include <paddle/types/subscriptions.hpp>
+#include <paddle/types/transaction_view.hpp>
+#include <paddle/types/transactions.hpp>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/concurrent/background_task_storage_core.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/current_task.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/recentperiod.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace paddle::handlers {
+
+namespace engine = userver::engine;
+namespace statistics = userver::utils::statistics;
+
+namespace {
+
+constexpr auto kStatisticsPrefix = "paddle.handlers";
+constexpr auto kHandleEventTaskName = "handle-event";
+constexpr auto kCategoryCount = static_cast<std::size_t>(events::EventCategory::kUnknown) + 1;
+constexpr std::size_t kDefaultSnapshotsMaxSize = 10000;
+constexpr std::chrono::milliseconds kDefaultQueueTimeout{1000};
+
+struct CategoryKey {
+    events::EventCategory category;
+    std::string_view key;
+};
+
+/// Categories that can have a handler, keys match the handler names in config
+constexpr std::array kCategoryKeys{
+    CategoryKey{events::EventCategory::kTransaction, "transactions"},
+    CategoryKey{events::EventCategory::kSubscription, "subscriptions"},
+    CategoryKey{events::EventCategory::kCustomer, "customers"},
+    CategoryKey{events::EventCategory::kPaymentMethod, "payment_methods"},
+    CategoryKey{events::EventCategory::kPrice, "prices"},
+    CategoryKey{events::EventCategory::kProduct, "products"},
+    CategoryKey{events::EventCategory::kAddress, "addresses"},
+    CategoryKey{events::EventCategory::kBusiness, "businesses"},
+    CategoryKey{events::EventCategory::kApiKey, "api_keys"},
+    CategoryKey{events::EventCategory::kClientToken, "client_tokens"},
+};
+
+/// Milliseconds, 1 ms resolution below 1 s and 100 ms resolution up to 30 s
+using TimingPercentile = statistics::Percentile<1000, std::uint32_t, 290, 100>;
+
+struct CategoryStatistics {
+    std::atomic<std::uint64_t> dispatched{0};
+    std::atomic<std::uint64_t> failed{0};
+    std::atomic<std::uint64_t> timeouts{0};
+    std::atomic<std::uint64_t> rejected{0};
+    std::atomic<std::uint64_t> slow{0};
+    std::atomic<std::uint64_t> skipped{0};
+    std::atomic<std::int64_t> in_flight{0};
+    statistics::RecentPeriod<TimingPercentile, TimingPercentile> timings;
+};
+
+struct CategoryExecutor {
+    std::string_view name;
+    std::string task_processor_name;
+    bool isolated;
+    /// Null unless isolated, handlers then stay on the task processor of the caller
+    engine::TaskProcessor* task_processor;
+    std::unique_ptr<HandlerSlots> slots;
+    std::chrono::milliseconds timeout;
+    std::chrono::milliseconds slow_threshold;
+    std::vector<std::string> watched_fields;
+    CategoryStatistics stats;
+    // Destroyed first, background handlers still use the statistics
+    userver::concurrent::BackgroundTaskStorageCore bts;
+
+    CategoryExecutor(
+        std::string_view name,
+        const userver::yaml_config::YamlConfig& config,
+        const userver::components::ComponentContext& context
+    )
+        : name{name}
+        , task_processor_name{config["task_processor"].As<std::string>("")}
+        , isolated{!task_processor_name.empty()}
+        , task_processor{isolated ? &context.GetTaskProcessor(task_processor_name) : nullptr}
+        , timeout{config["timeout"].As<std::chrono::milliseconds>(std::chrono::milliseconds{0})}
+        , slow_threshold{config["slow_threshold"].As<std::chrono::milliseconds>(std::chrono::milliseconds{0})}
+        , watched_fields{config["watched_fields"].As<std::vector<std::string>>(std::vector<std::string>{})} {
+        const auto max_concurrency = config["max_concurrency"].As<std::size_t>(0);
+        if (max_concurrency > 0) {
+            slots = std::make_unique<HandlerSlots>(
+                max_concurrency, config["queue_timeout"].As<std::chrono::milliseconds>(kDefaultQueueTimeout)
+            );
+        }
+    }
+
+    /// Resolved on every run, so that handlers of a shared category run where the event was received
+    auto GetTaskProcessor() const -> engine::TaskProcessor& {
+        return task_processor ? *task_processor : engine::current_task::GetTaskProcessor();
+    }
+
+    auto GetDeadline() const -> engine::Deadline {
+        if (timeout.count() > 0) {
+            return engine::Deadline::FromDuration(timeout);
+        }
+        return engine::Deadline{};
+    }
+
+    /// An update that changed none of the watched fields is not worth running the handler for
+    auto IsIrrelevant(const events::Event<JSON>& event) const -> bool {
+        if (watched_fields.empty() || !event.changes.IsKnown() || !events::IsUpdatedEvent(event.event_type)) {
+            return false;
+        }
+        return std::none_of(watched_fields.begin(), watched_fields.end(), [&event](const std::string& path) {
+            return event.changes.Contains(path);
+        });
+    }
+
+    auto WriteStatistics(statistics::Writer& writer) const -> void {
+        writer["dispatched"] = stats.dispatched.load();
+        writer["failed"] = stats.failed.load();
+        writer["timeouts"] = stats.timeouts.load();
+        writer["rejected"] = stats.rejected.load();
+        writer["slow"] = stats.slow.load();
+        writer["skipped"] = stats.skipped.load();
+        writer["in-flight"] = stats.in_flight.load();
+        writer["max-concurrency"] = static_cast<std::uint64_t>(slots ? slots->GetMaxConcurrency() : 0);
+        auto timings = stats.timings.GetStatsForPeriod();
+        auto timings_writer = writer["timings"];
+        timings_writer["p50"] = static_cast<std::uint64_t>(timings.GetPercentile(50));
+        timings_writer["p95"] = static_cast<std::uint64_t>(timings.GetPercentile(95));
+        timings_writer["p99"] = static_cast<std::uint64_t>(timings.GetPercentile(99));
+    }
+};
+
+class InFlightGuard {
+public:
+    explicit InFlightGuard(std::atomic<std::int64_t>& in_flight)
+        : in_flight_{in_flight} {
+        ++in_flight_;
+    }
+    ~InFlightGuard() {
+        --in_flight_;
+    }
+
+    InFlightGuard(const InFlightGuard&) = delete;
+    InFlightGuard& operator=(const InFlightGuard&) = delete;
+
+private:
+    std::atomic<std::int64_t>& in_flight_;
+};
+
+}  // namespace
+
+struct EventDispatcher::Impl {
+    Handlers handlers;
+    // Outlives the executors, background handlers store the snapshots when they finish
+    std::unique_ptr<SnapshotStoreBase> own_snapshot_store;
+    SnapshotStoreBase* snapshot_store = nullptr;
+    // Outlives the executors, background handlers report their timings when they finish
+    LatencyObserver latency_observer;
+    std::array<std::unique_ptr<CategoryExecutor>, kCategoryCount> executors;
+    statistics::Entry statistics_holder;
+
+    Impl(
+        const userver::components::ComponentConfig& config,
+        const userver::components::ComponentContext& context,
+        LatencyObserver latency_observer
+    )
+        : handlers{config, context}
+        , latency_observer{std::move(latency_observer)} {
+        const auto execution = config["execution"];
+        for (const auto& [category, key] : kCategoryKeys) {
+            executors[static_cast<std::size_t>(category)] =
+                std::make_unique<CategoryExecutor>(key, execution[std::string{key}], context);
+        }
+        const auto snapshots = config["snapshots"];
+        if (!snapshots.IsMissing()) {
+            const auto store_name = snapshots["store"].As<std::string>("");
+            if (store_name.empty()) {
+                own_snapshot_store = std::make_unique<LruSnapshotStore>(
+                    snapshots["max_size"].As<std::size_t>(kDefaultSnapshotsMaxSize)
+                );
+                snapshot_store = own_snapshot_store.get();
+            } else {
+                snapshot_store = context.FindComponentOptional<SnapshotStoreBase>(store_name);
+                if (!snapshot_store) {
+                    throw std::runtime_error{fmt::format("Snapshot store component '{}' not found", store_name)};
+                }
+            }
+        }
+        statistics_holder =
+            context.FindComponent<userver::components::StatisticsStorage>().GetStorage().RegisterWriter(
+                kStatisticsPrefix,
+                [this](statistics::Writer& writer) { WriteStatistics(writer); },
+                {{"paddle_dispatcher", config.Name()}}
+            );
+    }
+
+    ~Impl() {
+        statistics_holder.Unregister();
+    }
+
+    auto WriteStatistics(statistics::Writer& writer) const -> void {
+        for (const auto& executor : executors) {
+            if (executor) {
+                auto category_writer = writer[executor->name];
+                executor->WriteStatistics(category_writer);
+            }
+        }
+    }
+
+    auto Dispatch(
+        const JSON& event_json,
+        events::Event<JSON>&& event,
+        bool in_background,
+        const CompletionCallback& on_complete
+    ) const -> DispatchResult {
+        auto dispatch = [&](const auto* handler) {
+            return DispatchTo(handler, event_json, std::move(event), in_background, on_complete);
+        };
+        auto category = events::GetEventCategory(event.event_type);
+        switch (category) {
+            case events::EventCategory::kTransaction:
+                if (handlers.transaction_view_handler) {
+                    return dispatch(handlers.transaction_view_handler);
+                }
+                return dispatch(handlers.transaction_handler);
+            case events::EventCategory::kSubscription:
+                if (handlers.subscription_view_handler) {
+                    return dispatch(handlers.subscription_view_handler);
+                }
+                return dispatch(handlers.subscription_handler);
+            case events::EventCategory::kCustomer:
+                return dispatch(handlers.customer_handler);
+            case events::EventCategory::kPaymentMethod:
+                return dispatch(handlers.payment_method_handler);
+            case events::EventCategory::kPrice:
+                return dispatch(handlers.price_handler);
+            case events::EventCategory::kProduct:
+                return dispatch(handlers.product_handler);
+            case events::EventCategory::kAddress:
+                return dispatch(handlers.address_handler);
+            case events::EventCategory::kBusiness:
+                return dispatch(handlers.business_handler);
+            case events::EventCategory::kApiKey:
+                return dispatch(handlers.api_key_handler);
+            case events::EventCategory::kClientToken:
+                return dispatch(handlers.client_token_handler);
+            default:
+                LOG_INFO() << "Event handling not implemented for event category: " << category;
+                return DispatchResult::kUnsupported;
+        }
+    }
+
+    template <typename T>
+    auto DispatchTo(
+        const T* handler,
+        const JSON& event_json,
+        events::Event<JSON>&& event,
+        bool in_background,
+        const CompletionCallback& on_complete
+    ) const -> DispatchResult {
+        using EventType = typename T::EventType;
+        using PayloadType = typename EventType::PayloadType;
+        if (!handler) {
+            LOG_INFO() << "No event handler configured for event category: " << T::kEventCategory;
+            return DispatchResult::kNoHandler;
+        }
+        auto& executor = *executors[static_cast<std::size_t>(T::kEventCategory)];
+        // Stored only once the event is handled, so that a retry of a failed event sees the same changes
+        auto snapshot = snapshot_store ? TrackChanges(*snapshot_store, event) : PendingSnapshot{};
+        if (executor.IsIrrelevant(event)) {
+            ++executor.stats.skipped;
+            snapshot.Commit();
+            LOG_INFO() << "Skipping " << event.event_type << " " << event.event_id << ": no watched fields changed";
+            return DispatchResult::kSkipped;
+        }
+        // Payload is parsed by the caller, so that malformed events are reported to the sender
+        auto typed_event = events::ParsePayload<PayloadType>(std::move(event));
+        ++executor.stats.dispatched;
+        if (in_background) {
+            executor.bts.Detach(userver::utils::Async(
+                executor.GetTaskProcessor(),
+                kHandleEventTaskName,
+                [this, &executor, handler, on_complete](JSON event_json, EventType event, PendingSnapshot snapshot) {
+                    try {
+                        Execute(executor, event.event_type, true, [&] {
+                            handler->HandleEvent(event_json, std::move(event));
+                        });
+                        snapshot.Commit();
+                    } catch (const std::exception& e) {
+                        LOG_ERROR() << "Error handling event in background: " << e.what();
+                        if (on_complete) {
+                            on_complete(std::current_exception());
+                        }
+                        return;
+                    }
+                    if (on_complete) {
+                        on_complete(nullptr);
+                    }
+                },
+                event_json,
+                std::move(typed_event),
+                std::move(snapshot)
+            ));
+            return DispatchResult::kScheduled;
+        }
+        try {
+            Execute(executor, typed_event.event_type, false, [&] {
+                handler->HandleEvent(event_json, std::move(typed_event));
+            });
+            snapshot.Commit();
+        } catch (const std::exception&) {
+            if (on_complete) {
+                on_complete(std::current_exception());
+            }
+            throw;
+        }
+        if (on_complete) {
+            on_complete(nullptr);
+        }
+        return DispatchResult::kHandled;
+    }
+
+    /// Runs the function within the category limits, hopping to the category task processor if needed
+    template <typename Function>
+    auto Execute(
+        CategoryExecutor& executor,
+        events::EventTypeName event_type,
+        bool on_executor_processor,
+        Function&& function
+    ) const -> void {
+        auto& stats = executor.stats;
+        const auto deadline = executor.GetDeadline();
+        engine::SemaphoreLock lock;
+        if (executor.slots) {
+            lock = executor.slots->Acquire(deadline);
+            if (!lock.OwnsLock()) {
+                ++stats.rejected;
+                throw HandlerConcurrencyLimitError{fmt::format(
+                    "No free slot for {} handler, max concurrency {}",
+                    executor.name,
+                    executor.slots->GetMaxConcurrency()
+                )};
+            }
+        }
+        InFlightGuard in_flight{stats.in_flight};
+        const auto started_at = std::chrono::steady_clock::now();
+        try {
+            if ((executor.isolated && !on_executor_processor) || deadline.IsReachable()) {
+                auto task = userver::utils::Async(executor.GetTaskProcessor(), kHandleEventTaskName, function);
+                task.WaitUntil(deadline);
+                if (!task.IsFinished()) {
+                    task.SyncCancel();
+                    if (!deadline.IsReached()) {
+                        throw engine::WaitInterruptedException(engine::current_task::CancellationReason());
+                    }
+                    ++stats.timeouts;
+                    throw HandlerTimeoutError{
+                        fmt::format("{} handler timed out after {} ms", executor.name, executor.timeout.count())
+                    };
+                }
+                task.Get();
+            } else {
+                function();
+            }
+        } catch (const std::exception&) {
+            ++stats.failed;
+            AccountTiming(executor, event_type, started_at);
+            throw;
+        }
+        AccountTiming(executor, event_type, started_at);
+    }
+
+    auto AccountTiming(
+        CategoryExecutor& executor,
+        events::EventTypeName event_type,
+        std::chrono::steady_clock::time_point started_at
+    ) const -> void {
+        const auto elapsed =
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started_at);
+        executor.stats.timings.GetCurrentCounter().Account(static_cast<std::uint32_t>(elapsed.count()));
+        if (latency_observer) {
+            latency_observer(event_type, elapsed);
+        }
+        if (executor.slow_threshold.count() > 0 && elapsed >= executor.slow_threshold) {
+            ++executor.stats.slow;
+            LOG_WARNING() << "Slow " << executor.name << " handler for " << event_type << ": " << elapsed.count()
+                          << " ms, in flight: " << executor.stats.in_flight.load();
+        }
+    }
+};
+
+EventDispatcher::EventDispatcher(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context,
+    LatencyObserver latency_observer
+)
+    : impl_{config, context, std::move(latency_observer)} {
+}
+
+EventDispatcher::~EventDispatcher() = default;
+
+auto EventDispatcher::Dispatch(
+    const JSON& event_json,
+    events::Event<JSON>&& event,
+    bool in_background,
+    CompletionCallback on_complete
+) const -> DispatchResult {
+    return impl_->Dispatch(event_json, std::move(event), in_background, on_complete);
+}
+
+auto EventDispatcher::GetConfigSchema() -> std::string {
+    std::string categories;
+    for (const auto& [category, key] : kCategoryKeys) {
+        categories += fmt::format(
+            R"(
+        {}:
+            type: object
+            description: Execution settings for {} event handlers
+            additionalProperties: false
+            properties:
+                task_processor:
+                    type: string
+                    description: Task processor to run the handlers on (caller's task processor by default)
+                max_concurrency:
+                    type: integer
+                    minimum: 0
+                    description: Maximum number of concurrently running handlers (0 - unlimited)
+                queue_timeout:
+                    type: string
+                    description: |
+                        How long a handler waits for a free slot before the event is rejected, never longer
+                        than `timeout` (1s by default, 0 - rejected right away)
+                timeout:
+                    type: string
+                    description: Handler deadline, the handler task is cancelled when it expires (0 - no deadline)
+                slow_threshold:
+                    type: string
+                    description: Handlers running longer than this are reported as slow (0 - disabled)
+                watched_fields:
+                    type: array
+                    description: |
+                        Dotted field paths the handlers depend on. An `*.updated` event that
+                        changed none of them is skipped (requires `snapshots`)
+                    items:
+                        type: string
+                        description: Field path, e.g. `status` or `billing_details.payment_terms`)",
+            key,
+            EnumToString(category)
+        );
+    }
+    return fmt::format(
+        R"(
+    execution:
+        type: object
+        description: Per-category handler execution settings
+        additionalProperties: false
+        properties:{}
+    snapshots:
+        type: object
+        description: Keep the last seen entity snapshots to compute the changes of each event
+        additionalProperties: false
+        properties:
+            max_size:
+                type: integer
+                minimum: 1
+                description: Maximum number of entities in the in-memory store (default {})
+            store:
+                type: string
+                description: Name of a component implementing SnapshotStoreBase to use instead of the in-memory store
+)",
+        categories,
+        kDefaultSnapshotsMaxSize
+    );
+}
+
+}  // namespace paddle::handlers
@@ -0,0 +1,141 @@
+#include <paddle/handlers/event_filter.hpp>
+
+#include <paddle/types/raw_json.hpp>
+
+#include <userver/yaml_config/yaml_config.hpp>
+
+#include <algorithm>
+
+namespace paddle::handlers {
+
+namespace {
+
+/// Notifications sent by the webhook simulator have this id prefix
+constexpr std::string_view kSimulationNotificationPrefix = "ntfsim_";
+
+auto MatchesPattern(std::string_view pattern, std::string_view event_type) -> bool {
+    if (pattern.ends_with('*')) {
+        return event_type.starts_with(pattern.substr(0, pattern.size() - 1));
+    }
+    return pattern == event_type;
+}
+
+auto MatchesAny(const std::vector<std::string>& patterns, std::string_view event_type) -> bool {
+    return std::any_of(patterns.begin(), patterns.end(), [event_type](const std::string& pattern) {
+        return MatchesPattern(pattern, event_type);
+    });
+}
+
+/// Strings are compared decoded, other values by their JSON text (e.g. `true` or `42`)
+auto IsEqual(std::string_view raw_value, std::string_view expected) -> bool {
+    if (auto decoded = raw_json::DecodeString(raw_value)) {
+        return *decoded == expected;
+    }
+    return raw_value == expected;
+}
+
+}  // namespace
+
+EventFilterConfig Parse(const userver::yaml_config::YamlConfig& value, userver::formats::parse::To<EventFilterConfig>) {
+    EventFilterConfig config;
+    const auto event_types = value["event_types"];
+    config.allowed_event_types = event_types["allow"].As<std::vector<std::string>>(std::vector<std::string>{});
+    config.denied_event_types = event_types["deny"].As<std::vector<std::string>>(std::vector<std::string>{});
+    config.traffic_source = value["traffic_source"].As<events::TrafficSource>(events::TrafficSource::kAll);
+    const auto custom_data = value["custom_data"];
+    if (!custom_data.IsMissing()) {
+        for (auto it = custom_data.begin(); it != custom_data.end(); ++it) {
+            config.custom_data.emplace_back(it.GetName(), it->As<std::string>());
+        }
+    }
+    return config;
+}
+
+EventFilter::EventFilter(EventFilterConfig config)
+    : config_{std::move(config)} {
+}
+
+auto EventFilter::IsEmpty() const -> bool {
+    return config_.allowed_event_types.empty() && config_.denied_event_types.empty() &&
+           config_.traffic_source == events::TrafficSource::kAll && config_.custom_data.empty();
+}
+
+auto EventFilter::Evaluate(std::string_view raw_event) const -> FilterVerdict {
+    if (!config_.allowed_event_types.empty() || !config_.denied_event_types.empty()) {
+        auto raw_event_type = raw_json::FindValue(raw_event, {"event_type"});
+        auto event_type = raw_event_type ? raw_json::DecodeString(*raw_event_type) : std::nullopt;
+        if (event_type && !IsEventTypeAccepted(*event_type)) {
+            return FilterVerdict::kEventType;
+        }
+    }
+    if (config_.traffic_source != events::TrafficSource::kAll) {
+        auto raw_notification_id = raw_json::FindValue(raw_event, {"notification_id"});
+        auto notification_id = raw_notification_id ? raw_json::DecodeString(*raw_notification_id) : std::nullopt;
+        if (notification_id) {
+            auto is_simulation = notification_id->starts_with(kSimulationNotificationPrefix);
+            if (is_simulation != (config_.traffic_source == events::TrafficSource::kSimulation)) {
+                return FilterVerdict::kTrafficSource;
+            }
+        }
+    }
+    if (!config_.custom_data.empty()) {
+        auto custom_data = raw_json::FindValue(raw_event, {"data", "custom_data"});
+        for (const auto& [key, expected] : config_.custom_data) {
+            auto value = custom_data ? raw_json::FindValue(*custom_data, {key}) : std::nullopt;
+            if (!value || !IsEqual(*value, expected)) {
+                return FilterVerdict::kCustomData;
+            }
+        }
+    }
+    return FilterVerdict::kAccepted;
+}
+
+auto EventFilter::IsEventTypeAccepted(std::string_view event_type) const -> bool {
+    if (MatchesAny(config_.denied_event_types, event_type)) {
+        return false;
+    }
+    return config_.allowed_event_types.empty() || MatchesAny(config_.allowed_event_types, event_type);
+}
+
+auto EventFilter::GetConfigSchema() -> std::string {
+    return R"(
+    filters:
+        type: object
+        description: Drop events before parsing them, all of the configured predicates must hold
+        additionalProperties: false
+        properties:
+            event_types:
+                type: object
+                description: Event type lists, `prefix.*` wildcards are supported
+                additionalProperties: false
+                properties:
+                    allow:
+                        type: array
+                        description: Accepted event types, all by default
+                        items:
+                            type: string
+                            description: Event type or wildcard
+                    deny:
+                        type: array
+                        description: Dropped event types, take precedence over the accepted ones
+                        items:
+                            type: string
+                            description: Event type or wildcard
+            traffic_source:
+                type: string
+                enum:
+                  - platform
+                  - simulation
+                  - all
+                description: Accept only events from the platform or the webhook simulator (all by default)
+            custom_data:
+                type: object
+                description: Accept only events with these `data.custom_data` values
+                additionalProperties:
+                    type: string
+                    description: Expected value
+                properties: {}
+)";
+}
+
+}  // namespace paddle::handlers
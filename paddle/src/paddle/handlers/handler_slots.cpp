@@ -0,0 +1,27 @@
+#include <paddle/handlers/handler_slots.hpp>
+
+#include <mutex>
+
+namespace paddle::handlers {
+
+HandlerSlots::HandlerSlots(std::size_t max_concurrency, std::chrono::milliseconds queue_timeout)
+    : max_concurrency_{max_concurrency}
+    , queue_timeout_{queue_timeout}
+    , semaphore_{max_concurrency} {
+}
+
+auto HandlerSlots::GetMaxConcurrency() const -> std::size_t {
+    return max_concurrency_;
+}
+
+auto HandlerSlots::Acquire(userver::engine::Deadline deadline) -> userver::engine::SemaphoreLock {
+    if (queue_timeout_.count() <= 0) {
+        return userver::engine::SemaphoreLock{semaphore_, std::try_to_lock};
+    }
+    if (!deadline.IsReachable() || deadline.TimeLeft() > queue_timeout_) {
+        deadline = userver::engine::Deadline::FromDuration(queue_timeout_);
+    }
+    return userver::engine::SemaphoreLock{semaphore_, deadline};
+}
+
+}  // namespace paddle::handlers
@@ -16,6 +16,8 @@
 
 #include <userver/yaml_config/merge_schemas.hpp>
 
+#include <stdexcept>
+
 namespace paddle::handlers {
 
 Handlers::Handlers(
@@ -26,10 +28,24 @@ Handlers::Handlers(
     if (!transaction_handler_name.empty()) {
         transaction_handler = &context.FindComponent<TransactionHandlerBase>(transaction_handler_name);
     }
+    auto transaction_view_handler_name = config["transaction_views"].As<std::string>("");
+    if (!transaction_view_handler_name.empty()) {
+        if (transaction_handler) {
+            throw std::runtime_error("Only one of transactions and transaction_views handlers can be configured");
+        }
+        transaction_view_handler = &context.FindComponent<TransactionViewHandlerBase>(transaction_view_handler_name);
+    }
     auto subscription_handler_name = config["subscriptions"].As<std::string>("");
     if (!subscription_handler_name.empty()) {
         subscription_handler = &context.FindComponent<SubscriptionHandlerBase>(subscription_handler_name);
     }
+    auto subscription_view_handler_name = config["subscription_views"].As<std::string>("");
+    if (!subscription_view_handler_name.empty()) {
+        if (subscription_handler) {
+            throw std::runtime_error("Only one of subscriptions and subscription_views handlers can be configured");
+        }
+        subscription_view_handler = &context.FindComponent<SubscriptionViewHandlerBase>(subscription_view_handler_name);
+    }
     auto customer_handler_name = config["customers"].As<std::string>("");
     if (!customer_handler_name.empty()) {
         customer_handler = &context.FindComponent<CustomerHandlerBase>(customer_handler_name);
@@ -64,14 +80,58 @@ Handlers::Handlers(
     }
 }
 
+auto Handlers::Handles(events::EventCategory category) const -> bool {
+    switch (category) {
+        case events::EventCategory::kTransaction:
+            return transaction_handler != nullptr || transaction_view_handler != nullptr;
+        case events::EventCategory::kSubscription:
+            return subscription_handler != nullptr || subscription_view_handler != nullptr;
+        case events::EventCategory::kCustomer:
+            return customer_handler != nullptr;
+        case events::EventCategory::kPaymentMethod:
+            return payment_method_handler != nullptr;
+        case events::EventCategory::kPrice:
+            return price_handler != nullptr;
+        case events::EventCategory::kProduct:
+            return product_handler != nullptr;
+        case events::EventCategory::kAddress:
+            return address_handler != nullptr;
+        case events::EventCategory::kBusiness:
+            return business_handler != nullptr;
+        case events::EventCategory::kApiKey:
+            return api_key_handler != nullptr;
+        case events::EventCategory::kClientToken:
+            return client_token_handler != nullptr;
+        default:
+            return false;
+    }
+}
+
+auto Handlers::GetHandledEventTypes() const -> std::vector<events::EventTypeName> {
+    std::vector<events::EventTypeName> event_types;
+    for (std::size_t index = 0; index < events::kEventTypeNameCount; ++index) {
+        auto event_type = static_cast<events::EventTypeName>(index);
+        if (Handles(events::GetEventCategory(event_type))) {
+            event_types.push_back(event_type);
+        }
+    }
+    return event_types;
+}
+
 auto Handlers::GetHanderNames() -> std::string_view {
     return R"(
     transactions:
         type: string
         description: Component name for transaction event handlers
+    transaction_views:
+        type: string
+        description: Component name for transaction event handlers taking TransactionView, instead of transactions
     subscriptions:
         type: string
         description: Component name for subscription event handlers
+    subscription_views:
+        type: string
+        description: Component name for subscription event handlers taking SubscriptionView, instead of subscriptions
     customers:
         type: string
         description: Component name for customer event handlers
@@ -0,0 +1,334 @@
+#include <paddle/handlers/replay_admin_handler.hpp>
+
+#include <paddle/components/event_replay_controller.hpp>
+#include <paddle/types/event_query.hpp>
+#include <paddle/types/events.hpp>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/server/handlers/exceptions.hpp>
+#include <userver/server/http/http_request.hpp>
+#include <userver/server/http/http_response_body_stream.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/scope_guard.hpp>
+#include <userver/utils/uuid4.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace paddle::handlers {
+
+namespace engine = userver::engine;
+namespace uhandlers = userver::server::handlers;
+
+namespace {
+
+constexpr std::chrono::milliseconds kDefaultProgressInterval{1000};
+constexpr auto kReplayJobTaskName = "paddle-replay-job";
+constexpr auto kNdjsonContentType = "application/x-ndjson";
+constexpr auto kJsonContentType = "application/json";
+constexpr auto kJobIdArg = "job_id";
+
+using Seconds = std::chrono::duration<double>;
+
+struct JobRequest {
+    std::string cursor;
+    events::EventQuery query;
+    components::ReplayOptions options;
+};
+
+[[noreturn]] void ThrowBadRequest(const std::string& message) {
+    throw uhandlers::ClientError(uhandlers::InternalMessage{message}, uhandlers::ExternalBody{message});
+}
+
+auto ParseJobRequest(const std::string& body) -> JobRequest {
+    JobRequest job;
+    if (body.empty()) {
+        return job;
+    }
+    try {
+        const auto json = userver::formats::json::FromString(body);
+        job.cursor = json["cursor"].As<std::string>("");
+        for (const auto& pattern : json["event_types"].As<std::vector<std::string>>(std::vector<std::string>{})) {
+            auto event_types = events::ExpandEventTypes(pattern);
+            job.query.event_types.insert(job.query.event_types.end(), event_types.begin(), event_types.end());
+        }
+        job.query.occurred_after = json["occurred_after"].As<std::optional<Timestamp>>();
+        job.query.occurred_before = json["occurred_before"].As<std::optional<Timestamp>>();
+        job.query.entity_ids = json["entity_ids"].As<std::vector<std::string>>(std::vector<std::string>{});
+        job.options.concurrency = json["concurrency"].As<std::optional<std::size_t>>();
+        job.options.max_rate = json["max_rate"].As<double>(0);
+        auto source = json["source"].As<std::string>("api");
+        if (source != "api" && source != "archive") {
+            ThrowBadRequest(fmt::format("Unknown replay source: {}", source));
+        }
+        job.options.from_archive = source == "archive";
+    } catch (const uhandlers::ClientError&) {
+        throw;
+    } catch (const std::exception& e) {
+        ThrowBadRequest(fmt::format("Invalid replay job: {}", e.what()));
+    }
+    return job;
+}
+
+/// Previous report of a progress stream, the current rates are computed against it
+struct LastReport {
+    std::chrono::steady_clock::time_point reported_at = std::chrono::steady_clock::now();
+    std::uint64_t replayed = 0;
+    std::optional<std::chrono::system_clock::time_point> occurred_at;
+};
+
+/// Replayed events of a job, updated by the replay and read by the progress reports
+class JobProgress {
+public:
+    explicit JobProgress(std::string job_id)
+        : job_id_{std::move(job_id)} {
+    }
+
+    void Account(const events::Event<JSON>& event) {
+        std::lock_guard lock{mutex_};
+        ++replayed_;
+        cursor_ = event.event_id.ToString();
+        occurred_at_ = event.occurred_at.GetUnderlying();
+        ++categories_[std::string{EnumToString(events::GetEventCategory(event.event_type))}];
+    }
+
+    [[nodiscard]] auto GetJobId() const -> const std::string& {
+        return job_id_;
+    }
+
+    /// @param last previous report of the same stream for the current rates, updated
+    auto Report(std::string_view status, LastReport* last = nullptr) const -> JSON {
+        const auto now = std::chrono::steady_clock::now();
+        JSON::Builder builder;
+        builder["job_id"] = job_id_;
+        builder["status"] = std::string{status};
+        std::lock_guard lock{mutex_};
+        const auto elapsed = Seconds{now - started_at_}.count();
+        builder["replayed"] = replayed_;
+        builder["elapsed_seconds"] = elapsed;
+        builder["average_events_per_second"] = elapsed > 0 ? static_cast<double>(replayed_) / elapsed : 0.0;
+        if (!cursor_.empty()) {
+            builder["cursor"] = cursor_;
+        }
+        std::optional<double> lag;
+        if (occurred_at_) {
+            // The head of the event stream is now, events are replayed in order
+            lag = Seconds{std::chrono::system_clock::now() - *occurred_at_}.count();
+            builder["lag_seconds"] = *lag;
+        }
+        if (last) {
+            const auto interval = Seconds{now - last->reported_at}.count();
+            if (interval > 0) {
+                builder["events_per_second"] = static_cast<double>(replayed_ - last->replayed) / interval;
+            }
+            // Event time covered per second of replay
+            if (lag && last->occurred_at && interval > 0) {
+                const auto catch_up_speed = Seconds{*occurred_at_ - *last->occurred_at}.count() / interval;
+                if (catch_up_speed > 0) {
+                    builder["eta_seconds"] = *lag / catch_up_speed;
+                }
+            }
+            *last = LastReport{now, replayed_, occurred_at_};
+        }
+        JSON::Builder categories{userver::formats::common::Type::kObject};
+        for (const auto& [category, count] : categories_) {
+            categories[category] = count;
+        }
+        builder["categories"] = categories.ExtractValue();
+        return builder.ExtractValue();
+    }
+
+private:
+    const std::string job_id_;
+    const std::chrono::steady_clock::time_point started_at_ = std::chrono::steady_clock::now();
+    mutable engine::Mutex mutex_;
+    std::uint64_t replayed_ = 0;
+    std::string cursor_;
+    std::optional<std::chrono::system_clock::time_point> occurred_at_;
+    std::map<std::string, std::uint64_t> categories_;
+};
+
+struct RunningJob {
+    engine::TaskCancellationToken cancellation_token;
+    std::shared_ptr<const JobProgress> progress;
+};
+
+void PushLine(userver::server::http::ResponseBodyStream& stream, const JSON& line) {
+    stream.PushBodyChunk(userver::formats::json::ToString(line) + "\n", engine::Deadline{});
+}
+
+void Respond(userver::server::http::ResponseBodyStream& stream, const JSON& body) {
+    stream.SetHeader(std::string{userver::http::headers::kContentType}, kJsonContentType);
+    stream.SetEndOfHeaders();
+    stream.PushBodyChunk(userver::formats::json::ToString(body), engine::Deadline{});
+}
+
+}  // namespace
+
+struct ReplayAdminHandler::Impl {
+    const components::EventReplayController& replay_controller;
+    std::chrono::milliseconds progress_interval;
+    mutable engine::Mutex jobs_mutex;
+    mutable std::unordered_map<std::string, RunningJob> jobs;
+
+    Impl(const userver::components::ComponentConfig& config, const userver::components::ComponentContext& context)
+        : replay_controller{context.FindComponent<components::EventReplayController>(
+              config["replay_controller"].As<std::string>()
+          )}
+        , progress_interval{config["progress_interval"].As<std::chrono::milliseconds>(kDefaultProgressInterval)} {
+    }
+
+    void StartJob(
+        const userver::server::http::HttpRequest& request,
+        userver::server::http::ResponseBodyStream& stream
+    ) const {
+        auto job = ParseJobRequest(request.RequestBody());
+        auto progress = std::make_shared<JobProgress>(userver::utils::generators::GenerateUuid());
+        const auto& job_id = progress->GetJobId();
+        LOG_INFO() << "Starting replay job " << job_id << " since: " << job.cursor;
+
+        auto task = userver::utils::Async(kReplayJobTaskName, [this, job = std::move(job), progress] {
+            replay_controller.ReplaySince(
+                job.cursor,
+                job.query,
+                job.options,
+                [&progress](const events::Event<JSON>& event) { progress->Account(event); }
+            );
+        });
+        {
+            std::lock_guard lock{jobs_mutex};
+            jobs.emplace(job_id, RunningJob{engine::TaskCancellationToken{task}, progress});
+        }
+        userver::utils::ScopeGuard unregister{[this, &job_id] {
+            std::lock_guard lock{jobs_mutex};
+            jobs.erase(job_id);
+        }};
+
+        stream.SetHeader(std::string{userver::http::headers::kContentType}, kNdjsonContentType);
+        stream.SetEndOfHeaders();
+        LastReport last;
+        PushLine(stream, progress->Report("started", &last));
+        while (!task.IsFinished()) {
+            task.WaitFor(progress_interval);
+            // The client is gone, the replay is cancelled with the task
+            if (engine::current_task::ShouldCancel()) {
+                LOG_INFO() << "Replay job " << job_id << " cancelled by the client";
+                return;
+            }
+            if (!task.IsFinished()) {
+                PushLine(stream, progress->Report("running", &last));
+            }
+        }
+
+        const auto cancelled = task.GetCancellationReason() != engine::TaskCancellationReason::kNone;
+        try {
+            task.Get();
+            PushLine(stream, progress->Report("completed", &last));
+        } catch (const std::exception& e) {
+            LOG_WARNING() << "Replay job " << job_id << (cancelled ? " cancelled: " : " failed: ") << e.what();
+            JSON::Builder report{progress->Report(cancelled ? "cancelled" : "failed", &last)};
+            if (!cancelled) {
+                report["error"] = e.what();
+            }
+            PushLine(stream, report.ExtractValue());
+        }
+    }
+
+    void ListJobs(userver::server::http::ResponseBodyStream& stream) const {
+        JSON::Builder list{userver::formats::common::Type::kArray};
+        {
+            std::lock_guard lock{jobs_mutex};
+            for (const auto& [job_id, job] : jobs) {
+                list.PushBack(job.progress->Report("running"));
+            }
+        }
+        Respond(stream, list.ExtractValue());
+    }
+
+    void CancelJob(
+        const userver::server::http::HttpRequest& request,
+        userver::server::http::ResponseBodyStream& stream
+    ) const {
+        const auto& job_id = request.GetArg(kJobIdArg);
+        {
+            std::lock_guard lock{jobs_mutex};
+            auto it = jobs.find(job_id);
+            if (it == jobs.end()) {
+                throw uhandlers::ResourceNotFound(
+                    uhandlers::InternalMessage{fmt::format("Replay job {} not found", job_id)},
+                    uhandlers::ExternalBody{fmt::format("Replay job {} not found", job_id)}
+                );
+            }
+            it->second.cancellation_token.RequestCancel();
+        }
+        LOG_INFO() << "Replay job " << job_id << " cancellation requested";
+        JSON::Builder builder;
+        builder["job_id"] = job_id;
+        builder["status"] = "cancelling";
+        Respond(stream, builder.ExtractValue());
+    }
+};
+
+ReplayAdminHandler::ReplayAdminHandler(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context
+)
+    : BaseType{config, context}
+    , impl_{config, context} {
+}
+
+ReplayAdminHandler::~ReplayAdminHandler() = default;
+
+void ReplayAdminHandler::HandleStreamRequest(
+    const userver::server::http::HttpRequest& request,
+    [[maybe_unused]] userver::server::request::RequestContext& context,
+    userver::server::http::ResponseBodyStream& response_body_stream
+) const {
+    switch (request.GetMethod()) {
+        case userver::server::http::HttpMethod::kPost:
+            impl_->StartJob(request, response_body_stream);
+            return;
+        case userver::server::http::HttpMethod::kGet:
+            impl_->ListJobs(response_body_stream);
+            return;
+        case userver::server::http::HttpMethod::kDelete:
+            impl_->CancelJob(request, response_body_stream);
+            return;
+        default:
+            ThrowBadRequest(fmt::format("Unsupported method {}", request.GetMethodStr()));
+    }
+}
+
+auto ReplayAdminHandler::GetStaticConfigSchema() -> userver::yaml_config::Schema {
+    return userver::yaml_config::MergeSchemas<BaseType>(R"(
+type: object
+description: Paddle event replay admin handler component
+additionalProperties: false
+properties:
+    replay_controller:
+        type: string
+        description: Event replay controller component name
+    progress_interval:
+        type: string
+        description: How often the progress of a replay job is reported (1s by default)
+    )");
+}
+
+}  // namespace paddle::handlers
@@ -0,0 +1,192 @@
+#include <paddle/handlers/replay_throttle.hpp>
+
+#include <userver/engine/exception.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+
+namespace paddle::handlers {
+
+namespace engine = userver::engine;
+
+namespace {
+
+constexpr auto kLatencyPercentile = 95;
+/// Events per second, the adapted rate never drops to 0, which would lift the limit
+constexpr double kRateFloor = 1;
+
+void ThrowIfCancelled() {
+    if (engine::current_task::ShouldCancel()) {
+        throw engine::WaitInterruptedException(engine::current_task::CancellationReason());
+    }
+}
+
+}  // namespace
+
+ReplayThrottleSettings
+Parse(const userver::yaml_config::YamlConfig& value, userver::formats::parse::To<ReplayThrottleSettings>) {
+    ReplayThrottleSettings settings;
+    settings.max_rate = value["max_rate"].As<double>(settings.max_rate);
+    settings.min_rate = value["min_rate"].As<double>(settings.min_rate);
+    settings.latency_target = value["latency_target"].As<std::chrono::milliseconds>(settings.latency_target);
+    settings.increase_step = value["increase_step"].As<double>(settings.increase_step);
+    settings.decrease_factor = value["decrease_factor"].As<double>(settings.decrease_factor);
+    settings.adjust_interval = value["adjust_interval"].As<std::chrono::milliseconds>(settings.adjust_interval);
+    if (settings.max_rate > 0 && settings.min_rate > settings.max_rate) {
+        throw std::runtime_error("Replay throttle min_rate must not exceed max_rate");
+    }
+    if (settings.latency_target.count() > 0 && (settings.min_rate <= 0 || settings.decrease_factor <= 0)) {
+        throw std::runtime_error("Replay throttle min_rate and decrease_factor must be positive with latency_target");
+    }
+    return settings;
+}
+
+RatePacer::RatePacer(double rate)
+    : rate_{std::max(rate, 0.0)} {
+}
+
+auto RatePacer::SetRate(double rate) -> void {
+    rate_ = std::max(rate, 0.0);
+}
+
+auto RatePacer::Reserve(Clock::time_point now) -> Clock::time_point {
+    if (rate_ <= 0) {
+        return now;
+    }
+    // No burst after an idle period, the events are always spaced evenly
+    auto start = std::max(now, next_slot_);
+    next_slot_ = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>{1.0 / rate_});
+    return start;
+}
+
+auto AdjustRate(
+    double rate,
+    double observed_rate,
+    std::chrono::milliseconds p95,
+    const ReplayThrottleSettings& settings
+) -> double {
+    if (settings.latency_target.count() <= 0) {
+        return rate;
+    }
+    if (p95 > settings.latency_target) {
+        // An unlimited replay slows down from the rate it actually achieved
+        auto base = rate > 0 ? std::min(rate, std::max(observed_rate, settings.min_rate)) : observed_rate;
+        auto decreased = std::max(base * settings.decrease_factor, settings.min_rate);
+        return decreased > 0 ? decreased : kRateFloor;
+    }
+    if (rate <= 0) {
+        return rate;
+    }
+    auto increased = rate + settings.increase_step;
+    return settings.max_rate > 0 ? std::min(increased, settings.max_rate) : increased;
+}
+
+ReplayThrottle::ReplayThrottle(ReplayThrottleSettings settings)
+    : settings_{settings}
+    , pacer_{settings.max_rate}
+    , interval_start_{RatePacer::Clock::now()} {
+}
+
+auto ReplayThrottle::Acquire() -> void {
+    RatePacer::Clock::time_point slot;
+    {
+        std::unique_lock lock{mutex_};
+        if (!resumed_.Wait(lock, [this] { return !paused_; })) {
+            ThrowIfCancelled();
+        }
+        slot = pacer_.Reserve(RatePacer::Clock::now());
+    }
+    engine::InterruptibleSleepUntil(slot);
+    ThrowIfCancelled();
+}
+
+auto ReplayThrottle::Account(std::chrono::milliseconds latency) -> void {
+    const auto now = RatePacer::Clock::now();
+    std::lock_guard lock{mutex_};
+    latencies_.Account(static_cast<std::uint32_t>(std::max<std::chrono::milliseconds::rep>(latency.count(), 0)));
+    ++interval_events_;
+    AdjustIfNeeded(now);
+}
+
+auto ReplayThrottle::AdjustIfNeeded(RatePacer::Clock::time_point now) -> void {
+    const auto elapsed = now - interval_start_;
+    if (settings_.latency_target.count() <= 0 || elapsed < settings_.adjust_interval) {
+        return;
+    }
+    const auto p95 = std::chrono::milliseconds{latencies_.GetPercentile(kLatencyPercentile)};
+    const auto observed_rate =
+        static_cast<double>(interval_events_) / std::chrono::duration<double>{elapsed}.count();
+    pacer_.SetRate(AdjustRate(pacer_.GetRate(), observed_rate, p95, settings_));
+    latencies_.Reset();
+    interval_events_ = 0;
+    interval_start_ = now;
+}
+
+auto ReplayThrottle::Pause() -> void {
+    std::lock_guard lock{mutex_};
+    paused_ = true;
+}
+
+auto ReplayThrottle::Resume() -> void {
+    {
+        std::lock_guard lock{mutex_};
+        paused_ = false;
+        // Paused time must not count as an idle interval
+        interval_start_ = RatePacer::Clock::now();
+        interval_events_ = 0;
+    }
+    resumed_.NotifyAll();
+}
+
+auto ReplayThrottle::IsPaused() const -> bool {
+    std::lock_guard lock{mutex_};
+    return paused_;
+}
+
+auto ReplayThrottle::GetRate() const -> double {
+    std::lock_guard lock{mutex_};
+    return pacer_.GetRate();
+}
+
+auto ReplayThrottle::GetConfigSchema() -> std::string {
+    return R"(
+    throttle:
+        type: object
+        description: Replay rate limit, adapted to the handler latency
+        additionalProperties: false
+        properties:
+            max_rate:
+                type: number
+                minimum: 0
+                description: Maximum events per second, all workers together (default 0, unlimited)
+            latency_target:
+                type: string
+                description: |
+                    Handler p95 latency to keep, the rate is multiplied by decrease_factor when
+                    it is exceeded and raised by increase_step otherwise (default 0, no adaptation)
+            min_rate:
+                type: number
+                minimum: 0
+                description: The adapted rate never goes below this, must be positive with latency_target (default 1)
+            increase_step:
+                type: number
+                minimum: 0
+                description: Events per second added after an interval within the latency target (default 10)
+            decrease_factor:
+                type: number
+                minimum: 0
+                maximum: 1
+                description: |
+                    Rate multiplier after an interval over the latency target, must be positive
+                    with latency_target (default 0.5)
+            adjust_interval:
+                type: string
+                description: How often the rate is adapted (default 1s)
+)";
+}
+
+}  // namespace paddle::handlers
@@ -0,0 +1,60 @@
+#include <paddle/handlers/snapshot_store.hpp>
+
+#include <mutex>
+#include <utility>
+
+namespace paddle::handlers {
+
+LruSnapshotStore::LruSnapshotStore(std::size_t max_size)
+    : snapshots_{max_size} {
+}
+
+auto LruSnapshotStore::Find(const std::string& entity_id) -> std::optional<EntitySnapshot> {
+    std::lock_guard lock{mutex_};
+    if (auto* stored = snapshots_.Get(entity_id)) {
+        return *stored;
+    }
+    return std::nullopt;
+}
+
+auto LruSnapshotStore::Exchange(const std::string& entity_id, const EntitySnapshot& snapshot)
+    -> std::optional<EntitySnapshot> {
+    std::lock_guard lock{mutex_};
+    auto* stored = snapshots_.Get(entity_id);
+    if (!stored) {
+        snapshots_.Put(entity_id, snapshot);
+        return std::nullopt;
+    }
+    auto previous = *stored;
+    if (previous.occurred_at.GetUnderlying() <= snapshot.occurred_at.GetUnderlying()) {
+        *stored = snapshot;
+    }
+    return previous;
+}
+
+PendingSnapshot::PendingSnapshot(SnapshotStoreBase& store, std::string entity_id, EntitySnapshot snapshot)
+    : store_{&store}
+    , entity_id_{std::move(entity_id)}
+    , snapshot_{std::move(snapshot)} {
+}
+
+auto PendingSnapshot::Commit() const -> void {
+    if (store_) {
+        store_->Exchange(entity_id_, snapshot_);
+    }
+}
+
+auto TrackChanges(SnapshotStoreBase& store, events::Event<JSON>& event) -> PendingSnapshot {
+    if (!event.data.IsObject() || !event.data["id"].IsString()) {
+        return {};
+    }
+    auto entity_id = event.data["id"].As<std::string>();
+    auto previous = store.Find(entity_id);
+    // A late event can't be compared to a newer snapshot
+    if (previous && previous->occurred_at.GetUnderlying() <= event.occurred_at.GetUnderlying()) {
+        event.changes = events::Changes::Compute(previous->data, event.data);
+    }
+    return {store, std::move(entity_id), EntitySnapshot{event.occurred_at, event.data}};
+}
+
+}  // namespace paddle::handlers
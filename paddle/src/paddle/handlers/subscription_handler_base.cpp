@@ -1,11 +1,13 @@
 #include <paddle/handlers/subscription_handler_base.hpp>
 
 #include <paddle/types/events.hpp>
+#include <paddle/types/subscription_view.hpp>
 #include <paddle/types/subscriptions.hpp>
 
 namespace paddle::handlers {
 
-auto SubscriptionHandlerBase::HandleEvent(const JSON& request_json, EventType&& event) const -> void {
+template <typename Payload>
+auto BasicSubscriptionHandler<Payload>::HandleEvent(const JSON& request_json, EventType&& event) const -> void {
     LOG_INFO() << "Handling event: " << event.event_type << " " << event.event_id;
     switch (event.event_type) {
         case events::EventTypeName::kSubscriptionActivated:
@@ -39,69 +41,90 @@ auto SubscriptionHandlerBase::HandleEvent(const JSON& request_json, EventType&&
     }
 }
 
-auto SubscriptionHandlerBase::HandleActivated(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicSubscriptionHandler<Payload>::HandleActivated(EventType&& event) const -> void {
     DoHandleActivated(std::move(event));
 }
 
-auto SubscriptionHandlerBase::DoHandleActivated(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicSubscriptionHandler<Payload>::DoHandleActivated(EventType&& event) const -> void {
     LogEventIgnored(event);
 }
 
-auto SubscriptionHandlerBase::HandleCanceled(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicSubscriptionHandler<Payload>::HandleCanceled(EventType&& event) const -> void {
     DoHandleCanceled(std::move(event));
 }
 
-auto SubscriptionHandlerBase::DoHandleCanceled(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicSubscriptionHandler<Payload>::DoHandleCanceled(EventType&& event) const -> void {
     LogEventIgnored(event);
 }
 
-auto SubscriptionHandlerBase::HandleCreated(TransactionId&& transaction_id, EventType&& event) const -> void {
+template <typename Payload>
+auto BasicSubscriptionHandler<Payload>::HandleCreated(TransactionId&& transaction_id, EventType&& event) const -> void {
     DoHandleCreated(std::move(transaction_id), std::move(event));
 }
 
-auto SubscriptionHandlerBase::DoHandleCreated([[maybe_unused]] TransactionId&& transaction_id, EventType&& event) const
-    -> void {
+template <typename Payload>
+auto BasicSubscriptionHandler<Payload>::DoHandleCreated(
+    [[maybe_unused]] TransactionId&& transaction_id,
+    EventType&& event
+) const -> void {
     LogEventIgnored(event);
 }
 
-auto SubscriptionHandlerBase::HandleImported(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicSubscriptionHandler<Payload>::HandleImported(EventType&& event) const -> void {
     DoHandleImported(std::move(event));
 }
 
-auto SubscriptionHandlerBase::DoHandleImported(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicSubscriptionHandler<Payload>::DoHandleImported(EventType&& event) const -> void {
     LogEventIgnored(event);
 }
 
-auto SubscriptionHandlerBase::HandlePastDue(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicSubscriptionHandler<Payload>::HandlePastDue(EventType&& event) const -> void {
     DoHandlePastDue(std::move(event));
 }
 
-auto SubscriptionHandlerBase::DoHandlePastDue(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicSubscriptionHandler<Payload>::DoHandlePastDue(EventType&& event) const -> void {
     LogEventIgnored(event);
 }
 
-auto SubscriptionHandlerBase::HandlePaused(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicSubscriptionHandler<Payload>::HandlePaused(EventType&& event) const -> void {
     DoHandlePaused(std::move(event));
 }
 
-auto SubscriptionHandlerBase::DoHandlePaused(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicSubscriptionHandler<Payload>::DoHandlePaused(EventType&& event) const -> void {
     LogEventIgnored(event);
 }
 
-auto SubscriptionHandlerBase::HandleResumed(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicSubscriptionHandler<Payload>::HandleResumed(EventType&& event) const -> void {
     DoHandleResumed(std::move(event));
 }
 
-auto SubscriptionHandlerBase::DoHandleResumed(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicSubscriptionHandler<Payload>::DoHandleResumed(EventType&& event) const -> void {
     LogEventIgnored(event);
 }
 
-auto SubscriptionHandlerBase::HandleUpdated(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicSubscriptionHandler<Payload>::HandleUpdated(EventType&& event) const -> void {
     DoHandleUpdated(std::move(event));
 }
 
-auto SubscriptionHandlerBase::DoHandleUpdated(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicSubscriptionHandler<Payload>::DoHandleUpdated(EventType&& event) const -> void {
     LogEventIgnored(event);
 }
 
+template class BasicSubscriptionHandler<subscriptions::Subscription>;
+template class BasicSubscriptionHandler<subscriptions::SubscriptionView>;
+
 }  // namespace paddle::handlers
\ No newline at end of file
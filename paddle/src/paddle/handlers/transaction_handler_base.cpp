@@ -1,6 +1,7 @@
 #include <paddle/handlers/transaction_handler_base.hpp>
 
 #include <paddle/types/events.hpp>
+#include <paddle/types/transaction_view.hpp>
 #include <paddle/types/transactions.hpp>
 
 #include <userver/http/common_headers.hpp>
@@ -11,7 +12,9 @@
 
 namespace paddle::handlers {
 
-auto TransactionHandlerBase::HandleEvent([[maybe_unused]] const JSON& request_json, EventType&& event) const -> void {
+template <typename Payload>
+auto BasicTransactionHandler<Payload>::HandleEvent([[maybe_unused]] const JSON& request_json, EventType&& event) const
+    -> void {
     LOG_INFO() << "Handling event: " << event.event_type << " " << event.event_id;
     switch (event.event_type) {
         case events::EventTypeName::kTransactionBilled:
@@ -49,84 +52,107 @@ auto TransactionHandlerBase::HandleEvent([[maybe_unused]] const JSON& request_js
     }
 }
 
-auto TransactionHandlerBase::HandleBilled(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicTransactionHandler<Payload>::HandleBilled(EventType&& event) const -> void {
     DoHandleBilled(std::move(event));
 }
 
-auto TransactionHandlerBase::DoHandleBilled(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicTransactionHandler<Payload>::DoHandleBilled(EventType&& event) const -> void {
     LogEventIgnored(event);
 }
 
-auto TransactionHandlerBase::HandleCanceled(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicTransactionHandler<Payload>::HandleCanceled(EventType&& event) const -> void {
     DoHandleCanceled(std::move(event));
 }
 
-auto TransactionHandlerBase::DoHandleCanceled(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicTransactionHandler<Payload>::DoHandleCanceled(EventType&& event) const -> void {
     LogEventIgnored(event);
 }
 
-auto TransactionHandlerBase::HandleCompleted(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicTransactionHandler<Payload>::HandleCompleted(EventType&& event) const -> void {
     DoHandleCompleted(std::move(event));
 }
 
-auto TransactionHandlerBase::DoHandleCompleted(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicTransactionHandler<Payload>::DoHandleCompleted(EventType&& event) const -> void {
     LogEventIgnored(event);
 }
 
-auto TransactionHandlerBase::HandleCreated(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicTransactionHandler<Payload>::HandleCreated(EventType&& event) const -> void {
     DoHandleCreated(std::move(event));
 }
 
-auto TransactionHandlerBase::DoHandleCreated(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicTransactionHandler<Payload>::DoHandleCreated(EventType&& event) const -> void {
     LogEventIgnored(event);
 }
 
-auto TransactionHandlerBase::HandlePaid(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicTransactionHandler<Payload>::HandlePaid(EventType&& event) const -> void {
     DoHandlePaid(std::move(event));
 }
 
-auto TransactionHandlerBase::DoHandlePaid(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicTransactionHandler<Payload>::DoHandlePaid(EventType&& event) const -> void {
     LogEventIgnored(event);
 }
 
-auto TransactionHandlerBase::HandlePastDue(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicTransactionHandler<Payload>::HandlePastDue(EventType&& event) const -> void {
     DoHandlePastDue(std::move(event));
 }
 
-auto TransactionHandlerBase::DoHandlePastDue(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicTransactionHandler<Payload>::DoHandlePastDue(EventType&& event) const -> void {
     LogEventIgnored(event);
 }
 
-auto TransactionHandlerBase::HandlePaymentFailed(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicTransactionHandler<Payload>::HandlePaymentFailed(EventType&& event) const -> void {
     DoHandlePaymentFailed(std::move(event));
 }
 
-auto TransactionHandlerBase::DoHandlePaymentFailed(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicTransactionHandler<Payload>::DoHandlePaymentFailed(EventType&& event) const -> void {
     LogEventIgnored(event);
 }
 
-auto TransactionHandlerBase::HandleReady(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicTransactionHandler<Payload>::HandleReady(EventType&& event) const -> void {
     DoHandleReady(std::move(event));
 }
 
-auto TransactionHandlerBase::DoHandleReady(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicTransactionHandler<Payload>::DoHandleReady(EventType&& event) const -> void {
     LogEventIgnored(event);
 }
 
-auto TransactionHandlerBase::HandleRevised(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicTransactionHandler<Payload>::HandleRevised(EventType&& event) const -> void {
     DoHandleRevised(std::move(event));
 }
 
-auto TransactionHandlerBase::DoHandleRevised(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicTransactionHandler<Payload>::DoHandleRevised(EventType&& event) const -> void {
     LogEventIgnored(event);
 }
 
-auto TransactionHandlerBase::HandleUpdated(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicTransactionHandler<Payload>::HandleUpdated(EventType&& event) const -> void {
     DoHandleUpdated(std::move(event));
 }
 
-auto TransactionHandlerBase::DoHandleUpdated(EventType&& event) const -> void {
+template <typename Payload>
+auto BasicTransactionHandler<Payload>::DoHandleUpdated(EventType&& event) const -> void {
     LogEventIgnored(event);
 }
 
+template class BasicTransactionHandler<transactions::Transaction>;
+template class BasicTransactionHandler<transactions::TransactionView>;
+
 }  // namespace paddle::handlers
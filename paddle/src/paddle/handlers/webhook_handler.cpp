@@ -1,63 +1,418 @@
 #include <paddle/handlers/webhook_handler.hpp>
 
-#include <paddle/handlers/address_handler_base.hpp>
-#include <paddle/handlers/api_key_handler_base.hpp>
-#include <paddle/handlers/business_handler_base.hpp>
-#include <paddle/handlers/client_token_handler_base.hpp>
-#include <paddle/handlers/customer_handler_base.hpp>
-#include <paddle/handlers/payment_method_handler_base.hpp>
-#include <paddle/handlers/price_handler_base.hpp>
-#include <paddle/handlers/product_handler_base.hpp>
-#include <paddle/handlers/subscription_handler_base.hpp>
-#include <paddle/handlers/transaction_handler_base.hpp>
-
+#include <paddle/handlers/event_coalescer.hpp>
+#include <paddle/handlers/event_dispatcher.hpp>
+#include <paddle/handlers/event_filter.hpp>
 #include <paddle/handlers/handlers.hpp>
 
+#include <paddle/components/event_archive.hpp>
+#include <paddle/components/event_deduplicator.hpp>
+#include <paddle/components/ip_allowlist_cache.hpp>
+#include <paddle/components/replay_checkpoint_store.hpp>
 #include <paddle/components/webhook_secret_cache.hpp>
-#include <paddle/types/api_keys.hpp>
-#include <paddle/types/client_token.hpp>
-#include <paddle/types/customers.hpp>
 #include <paddle/types/events.hpp>
-#include <paddle/types/price.hpp>
-#include <paddle/types/product.hpp>
-#include <paddle/types/subscriptions.hpp>
-#include <paddle/types/transactions.hpp>
+#include <paddle/types/raw_json.hpp>
 
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
-#include <userver/concurrent/background_task_storage.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/formats/json/serialize.hpp>
 #include <userver/http/common_headers.hpp>
+#include <userver/http/content_type.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/server/handlers/exceptions.hpp>
+#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/recentperiod.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/writer.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
 namespace paddle::handlers {
 
 namespace uhandlers = userver::server::handlers;
+namespace statistics = userver::utils::statistics;
+
+using Forbidden = uhandlers::ExceptionWithCode<uhandlers::HandlerErrorCode::kForbidden>;
+
+namespace {
+
+constexpr auto kStatisticsPrefix = "paddle.webhook";
+constexpr auto kFilterVerdictCount = static_cast<std::size_t>(FilterVerdict::kCustomData) + 1;
+
+constexpr std::chrono::milliseconds kDefaultLatencyBudget{2000};
+
+enum class ProcessingMode {
+    kSync,
+    kBackground,
+    kAdaptive,
+};
+
+auto ParseProcessingMode(const userver::components::ComponentConfig& config) -> ProcessingMode {
+    auto mode = config["mode"].As<std::string>("");
+    if (mode.empty()) {
+        // Backward compatible behaviour
+        return config["run_in_background"].As<bool>(false) ? ProcessingMode::kBackground : ProcessingMode::kSync;
+    }
+    if (mode == "sync") {
+        return ProcessingMode::kSync;
+    }
+    if (mode == "background") {
+        return ProcessingMode::kBackground;
+    }
+    if (mode == "adaptive") {
+        return ProcessingMode::kAdaptive;
+    }
+    throw std::runtime_error(fmt::format("Unknown webhook processing mode: {}", mode));
+}
+
+/// @brief Picks sync or background processing per event type from the observed handler latency
+///
+/// An event type is switched to background processing when its p99 exceeds the budget
+/// and switched back when p99 drops below the recovery threshold.
+class AdaptiveModeSelector {
+public:
+    AdaptiveModeSelector(std::chrono::milliseconds budget, std::chrono::milliseconds recovery)
+        : budget_{budget}
+        , recovery_{recovery}
+        , latencies_(events::kEventTypeNameCount) {
+    }
+
+    auto Account(events::EventTypeName event_type, std::chrono::milliseconds elapsed) -> void {
+        latencies_[static_cast<std::size_t>(event_type)].timings.GetCurrentCounter().Account(
+            static_cast<std::uint32_t>(elapsed.count())
+        );
+    }
+
+    auto ShouldRunInBackground(events::EventTypeName event_type) -> bool {
+        auto& latency = latencies_[static_cast<std::size_t>(event_type)];
+        const auto p99 =
+            std::chrono::milliseconds{latency.timings.GetStatsForPeriod(kWindow, true).GetPercentile(99)};
+        auto background = latency.background.load();
+        if (!background && p99 > budget_) {
+            if (latency.background.compare_exchange_strong(background, true)) {
+                LOG_WARNING() << "Handler p99 for " << event_type << " is " << p99.count() << " ms, over budget of "
+                              << budget_.count() << " ms, switching to background processing";
+            }
+            return true;
+        }
+        if (background && p99 < recovery_) {
+            if (latency.background.compare_exchange_strong(background, false)) {
+                LOG_WARNING() << "Handler p99 for " << event_type << " recovered to " << p99.count()
+                              << " ms, switching to synchronous processing";
+            }
+            return false;
+        }
+        return background;
+    }
+
+private:
+    /// Milliseconds, 1 ms resolution below 200 ms and 100 ms resolution up to 10 s
+    using LatencyPercentile = userver::utils::statistics::Percentile<200, std::uint32_t, 98, 100>;
+    static constexpr std::chrono::seconds kEpoch{1};
+    static constexpr std::chrono::seconds kWindow{10};
+
+    struct EventTypeLatency {
+        userver::utils::statistics::RecentPeriod<LatencyPercentile, LatencyPercentile> timings{kEpoch, kWindow};
+        std::atomic<bool> background{false};
+    };
+
+    std::chrono::milliseconds budget_;
+    std::chrono::milliseconds recovery_;
+    std::vector<EventTypeLatency> latencies_;
+};
+
+auto MakeAdaptiveModeSelector(const userver::components::ComponentConfig& config, ProcessingMode mode)
+    -> std::unique_ptr<AdaptiveModeSelector> {
+    if (mode != ProcessingMode::kAdaptive) {
+        return nullptr;
+    }
+    auto budget = config["latency_budget"].As<std::chrono::milliseconds>(kDefaultLatencyBudget);
+    auto recovery = config["latency_recovery"].As<std::chrono::milliseconds>(budget / 2);
+    return std::make_unique<AdaptiveModeSelector>(budget, recovery);
+}
+
+auto FindIpAllowlist(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context
+) -> const components::IpAllowlistCache* {
+    auto name = config["ip_allowlist"].As<std::string>("");
+    if (name.empty()) {
+        return nullptr;
+    }
+    return &context.FindComponent<components::IpAllowlistCache>(name);
+}
+
+auto FindDeduplicator(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context
+) -> const components::EventDeduplicator* {
+    auto name = config["deduplicator"].As<std::string>("");
+    if (name.empty()) {
+        return nullptr;
+    }
+    return &context.FindComponent<components::EventDeduplicator>(name);
+}
+
+auto FindCheckpointStore(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context
+) -> const components::ReplayCheckpointStore* {
+    auto name = config["checkpoint"].As<std::string>("");
+    if (name.empty()) {
+        return nullptr;
+    }
+    return &context.FindComponent<components::ReplayCheckpointStore>(name);
+}
+
+auto FindArchive(
+    const userver::components::ComponentConfig& config,
+    const userver::components::ComponentContext& context
+) -> const components::EventArchive* {
+    auto name = config["archive"].As<std::string>("");
+    if (name.empty()) {
+        return nullptr;
+    }
+    return &context.FindComponent<components::EventArchive>(name);
+}
+
+auto MakeCoalescer(const userver::components::ComponentConfig& config) -> std::unique_ptr<EventCoalescer> {
+    auto window = config["coalesce_window"].As<std::chrono::milliseconds>(std::chrono::milliseconds{0});
+    if (window.count() <= 0) {
+        return nullptr;
+    }
+    return std::make_unique<EventCoalescer>(window);
+}
+
+auto MakeEventFilter(const userver::components::ComponentConfig& config) -> std::unique_ptr<EventFilter> {
+    auto filter = std::make_unique<EventFilter>(config["filters"].As<EventFilterConfig>(EventFilterConfig{}));
+    if (filter->IsEmpty()) {
+        return nullptr;
+    }
+    return filter;
+}
+
+}  // namespace
 
 struct WebhookHandler::Impl {
     components::WebhookSecretCache& secrets_cache;
-    bool run_in_background;
-    mutable userver::concurrent::BackgroundTaskStorage bts;
+    const components::IpAllowlistCache* ip_allowlist;
+    mutable std::atomic<std::uint64_t> rejected_sources{0};
+    ProcessingMode mode;
+    std::unique_ptr<AdaptiveModeSelector> mode_selector;
+    const components::EventDeduplicator* deduplicator;
+    const components::ReplayCheckpointStore* checkpoint;
+    std::string checkpoint_key;
+    const components::EventArchive* archive;
+    std::unique_ptr<EventFilter> filter;
+    mutable std::array<std::atomic<std::uint64_t>, kFilterVerdictCount> verdicts{};
 
-    Handlers handlers;
+    EventDispatcher dispatcher;
+    // Destroyed before the dispatcher, its batch tasks dispatch the events
+    std::unique_ptr<EventCoalescer> coalescer;
+    statistics::Entry statistics_holder;
 
     Impl(const userver::components::ComponentConfig& config, const userver::components::ComponentContext& context)
         : secrets_cache{context.FindComponent<components::WebhookSecretCache>(config["secrets_cache"].As<std::string>())}
-        , run_in_background{config["run_in_background"].As<bool>(false)}
-        , handlers{config, context} {
+        , ip_allowlist{FindIpAllowlist(config, context)}
+        , mode{ParseProcessingMode(config)}
+        , mode_selector{MakeAdaptiveModeSelector(config, mode)}
+        , deduplicator{FindDeduplicator(config, context)}
+        , checkpoint{FindCheckpointStore(config, context)}
+        , checkpoint_key{config.Name()}
+        , archive{FindArchive(config, context)}
+        , filter{MakeEventFilter(config)}
+        , dispatcher{config, context, MakeLatencyObserver()}
+        , coalescer{MakeCoalescer(config)} {
+        // Background failures are acknowledged to Paddle, something else has to bring the events back
+        if (mode == ProcessingMode::kAdaptive && !deduplicator && !checkpoint) {
+            throw std::runtime_error(
+                fmt::format("Webhook handler {}: adaptive mode requires a deduplicator or a checkpoint", config.Name())
+            );
+        }
+        statistics_holder =
+            context.FindComponent<userver::components::StatisticsStorage>().GetStorage().RegisterWriter(
+                kStatisticsPrefix,
+                [this](statistics::Writer& writer) { WriteStatistics(writer); },
+                {{"paddle_webhook", config.Name()}}
+            );
+    }
+
+    ~Impl() {
+        statistics_holder.Unregister();
+    }
+
+    auto WriteStatistics(statistics::Writer& writer) const -> void {
+        auto count = [this](FilterVerdict verdict) { return verdicts[static_cast<std::size_t>(verdict)].load(); };
+        writer["accepted"] = count(FilterVerdict::kAccepted);
+        writer["rejected-source"] = rejected_sources.load();
+        auto filtered = writer["filtered"];
+        filtered["event-type"] = count(FilterVerdict::kEventType);
+        filtered["traffic-source"] = count(FilterVerdict::kTrafficSource);
+        filtered["custom-data"] = count(FilterVerdict::kCustomData);
+    }
+
+    /// Runs before anything is done with the body, a request from elsewhere costs a lookup rather than an HMAC
+    auto CheckSource(const userver::server::http::HttpRequest& request) const -> void {
+        if (!ip_allowlist || ip_allowlist->IsAllowed(request)) {
+            return;
+        }
+        ++rejected_sources;
+        auto address = request.GetRemoteAddress().PrimaryAddressString();
+        throw Forbidden(
+            uhandlers::InternalMessage{fmt::format("Webhook from a disallowed address, peer {}", address)},
+            uhandlers::ExternalBody{"Forbidden"}
+        );
+    }
+
+    auto MakeLatencyObserver() -> EventDispatcher::LatencyObserver {
+        if (!mode_selector) {
+            return nullptr;
+        }
+        return [this](events::EventTypeName event_type, std::chrono::milliseconds elapsed) {
+            mode_selector->Account(event_type, elapsed);
+        };
+    }
+
+    auto ShouldRunInBackground(events::EventTypeName event_type) const -> bool {
+        switch (mode) {
+            case ProcessingMode::kSync:
+                return false;
+            case ProcessingMode::kBackground:
+                return true;
+            case ProcessingMode::kAdaptive:
+                return mode_selector->ShouldRunInBackground(event_type);
+        }
+        return false;
+    }
+
+    auto OnProcessed(const EventId& event_id) const -> void {
+        if (deduplicator) {
+            deduplicator->Complete(event_id);
+        }
+        if (checkpoint) {
+            checkpoint->Advance(checkpoint_key, event_id);
+        }
+    }
+
+    auto OnFailed(const EventId& event_id) const -> void {
+        if (deduplicator) {
+            deduplicator->Abort(event_id);
+        }
+        // Catch-up must not start after the event until a retry processes it
+        if (checkpoint) {
+            checkpoint->Fail(checkpoint_key, event_id);
+        }
+    }
+
+    auto MakeCompletionCallback(const EventId& event_id) const -> EventDispatcher::CompletionCallback {
+        if (!deduplicator && !checkpoint) {
+            return nullptr;
+        }
+        // Background handlers are stopped with the dispatcher, before the rest of the members
+        return [this, event_id](std::exception_ptr error) {
+            if (error) {
+                OnFailed(event_id);
+            } else {
+                OnProcessed(event_id);
+            }
+        };
+    }
+
+    /// @return std::nullopt if the event was superseded by a later event of the same entity
+    auto CoalesceAndDispatch(const JSON& event_json, events::Event<JSON>&& event) const
+        -> std::optional<DispatchResult> {
+        if (coalescer) {
+            auto entity_id = event_json["data"]["id"].As<std::string>("");
+            if (!entity_id.empty()) {
+                return coalescer->Submit(
+                    entity_id,
+                    event_json,
+                    std::move(event),
+                    [this](const JSON& buffered_json, events::Event<JSON>&& buffered_event) {
+                        return Dispatch(buffered_json, std::move(buffered_event));
+                    }
+                );
+            }
+        }
+        return Dispatch(event_json, std::move(event));
+    }
+
+    auto Dispatch(const JSON& event_json, events::Event<JSON>&& event) const -> DispatchResult {
+        auto in_background = ShouldRunInBackground(event.event_type);
+        auto on_complete = MakeCompletionCallback(event.event_id);
+        return dispatcher.Dispatch(event_json, std::move(event), in_background, std::move(on_complete));
+    }
+
+    /// @return false if the event must be dropped
+    auto ApplyFilter(std::string_view body) const -> bool {
+        auto verdict = filter ? filter->Evaluate(body) : FilterVerdict::kAccepted;
+        ++verdicts[static_cast<std::size_t>(verdict)];
+        return verdict == FilterVerdict::kAccepted;
+    }
+
+    /// Dropped events must not be replayed on the startup catch-up either
+    auto AdvanceCheckpoint(std::string_view body) const -> void {
+        if (!checkpoint) {
+            return;
+        }
+        auto raw_event_id = raw_json::FindValue(body, {"event_id"});
+        auto event_id = raw_event_id ? raw_json::DecodeString(*raw_event_id) : std::nullopt;
+        if (auto id = event_id ? EventId::TryParse(*event_id) : std::nullopt) {
+            checkpoint->Advance(checkpoint_key, *id);
+        }
+    }
+
+    /// An archive failure must not make Paddle retry the event
+    auto Archive(std::string_view body) const -> void {
+        if (!archive) {
+            return;
+        }
+        try {
+            archive->Append(body);
+        } catch (const std::exception& e) {
+            LOG_ERROR() << "Failed to archive event: " << e.what();
+        }
+    }
+
+    auto ParseBody(const std::string& body) const -> JSON {
+        try {
+            return userver::formats::json::FromString(body);
+        } catch (const userver::formats::json::Exception& e) {
+            throw uhandlers::RequestParseError(
+                uhandlers::InternalMessage{fmt::format("Invalid request body: {}", e.what())},
+                uhandlers::ExternalBody{"Invalid request body"}
+            );
+        }
     }
 
     JSON HandleEventRequest(
         const userver::server::http::HttpRequest& request,
-        const userver::formats::json::Value& request_json,
         [[maybe_unused]] userver::server::request::RequestContext& context
     ) const {
+        CheckSource(request);
         if (!secrets_cache.ValidateSignature(request)) {
             throw uhandlers::Unauthorized(
                 uhandlers::InternalMessage{"Invalid signature"}, uhandlers::ExternalBody{"Invalid signature"}
             );
         }
+        Archive(request.RequestBody());
+        // Dropped events are acknowledged, so that Paddle doesn't retry them
+        if (!ApplyFilter(request.RequestBody())) {
+            AdvanceCheckpoint(request.RequestBody());
+            JSON::Builder builder;
+            builder["status"] = "filtered";
+            return builder.ExtractValue();
+        }
+        const auto request_json = ParseBody(request.RequestBody());
         if (!request_json.HasMember("event_type")) {
             throw uhandlers::ClientError(
                 uhandlers::InternalMessage{"Invalid request: event_type is required"},
@@ -77,54 +432,49 @@ struct WebhookHandler::Impl {
         }
         try {
             LOG_INFO() << "Received event: " << event_type_str;
-            auto category = events::GetEventCategory(event_type);
+            auto event = request_json.As<events::Event<JSON>>();
+            auto event_id = event.event_id;
             JSON::Builder builder;
-            switch (category) {
-                case events::EventCategory::kTransaction:
-                    HandleEvent(request_json, handlers.transaction_handler);
-                    builder["status"] = "ok";
-                    break;
-                case events::EventCategory::kSubscription:
-                    HandleEvent(request_json, handlers.subscription_handler);
-                    builder["status"] = "ok";
-                    break;
-                case events::EventCategory::kCustomer:
-                    HandleEvent(request_json, handlers.customer_handler);
-                    builder["status"] = "ok";
-                    break;
-                case events::EventCategory::kPaymentMethod:
-                    HandleEvent(request_json, handlers.payment_method_handler);
-                    builder["status"] = "ok";
-                    break;
-                case events::EventCategory::kPrice:
-                    HandleEvent(request_json, handlers.price_handler);
-                    builder["status"] = "ok";
-                    break;
-                case events::EventCategory::kProduct:
-                    HandleEvent(request_json, handlers.product_handler);
-                    builder["status"] = "ok";
-                    break;
-                case events::EventCategory::kAddress:
-                    HandleEvent(request_json, handlers.address_handler);
-                    builder["status"] = "ok";
-                    break;
-                case events::EventCategory::kBusiness:
-                    HandleEvent(request_json, handlers.business_handler);
-                    builder["status"] = "ok";
-                    break;
-                case events::EventCategory::kApiKey:
-                    HandleEvent(request_json, handlers.api_key_handler);
+            if (deduplicator && !deduplicator->TryBegin(event_id)) {
+                builder["status"] = "duplicate";
+                return builder.ExtractValue();
+            }
+            if (checkpoint) {
+                checkpoint->Begin(checkpoint_key, event_id);
+            }
+            auto result = [&]() -> std::optional<DispatchResult> {
+                try {
+                    return CoalesceAndDispatch(request_json, std::move(event));
+                } catch (const std::exception&) {
+                    OnFailed(event_id);
+                    throw;
+                }
+            }();
+            if (!result) {
+                OnProcessed(event_id);
+                builder["status"] = "coalesced";
+                return builder.ExtractValue();
+            }
+            // Handler never ran, so the completion callback is not called
+            if (result != DispatchResult::kHandled && result != DispatchResult::kScheduled) {
+                OnProcessed(event_id);
+            }
+            switch (*result) {
+                case DispatchResult::kHandled:
+                case DispatchResult::kScheduled:
+                case DispatchResult::kNoHandler:
                     builder["status"] = "ok";
                     break;
-                case events::EventCategory::kClientToken:
-                    HandleEvent(request_json, handlers.client_token_handler);
-                    builder["status"] = "ok";
+                case DispatchResult::kSkipped:
+                    builder["status"] = "skipped";
                     break;
-                default:
-                    LOG_INFO() << "Event handling not implemented for event category: " << category;
+                case DispatchResult::kUnsupported: {
+                    auto category = events::GetEventCategory(event_type);
                     builder["status"] = "dubious";
                     builder["message"] =
                         fmt::format("Event handling not implemented for event category: {}", EnumToString(category));
+                    break;
+                }
             }
             return builder.ExtractValue();
         } catch (const std::exception& e) {
@@ -135,27 +485,6 @@ struct WebhookHandler::Impl {
             );
         }
     }
-
-    template <typename T>
-    void HandleEvent(const userver::formats::json::Value& request_json, T* handler) const {
-        if (handler) {
-            auto event = request_json.As<typename T::EventType>();
-            if (run_in_background) {
-                bts.AsyncDetach(
-                    "handle-event",
-                    [handler](JSON request_json, typename T::EventType event) {
-                        handler->HandleEvent(std::move(request_json), std::move(event));
-                    },
-                    request_json,
-                    event
-                );
-            } else {
-                handler->HandleEvent(request_json, std::move(event));
-            }
-            return;
-        }
-        LOG_INFO() << "No event handler configured for event category: " << T::kEventCategory;
-    }
 };
 
 WebhookHandler::WebhookHandler(
@@ -168,12 +497,13 @@ WebhookHandler::WebhookHandler(
 
 WebhookHandler::~WebhookHandler() = default;
 
-auto WebhookHandler::HandleRequestJsonThrow(
+auto WebhookHandler::HandleRequestThrow(
     const userver::server::http::HttpRequest& request,
-    const userver::formats::json::Value& request_json,
     userver::server::request::RequestContext& context
-) const -> userver::formats::json::Value {
-    return impl_->HandleEventRequest(request, request_json, context);
+) const -> std::string {
+    auto response = impl_->HandleEventRequest(request, context);
+    request.GetHttpResponse().SetContentType(userver::http::content_type::kApplicationJson);
+    return userver::formats::json::ToString(response);
 }
 
 auto WebhookHandler::GetStaticConfigSchema() -> userver::yaml_config::Schema {
@@ -188,9 +518,51 @@ properties:
         description: Component name for webhook secret cache
     run_in_background:
         type: boolean
-        description: Run event handling in background
-{})",
-        Handlers::GetHanderNames()
+        description: Run event handling in background (deprecated, use mode)
+    mode:
+        type: string
+        enum:
+          - sync
+          - background
+          - adaptive
+        description: |
+            Event processing mode: sync, background or adaptive. Adaptive mode processes
+            events synchronously while the handler p99 for the event type stays within
+            latency_budget and falls back to background processing otherwise. Adaptive mode
+            requires a deduplicator or a checkpoint, so that failed background events are not lost
+    latency_budget:
+        type: string
+        description: Handler p99 latency budget for the adaptive mode (2s by default)
+    latency_recovery:
+        type: string
+        description: |
+            Handler p99 below which the adaptive mode switches back to synchronous
+            processing (half of latency_budget by default)
+    ip_allowlist:
+        type: string
+        description: |
+            IP allowlist component name, requests from other addresses are rejected with 403
+            before the signature is checked
+    deduplicator:
+        type: string
+        description: Event deduplicator component name, guards against processing the same event twice
+    checkpoint:
+        type: string
+        description: |
+            Replay checkpoint store component name, the id of the last processed event is
+            recorded under the name of this handler for the startup catch-up
+    archive:
+        type: string
+        description: Event archive component name, every verified event is archived before processing
+    coalesce_window:
+        type: string
+        description: |
+            Buffer events of the same entity for this window, sort them by occurred_at and
+            dispatch only the latest of the `*.updated` events (0 - disabled, default)
+{}{}{})",
+        Handlers::GetHanderNames(),
+        EventDispatcher::GetConfigSchema(),
+        EventFilter::GetConfigSchema()
     ));
 }
 
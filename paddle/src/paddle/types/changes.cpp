@@ -0,0 +1,90 @@
+#include <paddle/types/changes.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace paddle::events {
+
+namespace {
+
+auto JoinPath(std::string_view prefix, std::string_view name) -> std::string {
+    if (prefix.empty()) {
+        return std::string{name};
+    }
+    std::string path;
+    path.reserve(prefix.size() + name.size() + 1);
+    path.append(prefix).append(".").append(name);
+    return path;
+}
+
+void Diff(const JSON& previous, const JSON& current, const std::string& prefix, std::vector<std::string>& paths) {
+    if (!previous.IsObject() || !current.IsObject()) {
+        if (previous != current) {
+            paths.push_back(prefix);
+        }
+        return;
+    }
+    for (auto it = current.begin(); it != current.end(); ++it) {
+        auto name = it.GetName();
+        if (!previous.HasMember(name)) {
+            paths.push_back(JoinPath(prefix, name));
+        } else {
+            Diff(previous[name], *it, JoinPath(prefix, name), paths);
+        }
+    }
+    for (auto it = previous.begin(); it != previous.end(); ++it) {
+        auto name = it.GetName();
+        if (!current.HasMember(name)) {
+            paths.push_back(JoinPath(prefix, name));
+        }
+    }
+}
+
+/// Either path is the other one or its parent
+auto IsSameOrNested(std::string_view changed, std::string_view path) -> bool {
+    auto [shorter, longer] = changed.size() < path.size() ? std::pair{changed, path} : std::pair{path, changed};
+    return longer.starts_with(shorter) && (longer.size() == shorter.size() || longer[shorter.size()] == '.');
+}
+
+}  // namespace
+
+auto Changes::Compute(const JSON& previous, const JSON& current) -> Changes {
+    Changes changes;
+    changes.known_ = true;
+    if (!previous.IsObject() || !current.IsObject()) {
+        // Not an entity snapshot, can't tell which fields changed
+        if (previous != current) {
+            changes.fields_.set();
+            changes.paths_.emplace_back();
+        }
+        return changes;
+    }
+    Diff(previous, current, std::string{}, changes.paths_);
+    std::sort(changes.paths_.begin(), changes.paths_.end());
+    for (const auto& path : changes.paths_) {
+        auto top_level = std::string_view{path}.substr(0, path.find('.'));
+        auto field = kFieldNames.TryFind(top_level);
+        changes.fields_.set(static_cast<std::size_t>(field.value_or(Field::kOther)));
+    }
+    return changes;
+}
+
+auto Changes::Contains(Field field) const -> bool {
+    return !known_ || fields_.test(static_cast<std::size_t>(field));
+}
+
+auto Changes::ContainsAny(std::initializer_list<Field> fields) const -> bool {
+    return std::any_of(fields.begin(), fields.end(), [this](Field field) { return Contains(field); });
+}
+
+auto Changes::Contains(std::string_view path) const -> bool {
+    if (!known_) {
+        return true;
+    }
+    return std::any_of(paths_.begin(), paths_.end(), [path](const std::string& changed) {
+        // Empty path means that the whole snapshot changed
+        return changed.empty() || IsSameOrNested(changed, path);
+    });
+}
+
+}  // namespace paddle::events
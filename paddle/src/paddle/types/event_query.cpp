@@ -0,0 +1,103 @@
+#include <paddle/types/event_query.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+
+namespace paddle::events {
+
+namespace {
+
+constexpr std::string_view kEventIdPrefix = "evt_";
+constexpr std::string_view kCrockfordAlphabet = "0123456789abcdefghjkmnpqrstvwxyz";
+constexpr std::size_t kUlidTimeLength = 10;
+constexpr std::size_t kUlidRandomLength = 16;
+/// Event ids and occurred_at don't have to match exactly
+constexpr std::chrono::minutes kRangeMargin{1};
+
+auto MatchesPattern(std::string_view pattern, std::string_view event_type) -> bool {
+    if (pattern.ends_with('*')) {
+        return event_type.starts_with(pattern.substr(0, pattern.size() - 1));
+    }
+    return pattern == event_type;
+}
+
+}  // namespace
+
+auto EventQuery::IsEmpty() const -> bool {
+    return event_types.empty() && !occurred_after && !occurred_before && entity_ids.empty();
+}
+
+auto EventQuery::Matches(const Event<JSON>& event) const -> bool {
+    const auto occurred_at = event.occurred_at.GetUnderlying();
+    if (occurred_after && occurred_at < occurred_after->GetUnderlying()) {
+        return false;
+    }
+    if (occurred_before && occurred_at >= occurred_before->GetUnderlying()) {
+        return false;
+    }
+    if (!entity_ids.empty()) {
+        auto entity_id = event.data["id"].As<std::string>("");
+        return std::find(entity_ids.begin(), entity_ids.end(), entity_id) != entity_ids.end();
+    }
+    return true;
+}
+
+auto EventQuery::IsPastRange(const Event<JSON>& event) const -> bool {
+    return occurred_before && event.occurred_at.GetUnderlying() >= occurred_before->GetUnderlying() + kRangeMargin;
+}
+
+auto EventQuery::GetStartCursor(std::string_view cursor) const -> std::string {
+    if (!occurred_after) {
+        return std::string{cursor};
+    }
+    auto start = MakeEventCursor(Timestamp{occurred_after->GetUnderlying() - kRangeMargin});
+    return std::max(start, std::string{cursor});
+}
+
+auto EventQuery::GetQueryParameters() const -> std::string {
+    if (event_types.empty()) {
+        return {};
+    }
+    std::string parameters{"&event_type="};
+    for (auto event_type : event_types) {
+        if (parameters.back() != '=') {
+            parameters += ',';
+        }
+        parameters += EnumToString(event_type);
+    }
+    return parameters;
+}
+
+auto ExpandEventTypes(std::string_view pattern) -> std::vector<EventTypeName> {
+    std::vector<EventTypeName> event_types;
+    for (std::size_t index = 0; index < kEventTypeNameCount; ++index) {
+        auto event_type = static_cast<EventTypeName>(index);
+        if (MatchesPattern(pattern, EnumToString(event_type))) {
+            event_types.push_back(event_type);
+        }
+    }
+    if (event_types.empty()) {
+        throw std::runtime_error(fmt::format("No event types match {}", pattern));
+    }
+    return event_types;
+}
+
+auto MakeEventCursor(Timestamp time_point) -> std::string {
+    auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+        time_point.GetUnderlying().time_since_epoch()
+    );
+    auto timestamp = static_cast<std::uint64_t>(std::max<std::int64_t>(milliseconds.count(), 0));
+    std::string cursor(kEventIdPrefix.size() + kUlidTimeLength + kUlidRandomLength, '0');
+    std::copy(kEventIdPrefix.begin(), kEventIdPrefix.end(), cursor.begin());
+    for (std::size_t index = 0; index < kUlidTimeLength; ++index) {
+        cursor[kEventIdPrefix.size() + kUlidTimeLength - 1 - index] = kCrockfordAlphabet[timestamp % 32];
+        timestamp /= 32;
+    }
+    return cursor;
+}
+
+}  // namespace paddle::events
@@ -1,7 +1,15 @@
 #include <paddle/types/events.hpp>
 
+#include <string_view>
+
 namespace paddle::events {
 
+namespace {
+
+constexpr std::string_view kUpdatedSuffix = ".updated";
+
+}  // namespace
+
 EventCategory GetEventCategory(EventTypeName event_type) {
 #pragma clang diagnostic push
 #pragma clang diagnostic error "-Wswitch"
@@ -96,4 +104,8 @@ EventCategory GetEventCategory(EventTypeName event_type) {
     return EventCategory::kUnknown;
 }
 
-}  // namespace paddle::events
\ No newline at end of file
+bool IsUpdatedEvent(EventTypeName event_type) {
+    return std::string_view{EnumToString(event_type)}.ends_with(kUpdatedSuffix);
+}
+
+}  // namespace paddle::events
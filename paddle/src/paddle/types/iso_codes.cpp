@@ -0,0 +1,20 @@
+#include <paddle/types/iso_codes.hpp>
+
+#include <stdexcept>
+
+namespace paddle::impl {
+
+static_assert(sizeof(money::CurrencyCode) == 4);
+static_assert(std::is_trivially_copyable_v<money::CurrencyCode>);
+static_assert(sizeof(prices::CountryCode) == 2);
+static_assert(std::is_trivially_copyable_v<prices::CountryCode>);
+
+void ThrowInvalidCurrencyCode(std::string_view text) {
+    throw std::invalid_argument(fmt::format("Invalid currency code: '{:.16}'", text));
+}
+
+void ThrowInvalidCountryCode(std::string_view text) {
+    throw std::invalid_argument(fmt::format("Invalid country code: '{:.16}'", text));
+}
+
+}  // namespace paddle::impl
@@ -0,0 +1,21 @@
+#include <paddle/types/money.hpp>
+
+#include <fmt/format.h>
+
+namespace paddle::money {
+
+auto Money::ToDecimalString() const -> std::string {
+    const auto minor_units = currency_code.GetMinorUnits();
+    if (minor_units == 0) {
+        return fmt::format("{}", amount);
+    }
+    const auto scale = currency_code.GetScale();
+    // Not negated before the division, the lowest amount has no positive counterpart
+    const auto major = amount / scale;
+    const auto minor = amount % scale;
+    return fmt::format(
+        "{}{}.{:0{}}", amount < 0 ? "-" : "", major < 0 ? -major : major, minor < 0 ? -minor : minor, minor_units
+    );
+}
+
+}  // namespace paddle::money
@@ -0,0 +1,45 @@
+#include <paddle/types/notification_settings.hpp>
+
+#include <algorithm>
+
+namespace paddle {
+
+namespace {
+
+auto Contains(const std::vector<events::EventTypeName>& event_types, events::EventTypeName event_type) -> bool {
+    return std::find(event_types.begin(), event_types.end(), event_type) != event_types.end();
+}
+
+}  // namespace
+
+auto DiffSubscription(const NotificationSetting& setting, const std::vector<events::EventTypeName>& handled)
+    -> SubscriptionDiff {
+    SubscriptionDiff diff{setting.id, {}, {}};
+    std::vector<events::EventTypeName> subscribed;
+    subscribed.reserve(setting.subscribed_events.size());
+    for (const auto& event_type : setting.subscribed_events) {
+        subscribed.push_back(event_type.name);
+        if (!Contains(handled, event_type.name)) {
+            diff.unhandled.push_back(event_type.name);
+        }
+    }
+    for (auto event_type : handled) {
+        if (!Contains(subscribed, event_type)) {
+            diff.missing.push_back(event_type);
+        }
+    }
+    return diff;
+}
+
+auto NarrowSubscription(const NotificationSetting& setting, const SubscriptionDiff& diff)
+    -> NotificationSettingUpdate {
+    NotificationSettingUpdate update;
+    for (const auto& event_type : setting.subscribed_events) {
+        if (!Contains(diff.unhandled, event_type.name)) {
+            update.subscribed_events.push_back(event_type.name);
+        }
+    }
+    return update;
+}
+
+}  // namespace paddle
@@ -0,0 +1,44 @@
+#include <paddle/types/notifications.hpp>
+
+#include <userver/utils/datetime.hpp>
+
+#include <fmt/format.h>
+
+namespace paddle {
+
+namespace {
+
+constexpr std::string_view kTimestampFormat = "%Y-%m-%dT%H:%M:%SZ";
+
+auto FormatTimestamp(const Timestamp& timestamp) -> std::string {
+    return userver::utils::datetime::Timestring(
+        timestamp.GetUnderlying(), "UTC", std::string{kTimestampFormat}
+    );
+}
+
+}  // namespace
+
+auto NotificationQuery::GetQueryParameters() const -> std::string {
+    std::string parameters;
+    if (!statuses.empty()) {
+        parameters += "&status=";
+        for (auto status : statuses) {
+            if (parameters.back() != '=') {
+                parameters += ',';
+            }
+            parameters += EnumToString(status);
+        }
+    }
+    if (notification_setting_id) {
+        parameters += fmt::format("&notification_setting_id={}", *notification_setting_id);
+    }
+    if (from) {
+        parameters += fmt::format("&from={}", FormatTimestamp(*from));
+    }
+    if (to) {
+        parameters += fmt::format("&to={}", FormatTimestamp(*to));
+    }
+    return parameters;
+}
+
+}  // namespace paddle
@@ -0,0 +1,28 @@
+#include <paddle/types/numeric.hpp>
+
+#include <fmt/format.h>
+
+#include <charconv>
+#include <stdexcept>
+
+namespace paddle {
+
+auto ParseInteger(std::string_view text) -> std::int64_t {
+    const auto digits = text.starts_with('-') ? text.substr(1) : text;
+    // from_chars accepts leading zeros, the API never sends them
+    if (digits.empty() || (digits.size() > 1 && digits.front() == '0')) {
+        throw std::invalid_argument(fmt::format("Invalid integer: '{:.32}'", text));
+    }
+    std::int64_t result = 0;
+    const auto* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, result);
+    if (ec == std::errc::result_out_of_range) {
+        throw std::invalid_argument(fmt::format("Integer out of range: '{:.32}'", text));
+    }
+    if (ec != std::errc{} || ptr != end) {
+        throw std::invalid_argument(fmt::format("Invalid integer: '{:.32}'", text));
+    }
+    return result;
+}
+
+}  // namespace paddle
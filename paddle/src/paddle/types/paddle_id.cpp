@@ -0,0 +1,93 @@
+#include <paddle/types/paddle_id.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace paddle::impl {
+
+namespace {
+
+static_assert(std::is_trivially_copyable_v<PackedId>);
+static_assert(sizeof(PackedId) == 24);
+
+constexpr std::string_view kCrockfordAlphabet = "0123456789abcdefghjkmnpqrstvwxyz";
+constexpr std::uint8_t kInvalidDigit = 0xff;
+constexpr unsigned kBitsPerDigit = 5;
+
+/// Crockford base32 digit values, both cases, no aliases for the ambiguous letters
+constexpr auto kDigitValues = [] {
+    std::array<std::uint8_t, 256> values{};
+    values.fill(kInvalidDigit);
+    for (std::size_t index = 0; index < kCrockfordAlphabet.size(); ++index) {
+        const auto c = kCrockfordAlphabet[index];
+        values[static_cast<unsigned char>(c)] = static_cast<std::uint8_t>(index);
+        if (c >= 'a' && c <= 'z') {
+            values[static_cast<unsigned char>(c - 'a' + 'A')] = static_cast<std::uint8_t>(index);
+        }
+    }
+    return values;
+}();
+
+}  // namespace
+
+auto PackedId::TryParse(std::string_view text) -> std::optional<PackedId> {
+    const auto separator = text.find('_');
+    if (separator == std::string_view::npos || separator == 0 || separator > kMaxPrefixSize ||
+        text.size() != separator + 1 + kUlidSize) {
+        return std::nullopt;
+    }
+    PackedId id;
+    for (std::size_t index = 0; index < separator; ++index) {
+        const auto c = text[index];
+        if (c < 'a' || c > 'z') {
+            return std::nullopt;
+        }
+        id.prefix[index] = c;
+    }
+    id.prefix_size = static_cast<std::uint8_t>(separator);
+
+    const auto ulid = text.substr(separator + 1);
+    // 26 digits are 130 bits, the first one carries only the top 3 bits of 128
+    std::uint8_t invalid = kDigitValues[static_cast<unsigned char>(ulid[0])] > 7 ? 1 : 0;
+    for (auto c : ulid) {
+        const auto digit = kDigitValues[static_cast<unsigned char>(c)];
+        invalid |= static_cast<std::uint8_t>(digit == kInvalidDigit);
+        id.ulid_high = (id.ulid_high << kBitsPerDigit) | (id.ulid_low >> (64 - kBitsPerDigit));
+        id.ulid_low = (id.ulid_low << kBitsPerDigit) | (digit & 0x1f);
+    }
+    if (invalid != 0) {
+        return std::nullopt;
+    }
+    return id;
+}
+
+auto PackedId::Parse(std::string_view text) -> PackedId {
+    if (auto id = TryParse(text)) {
+        return *id;
+    }
+    throw std::invalid_argument(fmt::format("Invalid Paddle id: '{:.64}'", text));
+}
+
+auto PackedId::Format(char* out) const -> std::size_t {
+    if (prefix_size == 0) {
+        return 0;
+    }
+    std::copy_n(prefix.data(), prefix_size, out);
+    out[prefix_size] = '_';
+    auto* ulid = out + prefix_size + 1;
+    auto high = ulid_high;
+    auto low = ulid_low;
+    for (auto index = kUlidSize; index > 0; --index) {
+        ulid[index - 1] = kCrockfordAlphabet[low & 0x1f];
+        low = (low >> kBitsPerDigit) | (high << (64 - kBitsPerDigit));
+        high >>= kBitsPerDigit;
+    }
+    return prefix_size + 1 + kUlidSize;
+}
+
+auto PackedId::ToString() const -> std::string {
+    std::array<char, kMaxSize> buffer;
+    return std::string{buffer.data(), Format(buffer.data())};
+}
+
+}  // namespace paddle::impl
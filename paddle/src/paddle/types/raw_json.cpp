@@ -0,0 +1,482 @@
+#include <paddle/types/raw_json.hpp>
+
+#include <paddle/types/timestamp.hpp>
+
+#include <userver/formats/json/serialize.hpp>
+
+#include <boost/uuid/string_generator.hpp>
+
+#include <fmt/format.h>
+
+#include <charconv>
+#include <cstdint>
+
+namespace paddle::raw_json {
+
+namespace {
+
+constexpr auto kNotFound = std::string_view::npos;
+
+auto IsWhitespace(char c) -> bool {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+auto SkipWhitespace(std::string_view json, std::size_t pos) -> std::size_t {
+    while (pos < json.size() && IsWhitespace(json[pos])) {
+        ++pos;
+    }
+    return pos;
+}
+
+/// @return position after the closing quote, pos must point to the opening one
+auto SkipString(std::string_view json, std::size_t pos) -> std::size_t {
+    while ((pos = json.find('"', pos + 1)) != kNotFound) {
+        // The quote is escaped if preceded by an odd number of backslashes
+        std::size_t backslashes = 0;
+        while (json[pos - 1 - backslashes] == '\\') {
+            ++backslashes;
+        }
+        if (backslashes % 2 == 0) {
+            return pos + 1;
+        }
+    }
+    return kNotFound;
+}
+
+/// @return position after the value starting at pos
+auto SkipValue(std::string_view json, std::size_t pos) -> std::size_t {
+    if (pos >= json.size()) {
+        return kNotFound;
+    }
+    if (json[pos] == '"') {
+        return SkipString(json, pos);
+    }
+    if (json[pos] != '{' && json[pos] != '[') {
+        while (pos < json.size() && !IsWhitespace(json[pos]) && json[pos] != ',' && json[pos] != '}' &&
+               json[pos] != ']') {
+            ++pos;
+        }
+        return pos;
+    }
+    std::size_t depth = 0;
+    while (pos < json.size()) {
+        switch (json[pos]) {
+            case '"':
+                pos = SkipString(json, pos);
+                if (pos == kNotFound) {
+                    return kNotFound;
+                }
+                continue;
+            case '{':
+            case '[':
+                ++depth;
+                break;
+            case '}':
+            case ']':
+                if (--depth == 0) {
+                    return pos + 1;
+                }
+                break;
+            default:
+                break;
+        }
+        ++pos;
+    }
+    return kNotFound;
+}
+
+/// @return member value of the object
+auto FindMember(std::string_view object, std::string_view name) -> std::optional<std::string_view> {
+    auto pos = SkipWhitespace(object, 0);
+    if (pos >= object.size() || object[pos] != '{') {
+        return std::nullopt;
+    }
+    pos = SkipWhitespace(object, pos + 1);
+    while (pos < object.size() && object[pos] == '"') {
+        const auto key_end = SkipString(object, pos);
+        if (key_end == kNotFound) {
+            return std::nullopt;
+        }
+        // Member names are compared as is, Paddle doesn't escape them
+        const auto key = object.substr(pos + 1, key_end - pos - 2);
+        pos = SkipWhitespace(object, key_end);
+        if (pos >= object.size() || object[pos] != ':') {
+            return std::nullopt;
+        }
+        const auto value_begin = SkipWhitespace(object, pos + 1);
+        const auto value_end = SkipValue(object, value_begin);
+        if (value_end == kNotFound) {
+            return std::nullopt;
+        }
+        if (key == name) {
+            return object.substr(value_begin, value_end - value_begin);
+        }
+        pos = SkipWhitespace(object, value_end);
+        if (pos >= object.size() || object[pos] != ',') {
+            return std::nullopt;
+        }
+        pos = SkipWhitespace(object, pos + 1);
+    }
+    return std::nullopt;
+}
+
+auto ParseHex(std::string_view digits) -> std::optional<std::uint32_t> {
+    std::uint32_t value = 0;
+    for (auto c : digits) {
+        value <<= 4;
+        if (c >= '0' && c <= '9') {
+            value |= static_cast<std::uint32_t>(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            value |= static_cast<std::uint32_t>(c - 'a' + 10);
+        } else if (c >= 'A' && c <= 'F') {
+            value |= static_cast<std::uint32_t>(c - 'A' + 10);
+        } else {
+            return std::nullopt;
+        }
+    }
+    return value;
+}
+
+auto AppendUtf8(std::string& out, std::uint32_t code_point) -> void {
+    if (code_point < 0x80) {
+        out.push_back(static_cast<char>(code_point));
+    } else if (code_point < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else if (code_point < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+}
+
+}  // namespace
+
+auto FindValue(std::string_view json, std::initializer_list<std::string_view> path) -> std::optional<std::string_view> {
+    std::optional<std::string_view> value = json;
+    for (auto name : path) {
+        value = FindMember(*value, name);
+        if (!value) {
+            break;
+        }
+    }
+    return value;
+}
+
+auto DecodeString(std::string_view raw) -> std::optional<std::string> {
+    if (raw.size() < 2 || raw.front() != '"' || raw.back() != '"') {
+        return std::nullopt;
+    }
+    raw = raw.substr(1, raw.size() - 2);
+    std::string result;
+    result.reserve(raw.size());
+    for (std::size_t pos = 0; pos < raw.size(); ++pos) {
+        if (raw[pos] != '\\') {
+            result.push_back(raw[pos]);
+            continue;
+        }
+        if (++pos == raw.size()) {
+            return std::nullopt;
+        }
+        switch (raw[pos]) {
+            case '"':
+            case '\\':
+            case '/':
+                result.push_back(raw[pos]);
+                break;
+            case 'b':
+                result.push_back('\b');
+                break;
+            case 'f':
+                result.push_back('\f');
+                break;
+            case 'n':
+                result.push_back('\n');
+                break;
+            case 'r':
+                result.push_back('\r');
+                break;
+            case 't':
+                result.push_back('\t');
+                break;
+            case 'u': {
+                if (pos + 4 >= raw.size()) {
+                    return std::nullopt;
+                }
+                auto code_point = ParseHex(raw.substr(pos + 1, 4));
+                if (!code_point) {
+                    return std::nullopt;
+                }
+                pos += 4;
+                // Surrogate pair
+                if (*code_point >= 0xD800 && *code_point < 0xDC00 && pos + 6 < raw.size() &&
+                    raw.substr(pos + 1, 2) == "\\u") {
+                    auto low = ParseHex(raw.substr(pos + 3, 4));
+                    if (low && *low >= 0xDC00 && *low < 0xE000) {
+                        code_point = 0x10000 + ((*code_point - 0xD800) << 10) + (*low - 0xDC00);
+                        pos += 6;
+                    }
+                }
+                AppendUtf8(result, *code_point);
+                break;
+            }
+            default:
+                return std::nullopt;
+        }
+    }
+    return result;
+}
+
+namespace {
+
+auto CharAt(std::string_view json, std::size_t pos) -> char {
+    return pos < json.size() ? json[pos] : '\0';
+}
+
+auto Trim(std::string_view json) -> std::string_view {
+    json.remove_prefix(SkipWhitespace(json, 0));
+    while (!json.empty() && IsWhitespace(json.back())) {
+        json.remove_suffix(1);
+    }
+    return json;
+}
+
+struct Member {
+    std::string_view name;
+    std::string_view value;
+    /// Position of the next member or of the closing brace
+    std::size_t next = 0;
+};
+
+/// @param pos position of the member name
+auto ReadMember(std::string_view object, std::size_t pos) -> Member {
+    if (CharAt(object, pos) != '"') {
+        throw ParseError("Malformed JSON object: member name expected");
+    }
+    const auto name_end = SkipString(object, pos);
+    if (name_end == kNotFound) {
+        throw ParseError("Malformed JSON object: unterminated member name");
+    }
+    // Member names are compared as is, Paddle doesn't escape them
+    Member member{object.substr(pos + 1, name_end - pos - 2), {}, 0};
+    pos = SkipWhitespace(object, name_end);
+    if (CharAt(object, pos) != ':') {
+        throw ParseError(fmt::format("Malformed JSON object: ':' expected after '{}'", member.name));
+    }
+    const auto value_begin = SkipWhitespace(object, pos + 1);
+    const auto value_end = SkipValue(object, value_begin);
+    if (value_end == kNotFound || value_end == value_begin) {
+        throw ParseError(fmt::format("Malformed JSON object: value of '{}' expected", member.name));
+    }
+    member.value = object.substr(value_begin, value_end - value_begin);
+    pos = SkipWhitespace(object, value_end);
+    if (CharAt(object, pos) == ',') {
+        pos = SkipWhitespace(object, pos + 1);
+    } else if (CharAt(object, pos) != '}') {
+        throw ParseError(fmt::format("Malformed JSON object: ',' or '}}' expected after '{}'", member.name));
+    }
+    member.next = pos;
+    return member;
+}
+
+}  // namespace
+
+Value::Value(std::string_view json) : raw_(Trim(json)), missing_(false) {
+    if (raw_.empty()) {
+        throw ParseError("Empty JSON document");
+    }
+}
+
+Value::Value(std::string_view raw, std::string_view name) : raw_(raw), name_(name), missing_(false) {}
+
+auto Value::operator[](std::string_view name) const -> Value {
+    if (auto member = FindMember(name, true)) {
+        return *member;
+    }
+    Value missing;
+    missing.name_ = name;
+    return missing;
+}
+
+auto Value::HasMember(std::string_view name) const -> bool {
+    return FindMember(name, false).has_value();
+}
+
+auto Value::FindMember(std::string_view name, bool advance) const -> std::optional<Value> {
+    if (!IsObject()) {
+        return std::nullopt;
+    }
+    const auto first = SkipWhitespace(raw_, 1);
+    const auto start = cursor_ == 0 ? first : cursor_;
+    auto pos = start;
+    // Scan from the cursor to the end of the object, then from the first member up to the cursor
+    bool wrapped = false;
+    while (!wrapped || pos < start) {
+        if (CharAt(raw_, pos) == '}') {
+            if (wrapped || start == first) {
+                break;
+            }
+            pos = first;
+            wrapped = true;
+            continue;
+        }
+        auto member = ReadMember(raw_, pos);
+        if (member.name == name) {
+            cursor_ = advance ? member.next : pos;
+            return Value{member.value, member.name};
+        }
+        pos = member.next;
+    }
+    return std::nullopt;
+}
+
+auto Value::NextElement(std::size_t& pos) const -> std::optional<Value> {
+    if (!IsArray()) {
+        ThrowTypeError("an array");
+    }
+    if (pos == 0) {
+        pos = SkipWhitespace(raw_, 1);
+    }
+    if (CharAt(raw_, pos) == ']') {
+        return std::nullopt;
+    }
+    const auto value_end = SkipValue(raw_, pos);
+    if (value_end == kNotFound || value_end == pos) {
+        throw ParseError(fmt::format("Malformed JSON array '{}': element expected", name_));
+    }
+    Value element{raw_.substr(pos, value_end - pos), name_};
+    pos = SkipWhitespace(raw_, value_end);
+    if (CharAt(raw_, pos) == ',') {
+        pos = SkipWhitespace(raw_, pos + 1);
+    } else if (CharAt(raw_, pos) != ']') {
+        throw ParseError(fmt::format("Malformed JSON array '{}': ',' or ']' expected", name_));
+    }
+    return element;
+}
+
+auto Value::IsMissing() const -> bool {
+    return missing_;
+}
+
+auto Value::IsNull() const -> bool {
+    return !missing_ && raw_ == "null";
+}
+
+auto Value::IsObject() const -> bool {
+    return !missing_ && raw_.front() == '{';
+}
+
+auto Value::IsArray() const -> bool {
+    return !missing_ && raw_.front() == '[';
+}
+
+auto Value::IsString() const -> bool {
+    return !missing_ && raw_.front() == '"';
+}
+
+auto Value::GetRaw() const -> std::string_view {
+    return raw_;
+}
+
+auto Value::AsString() const -> std::string {
+    if (!IsString()) {
+        ThrowTypeError("a string");
+    }
+    const auto content = raw_.substr(1, raw_.size() - 2);
+    if (content.find('\\') == kNotFound) {
+        return std::string{content};
+    }
+    auto decoded = DecodeString(raw_);
+    if (!decoded) {
+        ThrowTypeError("a valid string");
+    }
+    return std::move(*decoded);
+}
+
+auto Value::AsStringView() const -> std::string_view {
+    if (!IsString()) {
+        ThrowTypeError("a string");
+    }
+    const auto content = raw_.substr(1, raw_.size() - 2);
+    if (content.find('\\') != kNotFound) {
+        ThrowTypeError("a string without escape sequences");
+    }
+    return content;
+}
+
+auto Value::AsBool() const -> bool {
+    if (!missing_ && raw_ == "true") {
+        return true;
+    }
+    if (!missing_ && raw_ == "false") {
+        return false;
+    }
+    ThrowTypeError("a boolean");
+}
+
+auto Value::AsInt64() const -> std::int64_t {
+    std::int64_t result = 0;
+    auto [ptr, ec] = std::from_chars(raw_.data(), raw_.data() + raw_.size(), result);
+    if (missing_ || ec != std::errc{} || ptr != raw_.data() + raw_.size()) {
+        ThrowTypeError("an integer");
+    }
+    return result;
+}
+
+auto Value::AsUint64() const -> std::uint64_t {
+    std::uint64_t result = 0;
+    auto [ptr, ec] = std::from_chars(raw_.data(), raw_.data() + raw_.size(), result);
+    if (missing_ || ec != std::errc{} || ptr != raw_.data() + raw_.size()) {
+        ThrowTypeError("an unsigned integer");
+    }
+    return result;
+}
+
+auto Value::AsDouble() const -> double {
+    double result = 0;
+    auto [ptr, ec] = std::from_chars(raw_.data(), raw_.data() + raw_.size(), result);
+    if (missing_ || ec != std::errc{} || ptr != raw_.data() + raw_.size()) {
+        ThrowTypeError("a number");
+    }
+    return result;
+}
+
+auto Value::AsJson() const -> JSON {
+    if (missing_) {
+        return JSON{};
+    }
+    return userver::formats::json::FromString(raw_);
+}
+
+auto Value::AsTimePoint() const -> std::chrono::system_clock::time_point {
+    const auto text = AsStringView();
+    try {
+        return ParseRfc3339(text);
+    } catch (const std::exception&) {
+        ThrowTypeError("an RFC 3339 timestamp");
+    }
+}
+
+auto Value::AsUuid() const -> boost::uuids::uuid {
+    const auto text = AsString();
+    try {
+        return boost::uuids::string_generator{}(text);
+    } catch (const std::exception&) {
+        ThrowTypeError("a UUID");
+    }
+}
+
+auto Value::ThrowTypeError(std::string_view expected) const -> void {
+    const auto name = name_.empty() ? std::string_view{"<root>"} : name_;
+    if (missing_) {
+        throw ParseError(fmt::format("Field '{}' is missing", name));
+    }
+    throw ParseError(fmt::format("Field '{}' is not {}: {:.64}", name, expected, raw_));
+}
+
+}  // namespace paddle::raw_json
@@ -0,0 +1,37 @@
+#include <paddle/types/response.hpp>
+
+#include <userver/http/url.hpp>
+
+#include <string_view>
+
+namespace paddle {
+
+namespace {
+
+constexpr std::string_view kCursorParameter = "after=";
+
+}  // namespace
+
+auto Pagination::GetNextCursor() const -> std::optional<std::string> {
+    const std::string_view url{next};
+    const auto query_start = url.find('?');
+    if (query_start == std::string_view::npos) {
+        return std::nullopt;
+    }
+    auto query = url.substr(query_start + 1);
+    query = query.substr(0, query.find('#'));
+    while (!query.empty()) {
+        const auto end = query.find('&');
+        const auto parameter = query.substr(0, end);
+        if (parameter.starts_with(kCursorParameter)) {
+            return userver::http::UrlDecode(parameter.substr(kCursorParameter.size()));
+        }
+        if (end == std::string_view::npos) {
+            break;
+        }
+        query.remove_prefix(end + 1);
+    }
+    return std::nullopt;
+}
+
+}  // namespace paddle
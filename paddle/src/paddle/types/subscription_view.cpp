@@ -0,0 +1,83 @@
+#include <paddle/types/subscription_view.hpp>
+
+namespace paddle::subscriptions {
+
+SubscriptionView::SubscriptionView(JSON json) : json_(std::move(json)) {}
+
+auto SubscriptionView::GetJson() const -> const JSON& {
+    return json_;
+}
+
+auto SubscriptionView::GetId() const -> const SubscriptionId& {
+    return id_.Get([this] { return json_["id"].As<SubscriptionId>(); });
+}
+
+auto SubscriptionView::GetStatus() const -> SubscriptionStatus {
+    return status_.Get([this] { return json_["status"].As<SubscriptionStatus>(); });
+}
+
+auto SubscriptionView::GetCustomerId() const -> const CustomerId& {
+    return customer_id_.Get([this] { return json_["customer_id"].As<CustomerId>(); });
+}
+
+auto SubscriptionView::GetAddressId() const -> const AddressId& {
+    return address_id_.Get([this] { return json_["address_id"].As<AddressId>(); });
+}
+
+auto SubscriptionView::GetBusinessId() const -> const OptionalBusinessId& {
+    return business_id_.Get([this] { return json_["business_id"].As<OptionalBusinessId>(); });
+}
+
+auto SubscriptionView::GetCurrencyCode() const -> const money::CurrencyCode& {
+    return currency_code_.Get([this] { return json_["currency_code"].As<money::CurrencyCode>(); });
+}
+
+auto SubscriptionView::GetCustomData() const -> JSON {
+    return json_["custom_data"];
+}
+
+auto SubscriptionView::GetCollectionMode() const -> CollectionMode {
+    return collection_mode_.Get([this] { return json_["collection_mode"].As<CollectionMode>(); });
+}
+
+auto SubscriptionView::GetCurrentBillingPeriod() const -> const TimePeriod& {
+    return current_billing_period_.Get([this] { return json_["current_billing_period"].As<TimePeriod>(); });
+}
+
+auto SubscriptionView::GetBillingCycle() const -> const Duration& {
+    return billing_cycle_.Get([this] { return json_["billing_cycle"].As<Duration>(); });
+}
+
+auto SubscriptionView::GetScheduledChange() const -> const OptionalScheduledChange& {
+    return scheduled_change_.Get([this] { return json_["scheduled_change"].As<OptionalScheduledChange>(); });
+}
+
+auto SubscriptionView::GetItems() const -> const std::vector<Item>& {
+    return items_.Get([this] { return json_["items"].As<std::vector<Item>>(); });
+}
+
+auto SubscriptionView::GetCreatedAt() const -> Timestamp {
+    return created_at_.Get([this] { return ParseTimestamp(json_["created_at"]); });
+}
+
+auto SubscriptionView::GetUpdatedAt() const -> Timestamp {
+    return updated_at_.Get([this] { return ParseTimestamp(json_["updated_at"]); });
+}
+
+auto SubscriptionView::GetNextBilledAt() const -> OptionalTimestamp {
+    return next_billed_at_.Get([this] { return ParseOptionalTimestamp(json_["next_billed_at"]); });
+}
+
+auto SubscriptionView::GetPausedAt() const -> OptionalTimestamp {
+    return paused_at_.Get([this] { return ParseOptionalTimestamp(json_["paused_at"]); });
+}
+
+auto SubscriptionView::GetCanceledAt() const -> OptionalTimestamp {
+    return canceled_at_.Get([this] { return ParseOptionalTimestamp(json_["canceled_at"]); });
+}
+
+auto SubscriptionView::ToSubscription() const -> Subscription {
+    return json_.As<Subscription>();
+}
+
+}  // namespace paddle::subscriptions
@@ -0,0 +1,150 @@
+#include <paddle/types/timestamp.hpp>
+
+#include <userver/utils/datetime.hpp>
+
+#include <fmt/format.h>
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+
+namespace paddle {
+
+namespace {
+
+/// `YYYY-MM-DDTHH:MM:SS`
+constexpr std::size_t kDateTimeSize = 19;
+constexpr std::array<std::size_t, 14> kDigitPositions{0, 1, 2, 3, 5, 6, 8, 9, 11, 12, 14, 15, 17, 18};
+constexpr std::int64_t kMicrosPerSecond = 1'000'000;
+constexpr std::size_t kFractionDigits = 6;
+
+/// Wraps around for anything below '0', a single comparison checks the range
+constexpr auto Digit(char c) -> unsigned {
+    return static_cast<unsigned>(static_cast<unsigned char>(c)) - static_cast<unsigned>('0');
+}
+
+constexpr auto TwoDigits(const char* p) -> unsigned {
+    return Digit(p[0]) * 10 + Digit(p[1]);
+}
+
+constexpr auto IsLeapYear(unsigned year) -> bool {
+    return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
+
+constexpr auto DaysInMonth(unsigned year, unsigned month) -> unsigned {
+    if (month == 2) {
+        return IsLeapYear(year) ? 29 : 28;
+    }
+    return 30 + ((month + month / 8) & 1);
+}
+
+/// Days since 1970-01-01, http://howardhinnant.github.io/date_algorithms.html#days_from_civil
+constexpr auto DaysFromCivil(unsigned year, unsigned month, unsigned day) -> std::int64_t {
+    const auto y = static_cast<std::int64_t>(year) - (month <= 2 ? 1 : 0);
+    const auto era = (y >= 0 ? y : y - 399) / 400;
+    const auto year_of_era = y - era * 400;
+    const auto day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const auto day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
+
+static_assert(DaysFromCivil(1970, 1, 1) == 0);
+static_assert(DaysFromCivil(2000, 3, 1) == 11017);
+
+/// Paddle's own form, returns nullopt for anything else to leave it to the fallback
+auto ParseFast(std::string_view text) -> std::optional<std::chrono::system_clock::time_point> {
+    if (text.size() < kDateTimeSize + 1) {
+        return std::nullopt;
+    }
+    const auto* p = text.data();
+    // Fixed positions, no early exits so the checks vectorize
+    unsigned invalid = 0;
+    for (auto position : kDigitPositions) {
+        invalid |= static_cast<unsigned>(Digit(p[position]) > 9);
+    }
+    invalid |= static_cast<unsigned>(p[4] != '-') | static_cast<unsigned>(p[7] != '-') |
+               static_cast<unsigned>(p[10] != 'T') | static_cast<unsigned>(p[13] != ':') |
+               static_cast<unsigned>(p[16] != ':');
+    if (invalid != 0) {
+        return std::nullopt;
+    }
+    const auto year = TwoDigits(p) * 100 + TwoDigits(p + 2);
+    const auto month = TwoDigits(p + 5);
+    const auto day = TwoDigits(p + 8);
+    const auto hour = TwoDigits(p + 11);
+    const auto minute = TwoDigits(p + 14);
+    // Leap seconds go to the fallback
+    const auto second = TwoDigits(p + 17);
+    if (month < 1 || month > 12 || day < 1 || day > DaysInMonth(year, month) || hour > 23 || minute > 59 ||
+        second > 59) {
+        return std::nullopt;
+    }
+
+    auto position = kDateTimeSize;
+    std::int64_t micros = 0;
+    if (p[position] == '.') {
+        const auto start = ++position;
+        while (position < text.size() && Digit(p[position]) <= 9) {
+            if (position - start < kFractionDigits) {
+                micros = micros * 10 + Digit(p[position]);
+            }
+            ++position;
+        }
+        const auto digits = position - start;
+        if (digits == 0) {
+            return std::nullopt;
+        }
+        for (auto i = digits; i < kFractionDigits; ++i) {
+            micros *= 10;
+        }
+    }
+
+    std::int64_t offset_seconds = 0;
+    const auto zone = text.substr(position);
+    if (zone == "Z") {
+        // UTC, what Paddle sends
+    } else if (zone.size() == 6 && (zone[0] == '+' || zone[0] == '-') && zone[3] == ':' &&
+               Digit(zone[1]) <= 9 && Digit(zone[2]) <= 9 && Digit(zone[4]) <= 9 && Digit(zone[5]) <= 9) {
+        const auto offset_hours = TwoDigits(zone.data() + 1);
+        const auto offset_minutes = TwoDigits(zone.data() + 4);
+        if (offset_hours > 23 || offset_minutes > 59) {
+            return std::nullopt;
+        }
+        offset_seconds = static_cast<std::int64_t>(offset_hours * 3600 + offset_minutes * 60);
+        if (zone[0] == '-') {
+            offset_seconds = -offset_seconds;
+        }
+    } else {
+        return std::nullopt;
+    }
+
+    const auto seconds = DaysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second - offset_seconds;
+    // Years far from the epoch may not fit the clock, e.g. past 2262 with nanoseconds
+    constexpr auto kMaxSeconds =
+        std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::duration::max()).count() - 1;
+    if (seconds >= kMaxSeconds || seconds <= -kMaxSeconds) {
+        return std::nullopt;
+    }
+    return std::chrono::system_clock::time_point{
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::microseconds{seconds * kMicrosPerSecond + micros}
+        )};
+}
+
+}  // namespace
+
+auto ParseRfc3339(std::string_view text) -> std::chrono::system_clock::time_point {
+    if (auto time_point = ParseFast(text)) {
+        return *time_point;
+    }
+    try {
+        const auto time_point = userver::utils::datetime::Stringtime(
+            std::string{text}, userver::utils::datetime::kDefaultTimezone, userver::utils::datetime::kRfc3339Format
+        );
+        return std::chrono::floor<std::chrono::microseconds>(time_point);
+    } catch (const std::exception&) {
+        throw std::invalid_argument(fmt::format("Invalid RFC 3339 timestamp: '{:.64}'", text));
+    }
+}
+
+}  // namespace paddle
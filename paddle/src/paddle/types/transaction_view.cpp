@@ -0,0 +1,92 @@
+#include <paddle/types/transaction_view.hpp>
+
+namespace paddle::transactions {
+
+TransactionView::TransactionView(JSON json) : json_(std::move(json)) {}
+
+auto TransactionView::GetJson() const -> const JSON& {
+    return json_;
+}
+
+auto TransactionView::GetId() const -> const TransactionId& {
+    return id_.Get([this] { return json_["id"].As<TransactionId>(); });
+}
+
+auto TransactionView::GetStatus() const -> TransactionStatus {
+    return status_.Get([this] { return json_["status"].As<TransactionStatus>(); });
+}
+
+auto TransactionView::GetCustomerId() const -> const OptionalCustomerId& {
+    return customer_id_.Get([this] { return json_["customer_id"].As<OptionalCustomerId>(); });
+}
+
+auto TransactionView::GetAddressId() const -> const OptionalAddressId& {
+    return address_id_.Get([this] { return json_["address_id"].As<OptionalAddressId>(); });
+}
+
+auto TransactionView::GetBusinessId() const -> const OptionalBusinessId& {
+    return business_id_.Get([this] { return json_["business_id"].As<OptionalBusinessId>(); });
+}
+
+auto TransactionView::GetCustomData() const -> JSON {
+    return json_["custom_data"];
+}
+
+auto TransactionView::GetCurrencyCode() const -> const money::CurrencyCode& {
+    return currency_code_.Get([this] { return json_["currency_code"].As<money::CurrencyCode>(); });
+}
+
+auto TransactionView::GetOrigin() const -> TransactionOrigin {
+    return origin_.Get([this] { return json_["origin"].As<TransactionOrigin>(); });
+}
+
+auto TransactionView::GetSubscriptionId() const -> const OptionalSubscriptionId& {
+    return subscription_id_.Get([this] { return json_["subscription_id"].As<OptionalSubscriptionId>(); });
+}
+
+auto TransactionView::GetCollectionMode() const -> CollectionMode {
+    return collection_mode_.Get([this] { return json_["collection_mode"].As<CollectionMode>(); });
+}
+
+auto TransactionView::GetBillingPeriod() const -> const std::optional<TimePeriod>& {
+    return billing_period_.Get([this] { return json_["billing_period"].As<std::optional<TimePeriod>>(); });
+}
+
+auto TransactionView::GetTotals() const -> const TransactionTotals& {
+    if (details_.IsDecoded()) {
+        return GetDetails().totals;
+    }
+    return totals_.Get([this] { return json_["details"]["totals"].As<TransactionTotals>(); });
+}
+
+auto TransactionView::GetDetails() const -> const Details& {
+    return details_.Get([this] { return json_["details"].As<Details>(); });
+}
+
+auto TransactionView::GetItems() const -> const std::vector<Item>& {
+    return items_.Get([this] { return json_["items"].As<std::vector<Item>>(); });
+}
+
+auto TransactionView::GetPayments() const -> const std::vector<PaymentAttempt>& {
+    return payments_.Get([this] {
+        return json_["payments"].As<std::vector<PaymentAttempt>>(std::vector<PaymentAttempt>{});
+    });
+}
+
+auto TransactionView::GetCreatedAt() const -> Timestamp {
+    return created_at_.Get([this] { return ParseTimestamp(json_["created_at"]); });
+}
+
+auto TransactionView::GetUpdatedAt() const -> Timestamp {
+    return updated_at_.Get([this] { return ParseTimestamp(json_["updated_at"]); });
+}
+
+auto TransactionView::GetBilledAt() const -> OptionalTimestamp {
+    return billed_at_.Get([this] { return ParseOptionalTimestamp(json_["billed_at"]); });
+}
+
+auto TransactionView::ToTransaction() const -> Transaction {
+    return json_.As<Transaction>();
+}
+
+}  // namespace paddle::transactions
@@ -0,0 +1,118 @@
+#include <paddle/handlers/snapshot_store.hpp>
+#include <paddle/types/changes.hpp>
+
+#include <userver/formats/json/serialize.hpp>
+#include <userver/utest/utest.hpp>
+
+#include <fmt/format.h>
+
+#include <chrono>
+
+namespace paddle {
+
+namespace {
+
+const auto kPrevious = userver::formats::json::FromString(R"({
+    "id": "sub_01k2jjkzv4h5te6zw46gfnrxnw",
+    "status": "active",
+    "billing_details": {"payment_terms": {"interval": "day", "frequency": 30}, "purchase_order_number": null},
+    "items": [{"quantity": 1}],
+    "custom_data": {"plan": "basic"},
+    "updated_at": "2025-08-13T20:40:50.100Z"
+})");
+
+auto MakeEvent(const char* status, std::chrono::seconds occurred_at) -> events::Event<JSON> {
+    events::Event<JSON> event;
+    event.event_type = events::EventTypeName::kSubscriptionUpdated;
+    event.occurred_at = Timestamp{std::chrono::system_clock::time_point{occurred_at}};
+    event.data = userver::formats::json::FromString(
+        fmt::format(R"({{"id": "sub_01k2jjkzv4h5te6zw46gfnrxnw", "status": "{}"}})", status)
+    );
+    return event;
+}
+
+}  // namespace
+
+TEST(Paddle, ChangesUnknown) {
+    events::Changes changes;
+    ASSERT_FALSE(changes.IsKnown());
+    ASSERT_FALSE(changes.IsEmpty());
+    ASSERT_TRUE(changes.Contains(events::Field::kStatus));
+    ASSERT_TRUE(changes.Contains("billing_details.payment_terms"));
+}
+
+TEST(Paddle, ChangesNothingChanged) {
+    auto changes = events::Changes::Compute(kPrevious, kPrevious);
+    ASSERT_TRUE(changes.IsKnown());
+    ASSERT_TRUE(changes.IsEmpty());
+    ASSERT_FALSE(changes.ContainsAny({events::Field::kStatus, events::Field::kItems}));
+    ASSERT_FALSE(changes.Contains("custom_data"));
+}
+
+TEST(Paddle, ChangesFieldPaths) {
+    auto current = userver::formats::json::FromString(R"({
+        "id": "sub_01k2jjkzv4h5te6zw46gfnrxnw",
+        "status": "active",
+        "billing_details": {"payment_terms": {"interval": "day", "frequency": 14}, "purchase_order_number": null},
+        "items": [{"quantity": 2}],
+        "custom_data": {"plan": "basic", "seats": 5},
+        "updated_at": "2025-08-13T20:40:51.100Z"
+    })");
+    auto changes = events::Changes::Compute(kPrevious, current);
+    ASSERT_TRUE(changes.IsKnown());
+    ASSERT_EQ(
+        changes.GetPaths(),
+        (std::vector<std::string>{
+            "billing_details.payment_terms.frequency", "custom_data.seats", "items", "updated_at"})
+    );
+    ASSERT_FALSE(changes.Contains(events::Field::kStatus));
+    ASSERT_TRUE(changes.Contains(events::Field::kBillingDetails));
+    ASSERT_TRUE(changes.Contains(events::Field::kItems));
+    ASSERT_TRUE(changes.Contains("billing_details"));
+    ASSERT_TRUE(changes.Contains("billing_details.payment_terms"));
+    ASSERT_FALSE(changes.Contains("billing_details.payment_terms.interval"));
+    ASSERT_FALSE(changes.Contains("billing_details.purchase_order_number"));
+    ASSERT_TRUE(changes.Contains("items.quantity"));
+    ASSERT_FALSE(changes.Contains("custom_data.plan"));
+    ASSERT_FALSE(changes.Contains("status"));
+}
+
+TEST(Paddle, ChangesRemovedField) {
+    auto current = userver::formats::json::FromString(R"({
+        "id": "sub_01k2jjkzv4h5te6zw46gfnrxnw",
+        "status": "canceled",
+        "billing_details": {"payment_terms": {"interval": "day", "frequency": 30}, "purchase_order_number": null},
+        "items": [{"quantity": 1}],
+        "updated_at": "2025-08-13T20:40:50.100Z"
+    })");
+    auto changes = events::Changes::Compute(kPrevious, current);
+    ASSERT_EQ(changes.GetPaths(), (std::vector<std::string>{"custom_data", "status"}));
+    ASSERT_TRUE(changes.Contains(events::Field::kCustomData));
+    ASSERT_TRUE(changes.Contains("custom_data.plan"));
+    ASSERT_FALSE(changes.Contains(events::Field::kOther));
+}
+
+UTEST(Paddle, ChangesRetryAfterFailedHandler) {
+    handlers::LruSnapshotStore store{16};
+    auto created = MakeEvent("active", std::chrono::seconds{1700000000});
+    handlers::TrackChanges(store, created).Commit();
+    ASSERT_FALSE(created.changes.IsKnown());
+
+    // The handler fails, the snapshot is not stored
+    auto updated = MakeEvent("canceled", std::chrono::seconds{1700000060});
+    auto snapshot = handlers::TrackChanges(store, updated);
+    ASSERT_TRUE(updated.changes.Contains(events::Field::kStatus));
+
+    // Paddle retries with the same data
+    auto retried = MakeEvent("canceled", std::chrono::seconds{1700000060});
+    handlers::TrackChanges(store, retried).Commit();
+    ASSERT_TRUE(retried.changes.IsKnown());
+    ASSERT_TRUE(retried.changes.Contains(events::Field::kStatus));
+
+    auto replayed = MakeEvent("canceled", std::chrono::seconds{1700000060});
+    handlers::TrackChanges(store, replayed);
+    ASSERT_TRUE(replayed.changes.IsKnown());
+    ASSERT_TRUE(replayed.changes.IsEmpty());
+}
+
+}  // namespace paddle
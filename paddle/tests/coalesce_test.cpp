@@ -0,0 +1,151 @@
+#include <paddle/handlers/event_coalescer.hpp>
+
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace paddle {
+
+namespace {
+
+auto MakeEvent(const char* event_id, const char* event_type, const char* occurred_at) -> events::Event<JSON> {
+    userver::formats::json::ValueBuilder builder;
+    builder["event_id"] = event_id;
+    builder["event_type"] = event_type;
+    builder["occurred_at"] = occurred_at;
+    builder["data"]["id"] = "sub_01k2jjkzv4h5te6zw46gfnrxnw";
+    return builder.ExtractValue().As<events::Event<JSON>>();
+}
+
+constexpr auto kEntityId = "sub_01k2jjkzv4h5te6zw46gfnrxnw";
+constexpr std::chrono::milliseconds kWindow{10};
+
+}  // namespace
+
+TEST(Paddle, CoalesceKeepsLatestUpdate) {
+    std::vector<events::Event<JSON>> events;
+    events.push_back(MakeEvent("evt_01k2jjm0qdjr26zsz4m48z2ef1", "subscription.updated", "2025-08-13T20:40:50.300Z"));
+    events.push_back(MakeEvent("evt_01k2jjm0qdjr26zsz4m48z2ef2", "subscription.updated", "2025-08-13T20:40:50.100Z"));
+    events.push_back(MakeEvent("evt_01k2jjm0qdjr26zsz4m48z2ef3", "subscription.updated", "2025-08-13T20:40:50.200Z"));
+
+    auto order = handlers::CoalesceEvents(events);
+    ASSERT_EQ(order, (std::vector<std::size_t>{0}));
+}
+
+TEST(Paddle, CoalesceKeepsLifecycleEvents) {
+    std::vector<events::Event<JSON>> events;
+    events.push_back(MakeEvent("evt_01k2jjm0qdjr26zsz4m48z2ef1", "subscription.updated", "2025-08-13T20:40:50.400Z"));
+    events.push_back(MakeEvent("evt_01k2jjm0qdjr26zsz4m48z2ef2", "subscription.activated", "2025-08-13T20:40:50.200Z"));
+    events.push_back(MakeEvent("evt_01k2jjm0qdjr26zsz4m48z2ef3", "subscription.created", "2025-08-13T20:40:50.100Z"));
+    events.push_back(MakeEvent("evt_01k2jjm0qdjr26zsz4m48z2ef4", "subscription.updated", "2025-08-13T20:40:50.300Z"));
+    events.push_back(MakeEvent("evt_01k2jjm0qdjr26zsz4m48z2ef5", "subscription.canceled", "2025-08-13T20:40:50.500Z"));
+
+    auto order = handlers::CoalesceEvents(events);
+    ASSERT_EQ(order, (std::vector<std::size_t>{2, 1, 0, 4}));
+}
+
+TEST(Paddle, CoalesceWithoutUpdates) {
+    std::vector<events::Event<JSON>> events;
+    events.push_back(MakeEvent("evt_01k2jjm0qdjr26zsz4m48z2ef1", "transaction.paid", "2025-08-13T20:40:50.200Z"));
+    events.push_back(MakeEvent("evt_01k2jjm0qdjr26zsz4m48z2ef2", "transaction.completed", "2025-08-13T20:40:50.300Z"));
+    events.push_back(MakeEvent("evt_01k2jjm0qdjr26zsz4m48z2ef3", "transaction.created", "2025-08-13T20:40:50.100Z"));
+
+    auto order = handlers::CoalesceEvents(events);
+    ASSERT_EQ(order, (std::vector<std::size_t>{2, 0, 1}));
+}
+
+UTEST(Paddle, CoalescerKeepsEntityOrder) {
+    handlers::EventCoalescer coalescer{kWindow};
+    userver::engine::SingleConsumerEvent release_first;
+    std::vector<std::string> log;
+    const auto first_id = EventId{"evt_01k2jjm0qdjr26zsz4m48z2ef1"};
+    const handlers::EventCoalescer::DispatchFunction dispatch = [&](const JSON&, events::Event<JSON>&& event) {
+        log.push_back("begin " + event.event_id.ToString());
+        if (event.event_id == first_id) {
+            EXPECT_TRUE(release_first.WaitForEvent());
+        }
+        log.push_back("end " + event.event_id.ToString());
+        return handlers::DispatchResult::kHandled;
+    };
+
+    auto first = userver::utils::Async("first", [&] {
+        return coalescer.Submit(
+            kEntityId,
+            {},
+            MakeEvent("evt_01k2jjm0qdjr26zsz4m48z2ef1", "subscription.created", "2025-08-13T20:40:50.100Z"),
+            dispatch
+        );
+    });
+    while (log.empty()) {
+        userver::engine::SleepFor(std::chrono::milliseconds{1});
+    }
+    // The first batch is still dispatched, the second one waits for it after its window closes
+    auto second = userver::utils::Async("second", [&] {
+        return coalescer.Submit(
+            kEntityId,
+            {},
+            MakeEvent("evt_01k2jjm0qdjr26zsz4m48z2ef2", "subscription.activated", "2025-08-13T20:40:50.200Z"),
+            dispatch
+        );
+    });
+    userver::engine::SleepFor(kWindow * 5);
+    EXPECT_EQ(log, (std::vector<std::string>{"begin evt_01k2jjm0qdjr26zsz4m48z2ef1"}));
+
+    release_first.Send();
+    EXPECT_EQ(first.Get(), handlers::DispatchResult::kHandled);
+    EXPECT_EQ(second.Get(), handlers::DispatchResult::kHandled);
+    EXPECT_EQ(
+        log,
+        (std::vector<std::string>{
+            "begin evt_01k2jjm0qdjr26zsz4m48z2ef1",
+            "end evt_01k2jjm0qdjr26zsz4m48z2ef1",
+            "begin evt_01k2jjm0qdjr26zsz4m48z2ef2",
+            "end evt_01k2jjm0qdjr26zsz4m48z2ef2",
+        })
+    );
+}
+
+UTEST(Paddle, CoalescerSurvivesCancelledSubmitter) {
+    handlers::EventCoalescer coalescer{kWindow};
+    std::vector<events::EventTypeName> dispatched;
+    const handlers::EventCoalescer::DispatchFunction dispatch = [&](const JSON&, events::Event<JSON>&& event) {
+        dispatched.push_back(event.event_type);
+        return handlers::DispatchResult::kHandled;
+    };
+
+    auto first = userver::utils::Async("first", [&] {
+        return coalescer.Submit(
+            kEntityId,
+            {},
+            MakeEvent("evt_01k2jjm0qdjr26zsz4m48z2ef1", "subscription.created", "2025-08-13T20:40:50.100Z"),
+            dispatch
+        );
+    });
+    auto second = userver::utils::Async("second", [&] {
+        return coalescer.Submit(
+            kEntityId,
+            {},
+            MakeEvent("evt_01k2jjm0qdjr26zsz4m48z2ef2", "subscription.activated", "2025-08-13T20:40:50.200Z"),
+            dispatch
+        );
+    });
+    userver::engine::SleepFor(std::chrono::milliseconds{1});
+    // The request of the event that opened the window goes away
+    first.SyncCancel();
+
+    EXPECT_EQ(second.Get(), handlers::DispatchResult::kHandled);
+    EXPECT_EQ(
+        dispatched,
+        (std::vector<events::EventTypeName>{
+            events::EventTypeName::kSubscriptionCreated, events::EventTypeName::kSubscriptionActivated
+        })
+    );
+}
+
+}  // namespace paddle
@@ -0,0 +1,53 @@
+#include <paddle/types/enums.hpp>
+#include <paddle/types/events.hpp>
+#include <paddle/types/raw_json.hpp>
+
+#include <userver/utest/utest.hpp>
+
+namespace paddle {
+
+namespace {
+
+template <typename Enum>
+void ExpectAllLiteralsParse() {
+    using EnumMap = userver::storages::postgres::io::detail::EnumerationMap<Enum>;
+    for (std::size_t i = 0; i < impl::kEnumValueCount<Enum>; ++i) {
+        const auto value = static_cast<Enum>(i);
+        const auto literal = EnumMap::GetLiteral(value);
+        EXPECT_EQ(impl::ParseEnumLiteral<Enum>(literal), value) << literal;
+    }
+}
+
+}  // namespace
+
+static_assert(impl::FindEnumerator<SubscriptionStatus>("trialing") == SubscriptionStatus::kTrialing);
+static_assert(!impl::FindEnumerator<SubscriptionStatus>("trial"));
+
+UTEST(Enums, ParseAllLiterals) {
+    ExpectAllLiteralsParse<TransactionStatus>();
+    ExpectAllLiteralsParse<TransactionOrigin>();
+    ExpectAllLiteralsParse<PaymentAttemptStatus>();
+    ExpectAllLiteralsParse<PaymentAttemptErrorCode>();
+    ExpectAllLiteralsParse<PaymentMethodType>();
+    ExpectAllLiteralsParse<SubscriptionStatus>();
+    ExpectAllLiteralsParse<SubscriptionItemStatus>();
+    ExpectAllLiteralsParse<events::EventTypeName>();
+}
+
+UTEST(Enums, ParseUnknownLiteral) {
+    const auto json = userver::formats::json::FromString(R"({"type": "crypto_wallet", "status": "refunded"})");
+    EXPECT_EQ(json["type"].As<PaymentMethodType>(), PaymentMethodType::kUnknown);
+    EXPECT_ANY_THROW(json["status"].As<TransactionStatus>());
+
+    const raw_json::Value on_demand{R"({"type": "crypto_wallet", "status": "refunded"})"};
+    EXPECT_EQ(on_demand["type"].As<PaymentMethodType>(), PaymentMethodType::kUnknown);
+    EXPECT_ANY_THROW(on_demand["status"].As<TransactionStatus>());
+}
+
+UTEST(Enums, ParseOnDemand) {
+    const raw_json::Value json{R"({"origin": "subscription_payment_method_change", "event_type": "transaction.paid"})"};
+    EXPECT_EQ(json["origin"].As<TransactionOrigin>(), TransactionOrigin::kSubscriptionPaymentMethodChange);
+    EXPECT_EQ(json["event_type"].As<events::EventTypeName>(), events::EventTypeName::kTransactionPaid);
+}
+
+}  // namespace paddle
@@ -0,0 +1,76 @@
+#include <paddle/handlers/event_filter.hpp>
+#include <paddle/types/raw_json.hpp>
+
+#include <userver/utest/utest.hpp>
+
+namespace paddle {
+
+namespace {
+
+const auto kPayload =
+    R"({"data":{"id":"txn_01k2jjkzv4h5te6zw46gfnrxnw","items":[{"price":{"custom_data":{"app":"other"}}}],"status":"paid","custom_data":{"app":"billing","tier":2,"note":"café \"du coin\""}},"event_id":"evt_01k2jjm0qdjr26zsz4m48z2efq","event_type":"transaction.paid","occurred_at":"2025-08-13T20:40:50.669839Z","notification_id":"ntf_01k2jjm13zz5m5t681nvn0e5hr"})";
+const auto kSimulationPayload =
+    R"({"event_id":"evt_01k2jjm0qdjr26zsz4m48z2efq","event_type":"subscription.updated","occurred_at":"2025-08-13T20:40:50.669839Z","notification_id":"ntfsim_01k2jjm13zz5m5t681nvn0e5hr","data":{"id":"sub_01k2jjkzv4h5te6zw46gfnrxnw"}})";
+
+}  // namespace
+
+TEST(Paddle, RawJsonFindValue) {
+    ASSERT_EQ(raw_json::FindValue(kPayload, {"event_type"}), R"("transaction.paid")");
+    ASSERT_EQ(raw_json::FindValue(kPayload, {"data", "custom_data", "app"}), R"("billing")");
+    ASSERT_EQ(raw_json::FindValue(kPayload, {"data", "custom_data", "tier"}), "2");
+    ASSERT_EQ(raw_json::FindValue(kPayload, {"data", "status"}), R"("paid")");
+    ASSERT_FALSE(raw_json::FindValue(kPayload, {"data", "custom_data", "missing"}));
+    ASSERT_FALSE(raw_json::FindValue(kPayload, {"event_type", "nested"}));
+    ASSERT_FALSE(raw_json::FindValue(R"({"event_type": "transaction.paid")", {"data"}));
+}
+
+TEST(Paddle, RawJsonDecodeString) {
+    auto note = raw_json::FindValue(kPayload, {"data", "custom_data", "note"});
+    ASSERT_TRUE(note);
+    ASSERT_EQ(raw_json::DecodeString(*note), "caf\xc3\xa9 \"du coin\"");
+    ASSERT_EQ(raw_json::DecodeString(R"("😀")"), "\xf0\x9f\x98\x80");
+    ASSERT_FALSE(raw_json::DecodeString("42"));
+    ASSERT_FALSE(raw_json::DecodeString(R"("\u00e")"));
+}
+
+TEST(Paddle, EventFilterEventTypes) {
+    handlers::EventFilterConfig config;
+    config.allowed_event_types = {"transaction.*", "subscription.*"};
+    config.denied_event_types = {"subscription.updated"};
+    handlers::EventFilter filter{config};
+    ASSERT_EQ(filter.Evaluate(kPayload), handlers::FilterVerdict::kAccepted);
+    ASSERT_EQ(filter.Evaluate(kSimulationPayload), handlers::FilterVerdict::kEventType);
+
+    config.allowed_event_types = {"customer.*"};
+    config.denied_event_types.clear();
+    handlers::EventFilter customers_only{config};
+    ASSERT_EQ(customers_only.Evaluate(kPayload), handlers::FilterVerdict::kEventType);
+}
+
+TEST(Paddle, EventFilterTrafficSource) {
+    handlers::EventFilterConfig config;
+    config.traffic_source = events::TrafficSource::kPlatform;
+    handlers::EventFilter platform{config};
+    ASSERT_EQ(platform.Evaluate(kPayload), handlers::FilterVerdict::kAccepted);
+    ASSERT_EQ(platform.Evaluate(kSimulationPayload), handlers::FilterVerdict::kTrafficSource);
+
+    config.traffic_source = events::TrafficSource::kSimulation;
+    handlers::EventFilter simulation{config};
+    ASSERT_EQ(simulation.Evaluate(kPayload), handlers::FilterVerdict::kTrafficSource);
+    ASSERT_EQ(simulation.Evaluate(kSimulationPayload), handlers::FilterVerdict::kAccepted);
+}
+
+TEST(Paddle, EventFilterCustomData) {
+    handlers::EventFilterConfig config;
+    config.custom_data = {{"app", "billing"}, {"tier", "2"}};
+    handlers::EventFilter filter{config};
+    ASSERT_EQ(filter.Evaluate(kPayload), handlers::FilterVerdict::kAccepted);
+    ASSERT_EQ(filter.Evaluate(kSimulationPayload), handlers::FilterVerdict::kCustomData);
+
+    config.custom_data = {{"app", "other"}};
+    handlers::EventFilter other_app{config};
+    ASSERT_EQ(other_app.Evaluate(kPayload), handlers::FilterVerdict::kCustomData);
+    ASSERT_TRUE(handlers::EventFilter{handlers::EventFilterConfig{}}.IsEmpty());
+}
+
+}  // namespace paddle
@@ -0,0 +1,128 @@
+#include <paddle/archive/event_log.hpp>
+
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/utest/utest.hpp>
+
+#include <fmt/format.h>
+
+#include <filesystem>
+
+namespace paddle {
+
+namespace {
+
+/// Small enough for a couple of events per segment
+constexpr std::uint64_t kSegmentMaxSize = 600;
+
+auto MakeEventId(int index) -> std::string {
+    return fmt::format("evt_01k2jjm0qd{:016}", index);
+}
+
+auto MakeRawEvent(int index, std::string_view event_type, std::string_view entity_id) -> std::string {
+    return fmt::format(
+        R"({{"event_id":"{}","event_type":"{}","occurred_at":"2025-08-13T20:40:{:02}.669327Z","data":{{"id":"{}"}}}})",
+        MakeEventId(index),
+        event_type,
+        index,
+        entity_id
+    );
+}
+
+auto MakeRawEvent(int index) -> std::string {
+    return MakeRawEvent(
+        index,
+        index % 2 ? "subscription.updated" : "transaction.completed",
+        index % 2 ? "sub_01k2jjkzv4h5te6zw46gfnrxnw" : "txn_01k2jjkzv4h5te6zw46gfnrxnw"
+    );
+}
+
+auto MakeSettings(const userver::fs::blocking::TempDirectory& directory) -> archive::EventLogSettings {
+    archive::EventLogSettings settings;
+    settings.directory = directory.GetPath();
+    settings.segment_max_size = kSegmentMaxSize;
+    return settings;
+}
+
+}  // namespace
+
+TEST(Paddle, IndexRecordFromRawEvent) {
+    auto record = archive::MakeIndexRecord(MakeRawEvent(7));
+    ASSERT_TRUE(record);
+    ASSERT_EQ(record->GetEventId(), MakeEventId(7));
+    ASSERT_EQ(record->GetEventType(), "subscription.updated");
+    ASSERT_EQ(record->GetEntityId(), "sub_01k2jjkzv4h5te6zw46gfnrxnw");
+    ASSERT_EQ(record->occurred_at, 1755117607669);
+
+    ASSERT_FALSE(archive::MakeIndexRecord(R"({"event_type":"subscription.updated"})"));
+}
+
+UTEST(Paddle, EventLogAppendAndFind) {
+    auto directory = userver::fs::blocking::TempDirectory::Create();
+    archive::EventLog log{MakeSettings(directory)};
+    ASSERT_TRUE(log.Append(MakeRawEvent(1)));
+    ASSERT_FALSE(log.Append(MakeRawEvent(1)));
+    ASSERT_TRUE(log.Contains(MakeEventId(1)));
+    ASSERT_FALSE(log.Contains(MakeEventId(2)));
+    ASSERT_EQ(log.Find(MakeEventId(1)), MakeRawEvent(1));
+    ASSERT_EQ(log.Find(MakeEventId(2)), std::nullopt);
+}
+
+UTEST(Paddle, EventLogReadsSegmentsInOrder) {
+    auto directory = userver::fs::blocking::TempDirectory::Create();
+    {
+        archive::EventLog log{MakeSettings(directory)};
+        // Webhooks don't come in order
+        for (auto index : {3, 1, 2, 5, 4, 7, 6, 9, 8, 10}) {
+            ASSERT_TRUE(log.Append(MakeRawEvent(index)));
+        }
+    }
+    archive::EventLog log{MakeSettings(directory)};
+    ASSERT_FALSE(log.Append(MakeRawEvent(4)));
+
+    auto [events, cursor, have_more] = log.Read("", events::EventQuery{}, 4);
+    ASSERT_EQ(events.size(), std::size_t{4});
+    ASSERT_EQ(events[0], MakeRawEvent(1));
+    ASSERT_EQ(events[3], MakeRawEvent(4));
+    ASSERT_EQ(cursor, MakeEventId(4));
+    ASSERT_TRUE(have_more);
+
+    auto [rest, rest_cursor, rest_have_more] = log.Read(cursor, events::EventQuery{}, 100);
+    ASSERT_EQ(rest.size(), std::size_t{6});
+    ASSERT_EQ(rest[5], MakeRawEvent(10));
+    ASSERT_FALSE(rest_have_more);
+
+    events::EventQuery query;
+    query.event_types = {events::EventTypeName::kTransactionCompleted};
+    auto [selected, selected_cursor, selected_have_more] = log.Read("", query, 100);
+    ASSERT_EQ(selected.size(), std::size_t{5});
+    ASSERT_EQ(selected[0], MakeRawEvent(2));
+}
+
+UTEST(Paddle, EventLogEntityHistory) {
+    auto directory = userver::fs::blocking::TempDirectory::Create();
+    archive::EventLog log{MakeSettings(directory)};
+    for (auto index : {6, 1, 2, 3, 4, 5}) {
+        ASSERT_TRUE(log.Append(MakeRawEvent(index)));
+    }
+    auto history = log.GetEntityHistory("sub_01k2jjkzv4h5te6zw46gfnrxnw");
+    ASSERT_EQ(history, (std::vector<std::string>{MakeRawEvent(1), MakeRawEvent(3), MakeRawEvent(5)}));
+    ASSERT_TRUE(log.GetEntityHistory("sub_unknown").empty());
+}
+
+UTEST(Paddle, EventLogDiscardsPartialLine) {
+    auto directory = userver::fs::blocking::TempDirectory::Create();
+    {
+        archive::EventLog log{MakeSettings(directory)};
+        ASSERT_TRUE(log.Append(MakeRawEvent(1)));
+    }
+    const auto segment = std::filesystem::path{directory.GetPath()} / "events-000001.ndjson";
+    userver::fs::blocking::RewriteFileContents(segment.string(), MakeRawEvent(1) + "\n" + R"({"event_id":"evt_)");
+
+    archive::EventLog log{MakeSettings(directory)};
+    ASSERT_TRUE(log.Append(MakeRawEvent(2)));
+    auto [events, cursor, have_more] = log.Read("", events::EventQuery{}, 100);
+    ASSERT_EQ(events, (std::vector<std::string>{MakeRawEvent(1), MakeRawEvent(2)}));
+}
+
+}  // namespace paddle
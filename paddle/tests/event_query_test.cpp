@@ -0,0 +1,67 @@
+#include <paddle/types/event_query.hpp>
+
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/utest/utest.hpp>
+
+namespace paddle {
+
+namespace {
+
+auto MakeTimestamp(std::int64_t milliseconds) -> Timestamp {
+    return Timestamp{std::chrono::system_clock::time_point{std::chrono::milliseconds{milliseconds}}};
+}
+
+auto MakeEvent(const char* occurred_at, const char* entity_id) -> events::Event<JSON> {
+    userver::formats::json::ValueBuilder builder;
+    builder["event_id"] = "evt_01k2jjm0qdjr26zsz4m48z2efq";
+    builder["event_type"] = "transaction.paid";
+    builder["occurred_at"] = occurred_at;
+    builder["data"]["id"] = entity_id;
+    return builder.ExtractValue().As<events::Event<JSON>>();
+}
+
+}  // namespace
+
+TEST(Paddle, EventQueryCursor) {
+    // evt_01k2jjm0qdjr26zsz4m48z2efq occurred at 2025-08-13T20:40:50.669Z
+    ASSERT_EQ(events::MakeEventCursor(MakeTimestamp(1755117650669)), "evt_01k2jjm0qd0000000000000000");
+    ASSERT_LT(events::MakeEventCursor(MakeTimestamp(1755117650669)), "evt_01k2jjm0qdjr26zsz4m48z2efq");
+    ASSERT_GT(events::MakeEventCursor(MakeTimestamp(1755117650670)), "evt_01k2jjm0qdjr26zsz4m48z2efq");
+
+    events::EventQuery query;
+    ASSERT_EQ(query.GetStartCursor("evt_01k2jjm0qdjr26zsz4m48z2efq"), "evt_01k2jjm0qdjr26zsz4m48z2efq");
+    query.occurred_after = MakeTimestamp(1755117650669);
+    // One minute before the range
+    ASSERT_EQ(query.GetStartCursor({}), events::MakeEventCursor(MakeTimestamp(1755117590669)));
+    ASSERT_EQ(query.GetStartCursor("evt_01k2jjm0qdjr26zsz4m48z2efq"), "evt_01k2jjm0qdjr26zsz4m48z2efq");
+}
+
+TEST(Paddle, EventQueryEventTypes) {
+    events::EventQuery query;
+    ASSERT_TRUE(query.IsEmpty());
+    ASSERT_EQ(query.GetQueryParameters(), "");
+
+    query.event_types = events::ExpandEventTypes("subscription.*");
+    ASSERT_EQ(query.event_types.size(), std::size_t{9});
+    query.event_types = events::ExpandEventTypes("transaction.paid");
+    query.event_types.push_back(events::EventTypeName::kTransactionCompleted);
+    ASSERT_EQ(query.GetQueryParameters(), "&event_type=transaction.paid,transaction.completed");
+    ASSERT_THROW(events::ExpandEventTypes("subscriptions.*"), std::runtime_error);
+}
+
+TEST(Paddle, EventQueryMatches) {
+    events::EventQuery query;
+    query.occurred_after = MakeTimestamp(1755117650000);
+    query.occurred_before = MakeTimestamp(1755117651000);
+    ASSERT_TRUE(query.Matches(MakeEvent("2025-08-13T20:40:50.669Z", "txn_1")));
+    ASSERT_FALSE(query.Matches(MakeEvent("2025-08-13T20:40:49.999Z", "txn_1")));
+    ASSERT_FALSE(query.Matches(MakeEvent("2025-08-13T20:40:51.000Z", "txn_1")));
+    ASSERT_FALSE(query.IsPastRange(MakeEvent("2025-08-13T20:40:51.000Z", "txn_1")));
+    ASSERT_TRUE(query.IsPastRange(MakeEvent("2025-08-13T20:41:51.000Z", "txn_1")));
+
+    query.entity_ids = {"txn_2"};
+    ASSERT_FALSE(query.Matches(MakeEvent("2025-08-13T20:40:50.669Z", "txn_1")));
+    ASSERT_TRUE(query.Matches(MakeEvent("2025-08-13T20:40:50.669Z", "txn_2")));
+}
+
+}  // namespace paddle
@@ -0,0 +1,56 @@
+#include <paddle/handlers/handler_slots.hpp>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
+
+#include <chrono>
+
+namespace paddle {
+
+namespace {
+
+constexpr std::chrono::milliseconds kQueueTimeout{10};
+
+}  // namespace
+
+UTEST(HandlerSlots, RejectsWithoutDeadline) {
+    handlers::HandlerSlots slots{1, kQueueTimeout};
+    auto busy = slots.Acquire({});
+    ASSERT_TRUE(busy.OwnsLock());
+    // No handler deadline, the queue timeout still bounds the wait
+    auto rejected = slots.Acquire({});
+    EXPECT_FALSE(rejected.OwnsLock());
+}
+
+UTEST(HandlerSlots, ZeroQueueTimeoutRejectsRightAway) {
+    handlers::HandlerSlots slots{1, std::chrono::milliseconds{0}};
+    auto busy = slots.Acquire({});
+    ASSERT_TRUE(busy.OwnsLock());
+    EXPECT_FALSE(slots.Acquire({}).OwnsLock());
+    busy.Unlock();
+    EXPECT_TRUE(slots.Acquire({}).OwnsLock());
+}
+
+UTEST(HandlerSlots, DeadlineShortensQueueTimeout) {
+    handlers::HandlerSlots slots{1, std::chrono::minutes{1}};
+    auto busy = slots.Acquire({});
+    ASSERT_TRUE(busy.OwnsLock());
+    auto rejected = slots.Acquire(userver::engine::Deadline::FromDuration(kQueueTimeout));
+    EXPECT_FALSE(rejected.OwnsLock());
+}
+
+UTEST(HandlerSlots, WaitsForReleasedSlot) {
+    handlers::HandlerSlots slots{1, std::chrono::seconds{5}};
+    auto busy = slots.Acquire({});
+    ASSERT_TRUE(busy.OwnsLock());
+    auto release = userver::utils::Async("release", [&busy] {
+        userver::engine::SleepFor(kQueueTimeout);
+        busy.Unlock();
+    });
+    auto acquired = slots.Acquire({});
+    EXPECT_TRUE(acquired.OwnsLock());
+    release.Get();
+}
+
+}  // namespace paddle
@@ -0,0 +1,68 @@
+#include <paddle/auth/hmac_sha256.hpp>
+
+#include <userver/utest/utest.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace paddle::auth {
+
+namespace {
+
+auto ToHex(const Sha256Digest& digest) -> std::string {
+    constexpr std::string_view kHexDigits = "0123456789abcdef";
+    std::string hex;
+    for (auto byte : digest) {
+        hex += kHexDigits[byte >> 4];
+        hex += kHexDigits[byte & 0x0f];
+    }
+    return hex;
+}
+
+}  // namespace
+
+// RFC 4231 test cases 2 and 6
+TEST(Paddle, HmacSha256) {
+    EXPECT_EQ(
+        ToHex(HmacSha256("Jefe", "what do ya want for nothing?")),
+        "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843"
+    );
+    const std::string long_key(131, '\xaa');
+    EXPECT_EQ(
+        ToHex(HmacSha256(long_key, "Test Using Larger Than Block-Size Key - Hash Key First")),
+        "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54"
+    );
+    EXPECT_EQ(
+        ToHex(HmacSha256(HmacInput{"Jefe", {"what do ya ", "want for ", "nothing?"}})),
+        "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843"
+    );
+}
+
+TEST(Paddle, HmacSha256BatchKernels) {
+    // Lengths around the block and padding boundaries, keys shorter and longer than a block
+    std::vector<std::string> keys;
+    std::vector<std::string> messages;
+    for (std::size_t length : {0, 1, 55, 56, 63, 64, 65, 119, 120, 128, 1000, 4097}) {
+        keys.emplace_back(length % 3 == 0 ? 70 : 20, static_cast<char>('a' + length % 26));
+        messages.emplace_back(length, static_cast<char>(length % 251));
+    }
+    std::vector<HmacInput> inputs;
+    std::vector<Sha256Digest> expected;
+    for (std::size_t index = 0; index < keys.size(); ++index) {
+        std::string_view message = messages[index];
+        const auto split = std::min<std::size_t>(message.size(), 10);
+        inputs.push_back(HmacInput{keys[index], {message.substr(0, split), message.substr(split)}});
+        expected.push_back(HmacSha256(keys[index], message));
+    }
+    for (auto kernel : {Sha256Kernel::kScalar, Sha256Kernel::kShaNi, Sha256Kernel::kAvx2}) {
+        if (!IsSupported(kernel)) {
+            continue;
+        }
+        std::vector<Sha256Digest> digests(inputs.size());
+        HmacSha256Batch(inputs, digests, kernel);
+        EXPECT_EQ(digests, expected) << "kernel " << static_cast<int>(kernel);
+    }
+}
+
+}  // namespace paddle::auth
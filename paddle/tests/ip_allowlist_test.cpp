@@ -0,0 +1,49 @@
+#include <paddle/auth/ip_allowlist.hpp>
+
+#include <userver/utest/utest.hpp>
+
+namespace paddle {
+
+TEST(Paddle, IpAllowlist) {
+    const IpAllowlist allowlist{{
+        "34.194.127.46/32",
+        "54.234.237.108",
+        "10.0.0.0/8",
+        "10.128.0.0/9",
+        "192.168.1.0/24",
+        "192.168.2.0/24",
+        "2001:db8::/32",
+    }};
+    // Overlapping and adjacent ranges are merged
+    EXPECT_EQ(allowlist.GetSize(), 5U);
+    EXPECT_TRUE(allowlist.Contains("34.194.127.46"));
+    EXPECT_FALSE(allowlist.Contains("34.194.127.47"));
+    EXPECT_TRUE(allowlist.Contains("54.234.237.108"));
+    EXPECT_TRUE(allowlist.Contains("10.255.255.255"));
+    EXPECT_FALSE(allowlist.Contains("11.0.0.0"));
+    EXPECT_TRUE(allowlist.Contains("192.168.2.255"));
+    EXPECT_FALSE(allowlist.Contains("192.168.3.0"));
+    // IPv4 client on a dual-stack socket
+    EXPECT_TRUE(allowlist.Contains("::ffff:10.1.2.3"));
+    EXPECT_TRUE(allowlist.Contains("2001:db8:1::5"));
+    EXPECT_FALSE(allowlist.Contains("2001:db9::"));
+    EXPECT_FALSE(allowlist.Contains("not an address"));
+    EXPECT_FALSE(IpAllowlist{}.Contains("10.0.0.1"));
+
+    EXPECT_EQ(IpAllowlist({"::/0", "0.0.0.0/0"}).GetSize(), 1U);
+    for (const auto* range : {"1.2.3.4/33", "1.2.3/8", "::/129", "1.2.3.4/", "10.0.0.0/8x"}) {
+        EXPECT_THROW(IpAllowlist({range}), std::invalid_argument) << range;
+    }
+}
+
+TEST(Paddle, ForwardedAddress) {
+    EXPECT_EQ(GetForwardedAddress("1.1.1.1", 0), std::nullopt);
+    EXPECT_EQ(GetForwardedAddress("1.1.1.1, 2.2.2.2", 1), "2.2.2.2");
+    // The client may put anything to the left of the address seen by the outermost proxy
+    EXPECT_EQ(GetForwardedAddress("34.194.127.46, 1.1.1.1, 2.2.2.2", 2), "1.1.1.1");
+    EXPECT_EQ(GetForwardedAddress("1.1.1.1, 2.2.2.2", 3), std::nullopt);
+    EXPECT_EQ(GetForwardedAddress("", 1), std::nullopt);
+    EXPECT_EQ(GetForwardedAddress("1.1.1.1,", 1), std::nullopt);
+}
+
+}  // namespace paddle
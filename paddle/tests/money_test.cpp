@@ -1,7 +1,16 @@
 #include <paddle/types/money.hpp>
+#include <paddle/types/numeric.hpp>
+#include <paddle/types/price.hpp>
+#include <paddle/types/raw_json.hpp>
 
 #include <userver/utest/utest.hpp>
 
+#include <fmt/format.h>
+
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
 namespace paddle {
 
 namespace {
@@ -22,4 +31,82 @@ UTEST(Money, Parse) {
     EXPECT_EQ(money, kMoney);
 }
 
+UTEST(Money, ParseOnDemand) {
+    EXPECT_EQ(raw_json::ParseAs<money::Money>(kMoneyJson), kMoney);
+}
+
+UTEST(Money, ParseLargeAmount) {
+    // Doesn't fit into 32 bits, e.g. a yearly plan in a currency without minor units
+    const auto json = R"({"amount":"12345678901234","currency_code":"JPY"})";
+    const auto expected = money::Money{12345678901234, money::CurrencyCode{"JPY"}};
+    EXPECT_EQ(userver::formats::json::FromString(json).As<money::Money>(), expected);
+    EXPECT_EQ(raw_json::ParseAs<money::Money>(json), expected);
+}
+
+UTEST(Money, ParseInteger) {
+    EXPECT_EQ(ParseInteger("0"), 0);
+    EXPECT_EQ(ParseInteger("500"), 500);
+    EXPECT_EQ(ParseInteger("-83"), -83);
+    EXPECT_EQ(ParseInteger("9223372036854775807"), std::numeric_limits<std::int64_t>::max());
+    EXPECT_EQ(ParseInteger("-9223372036854775808"), std::numeric_limits<std::int64_t>::min());
+
+    EXPECT_THROW(ParseInteger(""), std::invalid_argument);
+    EXPECT_THROW(ParseInteger("-"), std::invalid_argument);
+    EXPECT_THROW(ParseInteger("+5"), std::invalid_argument);
+    EXPECT_THROW(ParseInteger("007"), std::invalid_argument);
+    EXPECT_THROW(ParseInteger(" 5"), std::invalid_argument);
+    EXPECT_THROW(ParseInteger("5 "), std::invalid_argument);
+    EXPECT_THROW(ParseInteger("1.5"), std::invalid_argument);
+    EXPECT_THROW(ParseInteger("9223372036854775808"), std::invalid_argument);
+}
+
+static_assert(sizeof(money::CurrencyCode) == 4);
+static_assert(money::CurrencyCode{"USD"}.GetScale() == 100);
+static_assert(money::CurrencyCode{"JPY"}.GetMinorUnits() == 0);
+
+UTEST(Money, CurrencyCode) {
+    const money::CurrencyCode usd{"USD"};
+    EXPECT_EQ(usd.GetView(), "USD");
+    EXPECT_EQ(usd.GetMinorUnits(), 2);
+    EXPECT_EQ(money::CurrencyCode{"usd"}, usd);
+    EXPECT_EQ(fmt::format("{}", usd), "USD");
+    EXPECT_EQ(money::CurrencyCode{"KWD"}.GetMinorUnits(), 3);
+    EXPECT_EQ(money::CurrencyCode{"CLF"}.GetScale(), 10000);
+    // Not in the table, scaled as most currencies are
+    EXPECT_EQ(money::CurrencyCode{"ZZZ"}.GetMinorUnits(), 2);
+    EXPECT_TRUE(money::CurrencyCode{}.IsEmpty());
+    EXPECT_EQ(money::CurrencyCode{}.ToString(), "");
+
+    for (const auto* text : {"", "US", "USDT", "U5D", "US "}) {
+        EXPECT_THROW(money::CurrencyCode{text}, std::invalid_argument) << text;
+        EXPECT_FALSE(money::CurrencyCode::TryParse(text)) << text;
+    }
+    EXPECT_THROW(raw_json::ParseAs<money::Money>(R"({"amount":"1","currency_code":"dollars"})"), std::exception);
+}
+
+UTEST(Money, CountryCode) {
+    const prices::CountryCode germany{"DE"};
+    EXPECT_EQ(germany.GetView(), "DE");
+    EXPECT_EQ(prices::CountryCode{"de"}, germany);
+    EXPECT_LT(germany, prices::CountryCode{"US"});
+    EXPECT_THROW(prices::CountryCode{"DEU"}, std::invalid_argument);
+
+    const auto json = R"({"country_codes":["DE","AT"],"unit_price":{"amount":"900","currency_code":"EUR"}})";
+    const auto expected = std::vector{germany, prices::CountryCode{"AT"}};
+    EXPECT_EQ(userver::formats::json::FromString(json).As<prices::PriceOverride>().country_codes, expected);
+    EXPECT_EQ(raw_json::ParseAs<prices::PriceOverride>(json).country_codes, expected);
+}
+
+UTEST(Money, ToDecimalString) {
+    EXPECT_EQ(kMoney.ToDecimalString(), "1.00");
+    EXPECT_EQ((money::Money{1234, money::CurrencyCode{"USD"}}.ToDecimalString()), "12.34");
+    EXPECT_EQ((money::Money{-5, money::CurrencyCode{"EUR"}}.ToDecimalString()), "-0.05");
+    EXPECT_EQ((money::Money{1234, money::CurrencyCode{"JPY"}}.ToDecimalString()), "1234");
+    EXPECT_EQ((money::Money{1234, money::CurrencyCode{"BHD"}}.ToDecimalString()), "1.234");
+    EXPECT_EQ(
+        (money::Money{std::numeric_limits<std::int64_t>::min(), money::CurrencyCode{"USD"}}.ToDecimalString()),
+        "-92233720368547758.08"
+    );
+}
+
 }  // namespace paddle
@@ -474,4 +474,32 @@ UTEST(NotificationSettingsTest, Parse) {
     EXPECT_EQ(setting.traffic_source, events::TrafficSource::kPlatform);
 }
 
+UTEST(NotificationSettingsTest, DiffSubscription) {
+    auto json = userver::formats::json::FromString(kNotificationSetting);
+    auto setting = Parse(json, userver::formats::parse::To<NotificationSetting>());
+    // transaction.billed, transaction.canceled, transaction.completed
+    setting.subscribed_events.resize(3);
+    const std::vector<events::EventTypeName> handled{
+        events::EventTypeName::kTransactionCompleted,
+        events::EventTypeName::kTransactionPaid,
+    };
+
+    auto diff = DiffSubscription(setting, handled);
+    EXPECT_EQ(diff.id, setting.id);
+    EXPECT_FALSE(diff.IsEmpty());
+    EXPECT_EQ(
+        diff.unhandled,
+        (std::vector<events::EventTypeName>{
+            events::EventTypeName::kTransactionBilled,
+            events::EventTypeName::kTransactionCanceled,
+        })
+    );
+    EXPECT_EQ(diff.missing, std::vector<events::EventTypeName>{events::EventTypeName::kTransactionPaid});
+
+    auto update = NarrowSubscription(setting, diff);
+    EXPECT_EQ(
+        update.subscribed_events, std::vector<events::EventTypeName>{events::EventTypeName::kTransactionCompleted}
+    );
+}
+
 }  // namespace paddle
\ No newline at end of file
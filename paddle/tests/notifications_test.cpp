@@ -0,0 +1,64 @@
+#include <paddle/types/notifications.hpp>
+
+#include <userver/formats/json/serialize.hpp>
+#include <userver/utest/utest.hpp>
+
+#include <chrono>
+
+namespace paddle {
+
+namespace {
+const auto kNotification = R"({
+    "id": "ntf_01h46h1s2zabpkdks7yt4vkgkc",
+    "type": "transaction.completed",
+    "status": "failed",
+    "payload": {
+        "data": {
+            "id": "txn_01h46h0t47pn0sp0dyrpy3y1ny",
+            "status": "completed"
+        },
+        "event_id": "evt_01h46h1rqw3v4qd2f6cz40dd1g",
+        "event_type": "transaction.completed",
+        "occurred_at": "2023-07-03T11:43:03.356227Z",
+        "notification_id": "ntf_01h46h1s2zabpkdks7yt4vkgkc"
+    },
+    "occurred_at": "2023-07-03T11:43:03.356227Z",
+    "delivered_at": null,
+    "replayed_at": null,
+    "origin": "event",
+    "last_attempt_at": "2023-07-04T08:12:44.210516Z",
+    "retry_at": null,
+    "times_attempted": 5,
+    "notification_setting_id": "ntfset_01h46ckj5t2e3v4mjvxqh4vdng"
+})";
+}  // namespace
+
+UTEST(NotificationsTest, Parse) {
+    auto json = userver::formats::json::FromString(kNotification);
+    auto notification = Parse(json, userver::formats::parse::To<Notification>());
+    EXPECT_EQ(notification.id, NotificationId("ntf_01h46h1s2zabpkdks7yt4vkgkc"));
+    EXPECT_EQ(notification.type, "transaction.completed");
+    EXPECT_EQ(notification.status, NotificationStatus::kFailed);
+    EXPECT_EQ(notification.origin, NotificationOrigin::kEvent);
+    EXPECT_FALSE(notification.delivered_at.has_value());
+    EXPECT_TRUE(notification.last_attempt_at.has_value());
+    EXPECT_EQ(notification.times_attempted, 5);
+    EXPECT_EQ(notification.notification_setting_id, NotificationSettingId("ntfset_01h46ckj5t2e3v4mjvxqh4vdng"));
+    EXPECT_EQ(notification.payload["event_id"].As<std::string>(), "evt_01h46h1rqw3v4qd2f6cz40dd1g");
+}
+
+UTEST(NotificationsTest, QueryParameters) {
+    EXPECT_EQ(NotificationQuery{}.GetQueryParameters(), "");
+
+    NotificationQuery query;
+    query.statuses = {NotificationStatus::kFailed, NotificationStatus::kNeedsRetry};
+    query.notification_setting_id = NotificationSettingId{"ntfset_01h46ckj5t2e3v4mjvxqh4vdng"};
+    query.from = Timestamp{std::chrono::system_clock::time_point{std::chrono::seconds{1700000000}}};
+    EXPECT_EQ(
+        query.GetQueryParameters(),
+        "&status=failed,needs_retry&notification_setting_id=ntfset_01h46ckj5t2e3v4mjvxqh4vdng"
+        "&from=2023-11-14T22:13:20Z"
+    );
+}
+
+}  // namespace paddle
@@ -0,0 +1,77 @@
+#include <paddle/types/ids.hpp>
+#include <paddle/types/raw_json.hpp>
+
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/utest/utest.hpp>
+
+#include <fmt/format.h>
+
+#include <stdexcept>
+#include <unordered_set>
+
+namespace paddle {
+
+namespace {
+
+constexpr std::string_view kTransactionId = "txn_01k2jjjx8b9e3zv0k2gk6a3f9y";
+
+}  // namespace
+
+static_assert(sizeof(TransactionId) == 24);
+static_assert(std::is_trivially_copyable_v<TransactionId>);
+
+TEST(PaddleId, RoundTrip) {
+    const TransactionId id{kTransactionId};
+    EXPECT_EQ(id.ToString(), kTransactionId);
+    EXPECT_EQ(id.GetPrefix(), "txn");
+    EXPECT_EQ(fmt::format("{}", id), kTransactionId);
+    EXPECT_EQ(TransactionId{"txn_01K2JJJX8B9E3ZV0K2GK6A3F9Y"}, id);
+    EXPECT_EQ(NotificationSettingId{"ntfset_01h46ckj5t2e3v4mjvxqh4vdng"}.ToString(), "ntfset_01h46ckj5t2e3v4mjvxqh4vdng");
+    EXPECT_TRUE(EventId{}.IsEmpty());
+    EXPECT_EQ(EventId{}.ToString(), "");
+}
+
+TEST(PaddleId, Invalid) {
+    for (const auto* text :
+         {"",
+          "txn_",
+          "txn_1",
+          "_01k2jjjx8b9e3zv0k2gk6a3f9y",
+          "txn-01k2jjjx8b9e3zv0k2gk6a3f9y",
+          "Txn_01k2jjjx8b9e3zv0k2gk6a3f9y",
+          "prefixes_01k2jjjx8b9e3zv0k2gk6a3f9y",
+          "txn_01k2jjjx8b9e3zv0k2gk6a3f9u",
+          "txn_81k2jjjx8b9e3zv0k2gk6a3f9y",
+          "txn_01k2jjjx8b9e3zv0k2gk6a3f9yy"}) {
+        EXPECT_THROW(TransactionId{text}, std::invalid_argument) << text;
+        EXPECT_EQ(TransactionId::TryParse(text), std::nullopt) << text;
+    }
+}
+
+TEST(PaddleId, OrdersAsStrings) {
+    const EventId earlier{"evt_01k2jjm0qdjr26zsz4m48z2efq"};
+    const EventId later{"evt_01k2jjm2z1c7d4a0p9q3e1v8r5"};
+    EXPECT_LT(earlier, later);
+    EXPECT_LT(earlier.ToString(), later.ToString());
+    EXPECT_NE(std::hash<EventId>{}(earlier), std::hash<EventId>{}(later));
+
+    std::unordered_set<EventId> ids{earlier, later, EventId{"evt_01k2jjm0qdjr26zsz4m48z2efq"}};
+    EXPECT_EQ(ids.size(), std::size_t{2});
+}
+
+TEST(PaddleId, Json) {
+    const auto json = fmt::format(R"({{"id": "{}", "customer_id": null}})", kTransactionId);
+    const TransactionId expected{kTransactionId};
+
+    const auto dom = userver::formats::json::FromString(json);
+    EXPECT_EQ(dom["id"].As<TransactionId>(), expected);
+    EXPECT_EQ(dom["customer_id"].As<OptionalCustomerId>(), std::nullopt);
+    EXPECT_EQ(userver::formats::json::ValueBuilder{expected}.ExtractValue(), dom["id"]);
+
+    const raw_json::Value on_demand{json};
+    EXPECT_EQ(on_demand["id"].As<TransactionId>(), expected);
+    EXPECT_EQ(on_demand["customer_id"].As<OptionalCustomerId>(), std::nullopt);
+}
+
+}  // namespace paddle
@@ -0,0 +1,67 @@
+#include <paddle/types/raw_json.hpp>
+
+#include <paddle/types/response.hpp>
+
+#include <userver/utest/utest.hpp>
+
+namespace paddle {
+
+namespace {
+
+const auto kPage = R"({
+    "data": ["pri_01", "pri_02"],
+    "meta": {
+        "request_id": "2f5f0bd0-3b5c-4f6e-8a63-4b0c4b0c4b0c",
+        "pagination": {
+            "per_page": 50,
+            "next": "https://api.paddle.com/prices?after=pri_02",
+            "has_more": false,
+            "estimated_total": 2
+        }
+    }
+})";
+
+}  // namespace
+
+TEST(Paddle, RawJsonValueMembers) {
+    raw_json::Value value{R"({"a": 1, "b": {"c": "x\ty"}, "d": null, "e": [1, 2, 3], "f": true})"};
+    EXPECT_TRUE(value.HasMember("e"));
+    EXPECT_FALSE(value.HasMember("missing"));
+    // Lookups in any order, the cursor wraps around
+    EXPECT_EQ(value["f"].As<bool>(), true);
+    EXPECT_EQ(value["a"].As<std::int32_t>(), 1);
+    EXPECT_EQ(value["b"]["c"].As<std::string>(), "x\ty");
+    EXPECT_TRUE(value["d"].IsNull());
+    EXPECT_EQ(value["d"].As<std::optional<std::string>>(), std::nullopt);
+    EXPECT_EQ(value["e"].As<std::vector<std::int64_t>>(), (std::vector<std::int64_t>{1, 2, 3}));
+    EXPECT_TRUE(value["missing"].IsMissing());
+    EXPECT_EQ(value["missing"].As<std::int32_t>(42), 42);
+    EXPECT_EQ(value["b"].GetRaw(), R"({"c": "x\ty"})");
+}
+
+TEST(Paddle, RawJsonValueErrors) {
+    raw_json::Value value{R"({"a": "1", "b": 300, "c": [1 2]})"};
+    EXPECT_THROW(value["a"].As<std::int32_t>(), raw_json::ParseError);
+    EXPECT_THROW(value["b"].As<std::int8_t>(), raw_json::ParseError);
+    EXPECT_THROW(value["missing"].As<std::string>(), raw_json::ParseError);
+    EXPECT_THROW(value["c"].As<std::vector<std::int32_t>>(), raw_json::ParseError);
+    EXPECT_THROW(raw_json::Value{"  "}, raw_json::ParseError);
+    EXPECT_THROW(raw_json::Value{R"({"a" 1})"}["a"], raw_json::ParseError);
+    try {
+        value["missing"].As<std::string>();
+    } catch (const raw_json::ParseError& e) {
+        EXPECT_STREQ(e.what(), "Field 'missing' is missing");
+    }
+}
+
+TEST(Paddle, RawJsonParseAs) {
+    auto response = raw_json::ParseAs<Response<std::string, MetaPaginated>>(kPage);
+    auto expected = userver::formats::json::FromString(kPage).As<Response<std::string, MetaPaginated>>();
+    EXPECT_EQ(response.data, expected.data);
+    EXPECT_EQ(response.meta.request_id, expected.meta.request_id);
+    EXPECT_EQ(response.meta.pagination.next, expected.meta.pagination.next);
+    EXPECT_EQ(response.meta.pagination.per_page, 50);
+    EXPECT_FALSE(response.meta.pagination.has_more);
+}
+
+}  // namespace paddle
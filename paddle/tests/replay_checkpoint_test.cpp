@@ -0,0 +1,124 @@
+#include <paddle/components/event_replay_controller.hpp>
+#include <paddle/components/replay_checkpoint_store.hpp>
+
+#include <userver/utest/utest.hpp>
+
+#include <fmt/format.h>
+
+#include <optional>
+#include <vector>
+
+namespace paddle {
+
+namespace {
+
+auto MakeEventId(int index) -> EventId {
+    return EventId{fmt::format("evt_01k2jjjx8b9e3zv0k2gk6a3f{:02}", index)};
+}
+
+auto MakePage() -> std::vector<events::RawEvent> {
+    std::vector<events::RawEvent> page(3);
+    for (std::size_t index = 0; index < page.size(); ++index) {
+        page[index].event.event_id = MakeEventId(static_cast<int>(index) + 1);
+    }
+    return page;
+}
+
+constexpr std::string_view kPageCursor = "evt_01k2jjjx8b9e3zv0k2gk6a3f10";
+
+auto MakeResumeOptions() -> components::ReplayOptions {
+    components::ReplayOptions options;
+    options.save_checkpoint = true;
+    return options;
+}
+
+}  // namespace
+
+TEST(EventWatermark, InOrder) {
+    components::EventWatermark watermark;
+    watermark.Begin(MakeEventId(1));
+    EXPECT_EQ(watermark.Complete(MakeEventId(1)), MakeEventId(1));
+    watermark.Begin(MakeEventId(2));
+    EXPECT_EQ(watermark.Complete(MakeEventId(2)), MakeEventId(2));
+    EXPECT_EQ(watermark.GetCursor(), MakeEventId(2));
+}
+
+TEST(EventWatermark, OutOfOrderCompletion) {
+    components::EventWatermark watermark;
+    watermark.Begin(MakeEventId(1));
+    watermark.Begin(MakeEventId(2));
+    watermark.Begin(MakeEventId(3));
+    // A newer event finishing first doesn't move the cursor past the older ones
+    EXPECT_EQ(watermark.Complete(MakeEventId(3)), std::nullopt);
+    EXPECT_EQ(watermark.Complete(MakeEventId(2)), std::nullopt);
+    EXPECT_EQ(watermark.GetCursor(), std::nullopt);
+    EXPECT_EQ(watermark.Complete(MakeEventId(1)), MakeEventId(3));
+}
+
+TEST(EventWatermark, FailedEvent) {
+    components::EventWatermark watermark;
+    watermark.Begin(MakeEventId(1));
+    watermark.Begin(MakeEventId(2));
+    EXPECT_EQ(watermark.Complete(MakeEventId(1)), MakeEventId(1));
+    watermark.Fail(MakeEventId(2));
+    watermark.Begin(MakeEventId(3));
+    EXPECT_EQ(watermark.Complete(MakeEventId(3)), std::nullopt);
+    // Filtered events complete without being started
+    EXPECT_EQ(watermark.Complete(MakeEventId(4)), std::nullopt);
+    EXPECT_EQ(watermark.GetCursor(), MakeEventId(1));
+
+    // Paddle retries the failed event
+    watermark.Begin(MakeEventId(2));
+    EXPECT_EQ(watermark.Complete(MakeEventId(2)), MakeEventId(4));
+}
+
+TEST(EventWatermark, OldEvent) {
+    components::EventWatermark watermark;
+    EXPECT_EQ(watermark.Complete(MakeEventId(5)), MakeEventId(5));
+    // A late retry of an event before the cursor doesn't hold it back
+    watermark.Begin(MakeEventId(3));
+    EXPECT_EQ(watermark.Complete(MakeEventId(6)), MakeEventId(6));
+    EXPECT_EQ(watermark.Complete(MakeEventId(3)), std::nullopt);
+    EXPECT_EQ(watermark.GetCursor(), MakeEventId(6));
+}
+
+TEST(EventWatermark, GivesUpOnOldestPending) {
+    components::EventWatermark watermark{3};
+    watermark.Fail(MakeEventId(1));
+    EXPECT_EQ(watermark.Complete(MakeEventId(2)), std::nullopt);
+    EXPECT_EQ(watermark.Complete(MakeEventId(3)), std::nullopt);
+    EXPECT_EQ(watermark.Complete(MakeEventId(4)), MakeEventId(4));
+}
+
+TEST(ReplayCheckpoint, ResumeSavesPageCursor) {
+    const auto page = MakePage();
+    const auto options = MakeResumeOptions();
+    EXPECT_EQ(components::GetPageCheckpoint({}, options, page, page.size(), kPageCursor), kPageCursor);
+    // Only the completed prefix of a failed page
+    EXPECT_EQ(components::GetPageCheckpoint({}, options, page, 2, kPageCursor), MakeEventId(2).ToString());
+    EXPECT_EQ(components::GetPageCheckpoint({}, options, page, 0, kPageCursor), std::nullopt);
+}
+
+TEST(ReplayCheckpoint, FilteredReplayLeavesCheckpoint) {
+    const auto page = MakePage();
+    events::EventQuery query;
+    query.event_types = events::ExpandEventTypes("transaction.*");
+    // Even if asked to, the page cursor would skip the events the query didn't select
+    EXPECT_EQ(components::GetPageCheckpoint(query, MakeResumeOptions(), page, page.size(), kPageCursor), std::nullopt);
+    EXPECT_EQ(components::GetPageCheckpoint(query, {}, page, page.size(), kPageCursor), std::nullopt);
+}
+
+TEST(ReplayCheckpoint, AdminReplayLeavesCheckpoint) {
+    const auto page = MakePage();
+    // What the admin handler passes for a job
+    components::ReplayOptions options;
+    options.concurrency = 4;
+    options.max_rate = 100;
+    EXPECT_EQ(components::GetPageCheckpoint({}, options, page, page.size(), kPageCursor), std::nullopt);
+
+    auto archive = MakeResumeOptions();
+    archive.from_archive = true;
+    EXPECT_EQ(components::GetPageCheckpoint({}, archive, page, page.size(), kPageCursor), std::nullopt);
+}
+
+}  // namespace paddle
@@ -0,0 +1,89 @@
+#include <paddle/handlers/replay_throttle.hpp>
+
+#include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
+
+namespace paddle {
+
+using std::chrono_literals::operator""ms;
+using Clock = handlers::RatePacer::Clock;
+
+TEST(Paddle, RatePacerSpacesEvents) {
+    handlers::RatePacer pacer{10};
+    auto now = Clock::now();
+    ASSERT_EQ(pacer.Reserve(now), now);
+    ASSERT_EQ(pacer.Reserve(now), now + 100ms);
+    ASSERT_EQ(pacer.Reserve(now), now + 200ms);
+    // No burst after an idle period
+    auto later = now + 1000ms;
+    ASSERT_EQ(pacer.Reserve(later), later);
+    ASSERT_EQ(pacer.Reserve(later), later + 100ms);
+}
+
+TEST(Paddle, RatePacerUnlimited) {
+    handlers::RatePacer pacer{0};
+    auto now = Clock::now();
+    ASSERT_EQ(pacer.Reserve(now), now);
+    ASSERT_EQ(pacer.Reserve(now), now);
+}
+
+TEST(Paddle, AdjustRateAimd) {
+    handlers::ReplayThrottleSettings settings;
+    settings.max_rate = 100;
+    settings.min_rate = 5;
+    settings.latency_target = 200ms;
+    settings.increase_step = 10;
+    settings.decrease_factor = 0.5;
+
+    // Within the target: additive increase up to max_rate
+    ASSERT_DOUBLE_EQ(handlers::AdjustRate(50, 50, 100ms, settings), 60);
+    ASSERT_DOUBLE_EQ(handlers::AdjustRate(95, 95, 100ms, settings), 100);
+    // Over the target: multiplicative decrease down to min_rate
+    ASSERT_DOUBLE_EQ(handlers::AdjustRate(60, 60, 300ms, settings), 30);
+    ASSERT_DOUBLE_EQ(handlers::AdjustRate(8, 8, 300ms, settings), 5);
+    // Decrease from the achieved rate if the limit was not reached
+    ASSERT_DOUBLE_EQ(handlers::AdjustRate(100, 40, 300ms, settings), 20);
+}
+
+TEST(Paddle, AdjustRateUnlimited) {
+    handlers::ReplayThrottleSettings settings;
+    settings.min_rate = 1;
+    settings.latency_target = 200ms;
+
+    ASSERT_DOUBLE_EQ(handlers::AdjustRate(0, 400, 100ms, settings), 0);
+    ASSERT_DOUBLE_EQ(handlers::AdjustRate(0, 400, 300ms, settings), 200);
+
+    settings.latency_target = 0ms;
+    ASSERT_DOUBLE_EQ(handlers::AdjustRate(0, 400, 300ms, settings), 0);
+}
+
+TEST(Paddle, AdjustRateNoCompletedEvents) {
+    handlers::ReplayThrottleSettings settings;
+    settings.min_rate = 0;
+    settings.latency_target = 200ms;
+
+    // Nothing completed during the interval, the handlers are stuck: keep limiting
+    ASSERT_GT(handlers::AdjustRate(0, 0, 300ms, settings), 0);
+    ASSERT_GT(handlers::AdjustRate(50, 0, 300ms, settings), 0);
+
+    settings.min_rate = 2;
+    ASSERT_DOUBLE_EQ(handlers::AdjustRate(0, 0, 300ms, settings), 2);
+    settings.decrease_factor = 0;
+    ASSERT_DOUBLE_EQ(handlers::AdjustRate(50, 50, 300ms, settings), 2);
+}
+
+UTEST(Paddle, ReplayThrottlePause) {
+    handlers::ReplayThrottleSettings settings;
+    handlers::ReplayThrottle throttle{settings};
+    ASSERT_FALSE(throttle.IsPaused());
+    throttle.Pause();
+    ASSERT_TRUE(throttle.IsPaused());
+    auto task = userver::utils::Async("acquire", [&throttle] { throttle.Acquire(); });
+    task.WaitFor(50ms);
+    ASSERT_FALSE(task.IsFinished());
+    throttle.Resume();
+    task.Get();
+    ASSERT_FALSE(throttle.IsPaused());
+}
+
+}  // namespace paddle
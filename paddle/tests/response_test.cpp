@@ -0,0 +1,55 @@
+#include <paddle/types/response.hpp>
+
+#include <userver/utest/utest.hpp>
+
+#include <optional>
+#include <string>
+
+namespace paddle {
+
+namespace {
+
+auto GetNextCursor(std::string next) -> std::optional<std::string> {
+    Pagination pagination{};
+    pagination.next = std::move(next);
+    return pagination.GetNextCursor();
+}
+
+}  // namespace
+
+TEST(Pagination, NextCursor) {
+    EXPECT_EQ(
+        GetNextCursor("https://api.paddle.com/events?after=evt_01k2jjjx8b9e3zv0k2gk6a3f9y"),
+        "evt_01k2jjjx8b9e3zv0k2gk6a3f9y"
+    );
+    EXPECT_EQ(GetNextCursor("https://api.paddle.com/events"), std::nullopt);
+    EXPECT_EQ(GetNextCursor(""), std::nullopt);
+}
+
+TEST(Pagination, NextCursorWithFilters) {
+    // Paddle repeats the filters in the next page URL, they must not leak into the cursor
+    EXPECT_EQ(
+        GetNextCursor(
+            "https://api.paddle.com/events?after=evt_01k2jjjx8b9e3zv0k2gk6a3f9y"
+            "&event_type=transaction.completed,transaction.updated&per_page=200"
+        ),
+        "evt_01k2jjjx8b9e3zv0k2gk6a3f9y"
+    );
+    EXPECT_EQ(
+        GetNextCursor(
+            "https://api.paddle.com/events?per_page=200&order_by=id%5BASC%5D&after=evt_01k2jjjx8b9e3zv0k2gk6a3f9y"
+        ),
+        "evt_01k2jjjx8b9e3zv0k2gk6a3f9y"
+    );
+    // Not a parameter of its own
+    EXPECT_EQ(GetNextCursor("https://api.paddle.com/events?created_after=2025-01-01"), std::nullopt);
+}
+
+TEST(Pagination, NextCursorDecoded) {
+    EXPECT_EQ(
+        GetNextCursor("https://api.paddle.com/prices?after=pri%5F01k2jjjx8b9e3zv0k2gk6a3f9y&x=1"),
+        "pri_01k2jjjx8b9e3zv0k2gk6a3f9y"
+    );
+}
+
+}  // namespace paddle
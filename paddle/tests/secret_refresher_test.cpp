@@ -0,0 +1,87 @@
+#include <paddle/auth/secret_refresher.hpp>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
+
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+namespace paddle {
+
+namespace {
+
+using std::chrono_literals::operator""ms;
+
+auto MakeSettings(std::chrono::milliseconds min_refresh_interval, std::chrono::milliseconds unknown_path_ttl)
+    -> auth::SecretRefresherSettings {
+    auth::SecretRefresherSettings settings;
+    settings.min_refresh_interval = min_refresh_interval;
+    settings.unknown_path_ttl = unknown_path_ttl;
+    return settings;
+}
+
+}  // namespace
+
+UTEST(SecretRefresher, ConcurrentMissesWaitForOneFetch) {
+    int fetches = 0;
+    auth::SecretRefresher refresher{MakeSettings(0ms, 0ms), [&fetches] {
+                                        ++fetches;
+                                        userver::engine::SleepFor(10ms);
+                                    }};
+    const auto seen_generation = refresher.GetGeneration();
+    std::vector<userver::engine::TaskWithResult<bool>> misses;
+    for (int i = 0; i < 5; ++i) {
+        misses.push_back(userver::utils::Async("miss", [&] { return refresher.Refresh(seen_generation); }));
+    }
+    for (auto& miss : misses) {
+        EXPECT_TRUE(miss.Get());
+    }
+    EXPECT_EQ(fetches, 1);
+    EXPECT_EQ(refresher.GetGeneration(), seen_generation + 1);
+}
+
+UTEST(SecretRefresher, RateLimited) {
+    int fetches = 0;
+    auth::SecretRefresher refresher{MakeSettings(std::chrono::minutes{1}, 0ms), [&fetches] { ++fetches; }};
+    EXPECT_TRUE(refresher.Refresh(refresher.GetGeneration()));
+    // A miss that saw the refreshed secrets waits for the interval
+    EXPECT_FALSE(refresher.Refresh(refresher.GetGeneration()));
+    EXPECT_EQ(fetches, 1);
+}
+
+UTEST(SecretRefresher, PeriodicUpdateResetsRateLimit) {
+    int fetches = 0;
+    auth::SecretRefresher refresher{MakeSettings(std::chrono::minutes{1}, 0ms), [&fetches] { ++fetches; }};
+    const auto seen_generation = refresher.GetGeneration();
+    refresher.Update([] {});
+    // Refreshed by the periodic update, no need to fetch again
+    EXPECT_TRUE(refresher.Refresh(seen_generation));
+    EXPECT_FALSE(refresher.Refresh(refresher.GetGeneration()));
+    EXPECT_EQ(fetches, 0);
+}
+
+UTEST(SecretRefresher, FailedRefreshBacksOff) {
+    int fetches = 0;
+    auth::SecretRefresher refresher{MakeSettings(std::chrono::minutes{1}, 0ms), [&fetches] {
+                                        ++fetches;
+                                        throw std::runtime_error{"Paddle API is down"};
+                                    }};
+    EXPECT_FALSE(refresher.Refresh(refresher.GetGeneration()));
+    EXPECT_FALSE(refresher.Refresh(refresher.GetGeneration()));
+    EXPECT_EQ(fetches, 1);
+    EXPECT_EQ(refresher.GetGeneration(), 0U);
+}
+
+UTEST(SecretRefresher, UnknownPathExpires) {
+    auth::SecretRefresher refresher{MakeSettings(0ms, 20ms), [] {}};
+    EXPECT_FALSE(refresher.IsUnknownPath("/paddle/webhook/new"));
+    refresher.RememberUnknownPath("/paddle/webhook/new");
+    EXPECT_TRUE(refresher.IsUnknownPath("/paddle/webhook/new"));
+    EXPECT_FALSE(refresher.IsUnknownPath("/paddle/webhook/other"));
+    userver::engine::SleepFor(30ms);
+    EXPECT_FALSE(refresher.IsUnknownPath("/paddle/webhook/new"));
+}
+
+}  // namespace paddle
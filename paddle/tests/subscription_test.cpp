@@ -1,3 +1,4 @@
+#include <paddle/types/raw_json.hpp>
 #include <paddle/types/subscriptions.hpp>
 
 #include <userver/utest/utest.hpp>
@@ -114,4 +115,23 @@ UTEST(SubscriptionTest, Parse) {
     EXPECT_EQ(subscription.currency_code, money::CurrencyCode("EUR"));
 }
 
+UTEST(SubscriptionTest, ParseOnDemand) {
+    auto expected = userver::formats::json::FromString(kTrialingSubscription).As<subscriptions::Subscription>();
+    auto subscription = raw_json::ParseAs<subscriptions::Subscription>(kTrialingSubscription);
+    EXPECT_EQ(subscription.id, expected.id);
+    EXPECT_EQ(subscription.status, expected.status);
+    EXPECT_EQ(subscription.business_id, std::nullopt);
+    EXPECT_EQ(subscription.created_at, expected.created_at);
+    EXPECT_EQ(subscription.next_billed_at, expected.next_billed_at);
+    EXPECT_EQ(subscription.paused_at, std::nullopt);
+    EXPECT_EQ(subscription.current_billing_period.ends_at, expected.current_billing_period.ends_at);
+    EXPECT_EQ(subscription.billing_cycle.frequency, 1);
+    ASSERT_EQ(subscription.items.size(), 1u);
+    EXPECT_EQ(subscription.items[0].price.id, expected.items[0].price.id);
+    EXPECT_EQ(subscription.items[0].price.custom_data, expected.items[0].price.custom_data);
+    EXPECT_EQ(subscription.items[0].trial_dates->starts_at, expected.items[0].trial_dates->starts_at);
+    EXPECT_EQ(subscription.items[0].product.custom_data, expected.items[0].product.custom_data);
+    EXPECT_EQ(subscription.management_urls.cancel, expected.management_urls.cancel);
+}
+
 }  // namespace paddle
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include <paddle/types/raw_json.hpp>
+#include <paddle/types/timestamp.hpp>
+
+#include <userver/utest/utest.hpp>
+#include <userver/utils/datetime.hpp>
+
+#include <stdexcept>
+
+namespace paddle {
+
+namespace {
+
+auto Micros(std::string_view text) -> std::int64_t {
+    return std::chrono::duration_cast<std::chrono::microseconds>(ParseRfc3339(text).time_since_epoch()).count();
+}
+
+}  // namespace
+
+UTEST(Timestamp, ParseRfc3339) {
+    EXPECT_EQ(Micros("1970-01-01T00:00:00Z"), 0);
+    EXPECT_EQ(Micros("2025-08-13T20:40:52.136Z"), 1755117652136000);
+    EXPECT_EQ(Micros("2025-08-13T19:56:22.671769Z"), 1755114982671769);
+    // Truncated to microseconds
+    EXPECT_EQ(Micros("2025-08-13T19:56:22.671769999Z"), 1755114982671769);
+    EXPECT_EQ(Micros("2025-08-13T22:40:52.136+02:00"), 1755117652136000);
+    EXPECT_EQ(Micros("2025-08-13T18:10:52.136-02:30"), 1755117652136000);
+    EXPECT_EQ(Micros("1969-12-31T23:59:59.5Z"), -500000);
+    EXPECT_EQ(Micros("2024-02-29T00:00:00Z"), 1709164800000000);
+}
+
+UTEST(Timestamp, MatchesStringtime) {
+    for (const auto* text : {"2025-08-13T20:40:52.136Z", "2025-08-13T19:56:22.671769Z", "2000-03-01T00:00:00Z"}) {
+        const auto expected = userver::utils::datetime::Stringtime(
+            text, userver::utils::datetime::kDefaultTimezone, userver::utils::datetime::kRfc3339Format
+        );
+        EXPECT_EQ(ParseRfc3339(text), expected) << text;
+    }
+}
+
+UTEST(Timestamp, ParseRfc3339Errors) {
+    for (const auto* text :
+         {"",
+          "2025-08-13",
+          "2025-08-13T20:40:52",
+          "2025-08-13T20:40:52.Z",
+          "2025-02-29T00:00:00Z",
+          "2025-13-01T00:00:00Z",
+          "2025-08-13T24:00:00Z",
+          "2025-08-1aT20:40:52Z",
+          "2025-08-13T20:40:52Zx",
+          "2025-08-13T20:40:52+2:00"}) {
+        EXPECT_THROW(ParseRfc3339(text), std::invalid_argument) << text;
+    }
+}
+
+UTEST(Timestamp, ParseFields) {
+    const auto json = R"({"created_at": "2025-08-13T20:40:52.136Z", "paused_at": null})";
+    const auto expected = Timestamp{ParseRfc3339("2025-08-13T20:40:52.136Z")};
+
+    const auto dom = userver::formats::json::FromString(json);
+    EXPECT_EQ(ParseTimestamp(dom["created_at"]), expected);
+    EXPECT_EQ(ParseOptionalTimestamp(dom["created_at"]), expected);
+    EXPECT_EQ(ParseOptionalTimestamp(dom["paused_at"]), std::nullopt);
+    EXPECT_EQ(ParseOptionalTimestamp(dom["canceled_at"]), std::nullopt);
+
+    const raw_json::Value on_demand{json};
+    EXPECT_EQ(ParseTimestamp(on_demand["created_at"]), expected);
+    EXPECT_EQ(ParseOptionalTimestamp(on_demand["paused_at"]), std::nullopt);
+    EXPECT_EQ(on_demand["created_at"].As<Timestamp>(), expected);
+}
+
+}  // namespace paddle
@@ -0,0 +1,89 @@
+#include <paddle/types/events.hpp>
+#include <paddle/types/subscription_view.hpp>
+#include <paddle/types/transaction_view.hpp>
+
+#include <userver/utest/utest.hpp>
+
+namespace paddle {
+
+namespace {
+
+// Line items are malformed, a view that doesn't touch them must still work
+const auto kTransactionEvent = R"({
+    "event_id": "evt_01k2jjm2z1c7d4a0p9q3e1v8r5",
+    "event_type": "transaction.completed",
+    "occurred_at": "2025-08-13T20:40:52.136Z",
+    "data": {
+        "id": "txn_01k2jjjx8b9e3zv0k2gk6a3f9y",
+        "status": "completed",
+        "customer_id": "ctm_01k2jj0xbzdpzbgz0vqv1e0x5e",
+        "address_id": null,
+        "custom_data": {"account": "acc_42"},
+        "currency_code": "USD",
+        "origin": "subscription_recurring",
+        "collection_mode": "automatic",
+        "items": [],
+        "details": {
+            "tax_rates_used": [],
+            "totals": {
+                "subtotal": "417", "tax": "83", "discount": "0", "total": "500", "credit": "0",
+                "credit_to_balance": "0", "balance": "0", "grand_total": "500", "currency_code": "USD"
+            },
+            "line_items": "malformed"
+        },
+        "created_at": "2025-08-13T20:40:48.901Z",
+        "updated_at": "2025-08-13T20:40:52.036Z"
+    }
+})";
+
+const auto kSubscription = R"({
+    "id": "sub_01k2jjkzv4h5te6zw46gfnrxnw",
+    "status": "active",
+    "customer_id": "ctm_01k2jj0xbzdpzbgz0vqv1e0x5e",
+    "address_id": "add_01k2jjgd1xzzwtarjsw7qw2by3",
+    "business_id": null,
+    "currency_code": "EUR",
+    "next_billed_at": "2025-09-13T20:40:49.761Z",
+    "paused_at": null,
+    "custom_data": {"plan": "indy"},
+    "items": "malformed"
+})";
+
+}  // namespace
+
+UTEST(TransactionViewTest, DecodesOnDemand) {
+    auto event = userver::formats::json::FromString(kTransactionEvent).As<events::Event<JSON>>();
+    auto typed_event = events::ParsePayload<transactions::TransactionView>(std::move(event));
+    const auto& transaction = typed_event.data;
+    EXPECT_EQ(transaction.GetId(), TransactionId{"txn_01k2jjjx8b9e3zv0k2gk6a3f9y"});
+    EXPECT_EQ(transaction.GetStatus(), TransactionStatus::kCompleted);
+    EXPECT_EQ(transaction.GetCustomerId(), CustomerId{"ctm_01k2jj0xbzdpzbgz0vqv1e0x5e"});
+    EXPECT_EQ(transaction.GetAddressId(), std::nullopt);
+    EXPECT_EQ(transaction.GetSubscriptionId(), std::nullopt);
+    EXPECT_EQ(transaction.GetTotals().grand_total, 500);
+    EXPECT_EQ(transaction.GetCustomData()["account"].As<std::string>(), "acc_42");
+    EXPECT_TRUE(transaction.GetPayments().empty());
+    EXPECT_ANY_THROW(transaction.GetDetails());
+    EXPECT_ANY_THROW(transaction.ToTransaction());
+}
+
+UTEST(TransactionViewTest, CachesFields) {
+    transactions::TransactionView transaction{userver::formats::json::FromString(kTransactionEvent)["data"]};
+    const auto& id = transaction.GetId();
+    EXPECT_EQ(&id, &transaction.GetId());
+    const auto& totals = transaction.GetTotals();
+    EXPECT_EQ(&totals, &transaction.GetTotals());
+}
+
+UTEST(SubscriptionViewTest, DecodesOnDemand) {
+    subscriptions::SubscriptionView subscription{userver::formats::json::FromString(kSubscription)};
+    EXPECT_EQ(subscription.GetId(), SubscriptionId{"sub_01k2jjkzv4h5te6zw46gfnrxnw"});
+    EXPECT_EQ(subscription.GetStatus(), SubscriptionStatus::kActive);
+    EXPECT_EQ(subscription.GetCurrencyCode(), money::CurrencyCode{"EUR"});
+    EXPECT_TRUE(subscription.GetNextBilledAt().has_value());
+    EXPECT_EQ(subscription.GetPausedAt(), std::nullopt);
+    EXPECT_EQ(subscription.GetCustomData()["plan"].As<std::string>(), "indy");
+    EXPECT_ANY_THROW(subscription.GetItems());
+}
+
+}  // namespace paddle
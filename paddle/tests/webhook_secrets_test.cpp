@@ -0,0 +1,43 @@
+#include <paddle/auth/webhook_secrets.hpp>
+
+#include <userver/utest/utest.hpp>
+
+namespace paddle {
+
+namespace {
+
+const auto kSecret = "pdl_ntfset_01k2jjfqx34sdwsvrbj123wxx2_w4C4I+q1LScX16/ODlt39IBfOQo+20fN";
+const auto kRotatedSecret = "pdl_ntfset_01k2jjfqx34sdwsvrbj123wxx2_rotated";
+const auto kPayload =
+    R"({"data":{"id":"paymtd_01k2jj1kp58a2w0q2bz6868k7t","type":"card","origin":"subscription","saved_at":"2025-08-13T20:30:50.472214Z","address_id":"add_01k2jj0xcjspzt29qb3qtt5wx6","updated_at":"2025-08-13T20:40:50.668611Z","customer_id":"ctm_01k2jj0xbzdpzbgz0vqv1e0x5e","deletion_reason":"replaced_by_newer_version"},"event_id":"evt_01k2jjm0qdjr26zsz4m48z2efq","event_type":"payment_method.deleted","occurred_at":"2025-08-13T20:40:50.669839Z","notification_id":"ntf_01k2jjm13zz5m5t681nvn0e5hr"})";
+const auto kSignatureHeader = "ts=1755117651;h1=cf519461c15c010f1a82e28afc83b7e8a5fdf1823791050e775badbe0bdcabf7";
+
+}  // namespace
+
+TEST(Paddle, WebhookSecretsRotation) {
+    WebhookSecrets secrets;
+    secrets.Add("/paddle/webhook", kRotatedSecret);
+    secrets.Add("/paddle/webhook?env=live", kSecret);
+    EXPECT_EQ(secrets.GetSize(), 1U);
+    // Both secrets are accepted, the matching one is tried first from now on
+    EXPECT_EQ(secrets.Verify("/paddle/webhook", kSignatureHeader, kPayload), SecretMatch::kVerified);
+    EXPECT_EQ(secrets.Verify("/paddle/webhook", kSignatureHeader, kPayload), SecretMatch::kVerified);
+    EXPECT_EQ(secrets.Verify("/paddle/webhook", kSignatureHeader, "{}"), SecretMatch::kMismatch);
+    EXPECT_EQ(secrets.Verify("/paddle/other", kSignatureHeader, kPayload), SecretMatch::kUnknownPath);
+}
+
+TEST(Paddle, WebhookSecretsWildcard) {
+    WebhookSecrets secrets{{"/paddle/webhook/*"}};
+    secrets.Add("/paddle/webhook/live", kSecret);
+    secrets.Add("/paddle/webhook/sandbox", kRotatedSecret);
+    secrets.Add("/billing", kRotatedSecret);
+    EXPECT_TRUE(secrets.Contains("/paddle/webhook/live"));
+    EXPECT_TRUE(secrets.Contains("/paddle/webhook/other"));
+    EXPECT_FALSE(secrets.Contains("/paddle/other"));
+    // Exact paths keep their own secrets
+    EXPECT_EQ(secrets.Verify("/paddle/webhook/sandbox", kSignatureHeader, kPayload), SecretMatch::kMismatch);
+    EXPECT_EQ(secrets.Verify("/paddle/webhook/other", kSignatureHeader, kPayload), SecretMatch::kVerified);
+    EXPECT_EQ(secrets.Verify("/billing", kSignatureHeader, kPayload), SecretMatch::kMismatch);
+}
+
+}  // namespace paddle